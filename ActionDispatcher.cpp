@@ -0,0 +1,124 @@
+#include "ActionDispatcher.h"
+#include "Logger.h"
+#include <algorithm>
+#include <exception>
+
+#ifdef _WIN32
+#include <objbase.h>
+#endif
+
+ActionDispatcher::ActionDispatcher(int workers) {
+  if (workers < 1)
+    workers = 1;
+  for (int i = 0; i < workers; ++i)
+    threads.push_back(std::thread(&ActionDispatcher::Run, this));
+}
+
+ActionDispatcher::~ActionDispatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopping = true;
+    queue.clear();
+  }
+  wake.notify_all();
+  for (std::thread &t : threads)
+    t.join();
+}
+
+void ActionDispatcher::Submit(Lane lane, std::function<void()> action) {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    queue.push_back(Task{lane, false, std::move(action)});
+  }
+  wake.notify_one();
+}
+
+void ActionDispatcher::SubmitExclusive(std::function<void()> action) {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    queue.push_back(Task{FREE, true, std::move(action)});
+  }
+  wake.notify_one();
+}
+
+void ActionDispatcher::WaitIdle() {
+  std::unique_lock<std::mutex> lock(mtx);
+  idle.wait(lock, [this] { return queue.empty() && running == 0; });
+}
+
+size_t ActionDispatcher::Pending() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return queue.size();
+}
+
+bool ActionDispatcher::TakeRunnable(Task &out) {
+  if (exclusiveRunning)
+    return false;
+
+  // Recorre la cola en orden: una acción de un carril no adelanta a otra
+  // anterior del mismo carril, y nada adelanta a una exclusiva
+  blocked.clear();
+  for (auto it = queue.begin(); it != queue.end(); ++it) {
+    if (it->exclusive) {
+      if (it != queue.begin() || running > 0)
+        return false;
+      exclusiveRunning = true;
+    } else if (it->lane != FREE) {
+      bool laneBusy = busyLanes.count(it->lane) != 0 ||
+                      std::find(blocked.begin(), blocked.end(), it->lane) !=
+                          blocked.end();
+      if (laneBusy) {
+        blocked.push_back(it->lane);
+        continue;
+      }
+      busyLanes[it->lane]++;
+    }
+    out = std::move(*it);
+    queue.erase(it);
+    running++;
+    return true;
+  }
+  return false;
+}
+
+void ActionDispatcher::Run() {
+#ifdef _WIN32
+  // ShellExecute (lanzar apps) necesita COM en el hilo que lo llama
+  HRESULT com =
+      CoInitializeEx(NULL, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
+#endif
+  std::unique_lock<std::mutex> lock(mtx);
+  while (true) {
+    Task task;
+    wake.wait(lock, [&] { return stopping || TakeRunnable(task); });
+    if (stopping && !task.action)
+      break;
+
+    lock.unlock();
+    try {
+      task.action();
+    } catch (const std::exception &e) {
+      LOG_ERROR(std::string("Excepcion en accion de hotkey: ") + e.what());
+    } catch (...) {
+      LOG_ERROR("Excepcion desconocida en accion de hotkey");
+    }
+    task.action = nullptr; // Liberar capturas fuera del lock
+    lock.lock();
+
+    running--;
+    if (task.exclusive)
+      exclusiveRunning = false;
+    else if (task.lane != FREE && --busyLanes[task.lane] == 0)
+      busyLanes.erase(task.lane);
+
+    // Terminar una acción puede desbloquear cualquier otra de la cola
+    wake.notify_all();
+    if (queue.empty() && running == 0)
+      idle.notify_all();
+  }
+#ifdef _WIN32
+  lock.unlock();
+  if (SUCCEEDED(com))
+    CoUninitialize();
+#endif
+}
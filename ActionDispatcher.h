@@ -0,0 +1,68 @@
+#ifndef ACTION_DISPATCHER_H
+#define ACTION_DISPATCHER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Pool de hilos para las acciones de los hotkeys
+ *
+ * El bucle de mensajes solo encola y vuelve: un ShellExecute lento o un
+ * "ordenar todas" no retrasan los hotkeys que llegan detrás.
+ *
+ * Cada acción va en un carril:
+ *   - Un carril por ventana (la HWND, u otra clave fija como la del cambio
+ *     de foco): sus acciones se ejecutan de una en una y en orden.
+ *   - FREE: sin orden, en paralelo con todo (lanzar una app).
+ *   - SubmitExclusive: espera a que terminen las acciones anteriores y
+ *     ninguna posterior empieza hasta que acaba (ordenar, tiling).
+ *
+ * Los trabajadores toman la primera acción de la cola que se puede ejecutar
+ * ya, así que una ventana ocupada no frena a las demás. En Windows cada
+ * trabajador inicializa COM (apartamento STA) para poder usar ShellExecute.
+ */
+class ActionDispatcher {
+public:
+  typedef const void *Lane;
+  static constexpr Lane FREE = nullptr;
+
+  explicit ActionDispatcher(int workers = 3);
+  // Las acciones pendientes se descartan; las que están en marcha terminan
+  ~ActionDispatcher();
+
+  void Submit(Lane lane, std::function<void()> action);
+  void SubmitExclusive(std::function<void()> action);
+
+  // Espera a que la cola quede vacía y no haya nada en marcha
+  void WaitIdle();
+
+  size_t Pending();
+
+private:
+  struct Task {
+    Lane lane;
+    bool exclusive;
+    std::function<void()> action;
+  };
+
+  std::mutex mtx;
+  std::condition_variable wake; // Hay trabajo o terminó una acción
+  std::condition_variable idle;
+  std::deque<Task> queue;
+  std::unordered_map<Lane, int> busyLanes; // Carril -> acciones en marcha
+  std::vector<Lane> blocked;               // Reutilizado en TakeRunnable
+  int running = 0;
+  bool exclusiveRunning = false;
+  bool stopping = false;
+  std::vector<std::thread> threads;
+
+  void Run();
+  bool TakeRunnable(Task &out);
+};
+
+#endif // ACTION_DISPATCHER_H
@@ -0,0 +1,333 @@
+#include "Animator.h"
+#include <algorithm>
+#include <cmath>
+
+Animator::Animator(DesktopBackend *backend, bool threaded,
+                   MoveDispatcher *dispatcher)
+    : backend(backend), dispatcher(dispatcher), threaded(threaded),
+      epoch(std::chrono::steady_clock::now()) {
+  Configure(durationMs, easing);
+  if (threaded)
+    worker = std::thread(&Animator::Run, this);
+}
+
+Animator::Easing Animator::ParseEasing(const std::string &name) {
+  if (name == "cubic")
+    return EASE_CUBIC;
+  if (name == "spring")
+    return EASE_SPRING;
+  return EASE_SINE;
+}
+
+static double EaseRaw(Animator::Easing easing, double u) {
+  const double pi = 3.14159265358979;
+  switch (easing) {
+  case Animator::EASE_CUBIC:
+    return 1.0 - (1.0 - u) * (1.0 - u) * (1.0 - u);
+  case Animator::EASE_SPRING: {
+    // Muelle subamortiguado (zeta = 0.5): pasa un poco del destino y vuelve
+    const double zeta = 0.5, omega = 12.0;
+    const double wd = omega * sqrt(1.0 - zeta * zeta);
+    return 1.0 - exp(-zeta * omega * u) *
+                     (cos(wd * u) + (zeta * omega / wd) * sin(wd * u));
+  }
+  default:
+    return sin(u * (pi / 2.0));
+  }
+}
+
+void Animator::Configure(int durationMs, Easing easing) {
+  float lut[LUT_SIZE + 1], slope[LUT_SIZE + 1];
+  double end = EaseRaw(easing, 1.0); // Normalizar: e(1) = 1 exacto
+  for (int i = 0; i <= LUT_SIZE; ++i)
+    lut[i] = (float)(EaseRaw(easing, (double)i / LUT_SIZE) / end);
+  lut[0] = 0.0f;
+  lut[LUT_SIZE] = 1.0f;
+  for (int i = 0; i <= LUT_SIZE; ++i) {
+    int a = i > 0 ? i - 1 : 0, b = i < LUT_SIZE ? i + 1 : LUT_SIZE;
+    slope[i] = (lut[b] - lut[a]) * LUT_SIZE / (float)(b - a);
+  }
+
+  std::lock_guard<std::mutex> lock(mtx);
+  this->durationMs = durationMs;
+  this->easing = easing;
+  std::copy(lut, lut + LUT_SIZE + 1, easeLut);
+  std::copy(slope, slope + LUT_SIZE + 1, slopeLut);
+}
+
+Animator::~Animator() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopping = true;
+  }
+  wake.notify_all();
+  if (worker.joinable())
+    worker.join();
+}
+
+double Animator::Now() {
+  if (!threaded)
+    return virtualNow;
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+}
+
+void Animator::Evaluate(const Animation &anim, double nowMs, float pos[4],
+                        float vel[4]) const {
+  double u = (nowMs - anim.startMs) / anim.durationMs;
+  if (u < 0.0)
+    u = 0.0;
+  if (u > 1.0)
+    u = 1.0;
+  float d = (float)anim.durationMs;
+
+  if (anim.hermite) {
+    // Hermite cúbica: p(0)=from, p'(0)=v0, p(1)=to, p'(1)=0
+    float u2 = (float)(u * u), u3 = (float)(u * u * u), uf = (float)u;
+    float h00 = 2 * u3 - 3 * u2 + 1;
+    float h10 = u3 - 2 * u2 + uf;
+    float h01 = -2 * u3 + 3 * u2;
+    float dh00 = 6 * u2 - 6 * uf;
+    float dh10 = 3 * u2 - 4 * uf + 1;
+    float dh01 = -6 * u2 + 6 * uf;
+    for (int i = 0; i < 4; ++i) {
+      float v0 = anim.startVelocity[i] * d;
+      pos[i] = h00 * anim.from[i] + h10 * v0 + h01 * anim.to[i];
+      vel[i] = (dh00 * anim.from[i] + dh10 * v0 + dh01 * anim.to[i]) / d;
+    }
+  } else {
+    // Curva precalculada, interpolada entre entradas de la tabla
+    float x = (float)u * LUT_SIZE;
+    int i = (int)x;
+    if (i >= LUT_SIZE)
+      i = LUT_SIZE - 1;
+    float frac = x - i;
+    float e = easeLut[i] + (easeLut[i + 1] - easeLut[i]) * frac;
+    float de = slopeLut[i] + (slopeLut[i + 1] - slopeLut[i]) * frac;
+    for (int i = 0; i < 4; ++i) {
+      float delta = anim.to[i] - anim.from[i];
+      pos[i] = anim.from[i] + delta * e;
+      vel[i] = delta * de / d;
+    }
+  }
+}
+
+void Animator::Animate(HWND hwnd, int x, int y, int w, int h) {
+  AnimateBatch({{hwnd, x, y, w, h, SWP_NOZORDER | SWP_NOACTIVATE}});
+}
+
+void Animator::AnimateBatch(const std::vector<WindowPos> &targets) {
+  std::vector<WindowPos> fresh, direct;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    double now = Now();
+    for (const WindowPos &t : targets) {
+      auto it = indexOf.find(t.hwnd);
+      if (durationMs <= 0) {
+        // animation_speed = 0: movimiento directo
+        if (it != indexOf.end())
+          RemoveAt(it->second);
+        direct.push_back(t);
+      } else if (it != indexOf.end()) {
+        // Redirigir desde la posición y velocidad actuales
+        float target[4] = {(float)t.x, (float)t.y, (float)t.w, (float)t.h};
+        Animation &anim = active[it->second];
+        float pos[4], vel[4];
+        Evaluate(anim, now, pos, vel);
+        for (int i = 0; i < 4; ++i) {
+          anim.from[i] = pos[i];
+          anim.to[i] = target[i];
+          anim.startVelocity[i] = vel[i];
+        }
+        anim.startMs = now;
+        anim.durationMs = durationMs;
+        anim.hermite = true;
+      } else {
+        fresh.push_back(t);
+      }
+    }
+  }
+
+  // GetRect fuera del lock: puede tardar si la ventana no responde
+  std::vector<Animation> started;
+  started.reserve(fresh.size());
+  for (const WindowPos &t : fresh) {
+    RECT start;
+    if (!backend->GetRect(t.hwnd, start)) {
+      direct.push_back(t);
+      continue;
+    }
+    if (start.left == t.x && start.top == t.y &&
+        start.right - start.left == t.w && start.bottom - start.top == t.h)
+      continue;
+    Animation anim;
+    anim.hwnd = t.hwnd;
+    anim.from[0] = (float)start.left;
+    anim.from[1] = (float)start.top;
+    anim.from[2] = (float)(start.right - start.left);
+    anim.from[3] = (float)(start.bottom - start.top);
+    anim.to[0] = (float)t.x;
+    anim.to[1] = (float)t.y;
+    anim.to[2] = (float)t.w;
+    anim.to[3] = (float)t.h;
+    for (int i = 0; i < 4; ++i)
+      anim.startVelocity[i] = 0.0f;
+    anim.hermite = false;
+    started.push_back(anim);
+  }
+
+  if (!direct.empty()) {
+    if (dispatcher)
+      dispatcher->ApplyBatch(direct);
+    else
+      backend->SetPosBatch(direct);
+  }
+  if (started.empty())
+    return;
+
+  {
+    // Mismo instante de inicio para todo el lote: avanzan juntas
+    std::lock_guard<std::mutex> lock(mtx);
+    double now = Now();
+    for (Animation &anim : started) {
+      if (indexOf.count(anim.hwnd))
+        continue; // Otro hilo la empezó mientras tanto
+      anim.startMs = now;
+      anim.durationMs = durationMs;
+      indexOf[anim.hwnd] = active.size();
+      active.push_back(anim);
+    }
+  }
+  wake.notify_one();
+}
+
+void Animator::RemoveAt(size_t index) {
+  // Borrado O(1): mover el último al hueco
+  indexOf.erase(active[index].hwnd);
+  if (index != active.size() - 1) {
+    active[index] = active.back();
+    indexOf[active[index].hwnd] = index;
+  }
+  active.pop_back();
+}
+
+void Animator::Cancel(HWND hwnd) {
+  // Un frame ya calculado podría aplicarse después del SetPos del llamador
+  std::lock_guard<std::mutex> frameLock(frameMutex);
+  std::lock_guard<std::mutex> lock(mtx);
+  auto it = indexOf.find(hwnd);
+  if (it != indexOf.end())
+    RemoveAt(it->second);
+}
+
+bool Animator::IsAnimating(HWND hwnd) {
+  std::lock_guard<std::mutex> lock(mtx);
+  return indexOf.count(hwnd) != 0;
+}
+
+size_t Animator::ActiveCount() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return active.size();
+}
+
+bool Animator::TargetOf(HWND hwnd, RECT &out) {
+  std::lock_guard<std::mutex> lock(mtx);
+  auto it = indexOf.find(hwnd);
+  if (it == indexOf.end())
+    return false;
+  // Igual que el último frame
+  const float *to = active[it->second].to;
+  int w = std::max(1, (int)lroundf(to[2]));
+  int h = std::max(1, (int)lroundf(to[3]));
+  out.left = (LONG)lroundf(to[0]);
+  out.top = (LONG)lroundf(to[1]);
+  out.right = out.left + w;
+  out.bottom = out.top + h;
+  return true;
+}
+
+bool Animator::Sample(HWND hwnd, double nowMs, float pos[4], float vel[4]) {
+  std::lock_guard<std::mutex> lock(mtx);
+  auto it = indexOf.find(hwnd);
+  if (it == indexOf.end())
+    return false;
+  Evaluate(active[it->second], nowMs, pos, vel);
+  return true;
+}
+
+size_t Animator::AdvanceFrame(double nowMs) {
+  std::lock_guard<std::mutex> frameLock(frameMutex);
+  std::vector<WindowPos> frame;
+  size_t remaining;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!threaded)
+      virtualNow = nowMs;
+    frame.reserve(active.size());
+    for (size_t i = 0; i < active.size();) {
+      const Animation &anim = active[i];
+      bool last = nowMs - anim.startMs >= anim.durationMs;
+      float pos[4], vel[4];
+      Evaluate(anim, nowMs, pos, vel);
+      WindowPos m;
+      m.hwnd = anim.hwnd;
+      m.x = (int)lroundf(pos[0]);
+      m.y = (int)lroundf(pos[1]);
+      m.w = (int)lroundf(pos[2]);
+      m.h = (int)lroundf(pos[3]);
+      if (m.w < 1)
+        m.w = 1;
+      if (m.h < 1)
+        m.h = 1;
+      m.flags = SWP_NOZORDER | SWP_NOACTIVATE;
+      frame.push_back(m);
+      if (last)
+        RemoveAt(i);
+      else
+        ++i;
+    }
+    remaining = active.size();
+  }
+
+  // Fuera de mtx: Animate() nunca espera a una ventana lenta (Cancel sí,
+  // con frameMutex, a este frame como mucho). Todas las ventanas del frame
+  // en un lote; el dispatcher lo parte por proceso y no espera a las
+  // colgadas más que su plazo
+  if (frame.empty())
+    return remaining;
+  if (dispatcher)
+    dispatcher->ApplyBatch(frame);
+  else
+    backend->SetPosBatch(frame);
+  return remaining;
+}
+
+void Animator::Run() {
+  using clock = std::chrono::steady_clock;
+  std::unique_lock<std::mutex> lock(mtx);
+  while (!stopping) {
+    // Dormir sin despertares mientras no haya nada que animar
+    wake.wait(lock, [this] { return stopping || !active.empty(); });
+    if (stopping)
+      break;
+
+    clock::time_point next = clock::now();
+    while (!stopping && !active.empty()) {
+      lock.unlock();
+      next += std::chrono::milliseconds(FRAME_MS);
+      clock::time_point now = clock::now();
+      if (next < now) {
+        // El frame anterior se pasó de presupuesto (SetWindowPos lento):
+        // descartar los frames perdidos en vez de encadenarlos
+        long long behind = (now - next) / std::chrono::milliseconds(FRAME_MS);
+        droppedFrames += behind;
+        next = now;
+      } else {
+        std::this_thread::sleep_until(next);
+      }
+      AdvanceFrame(Now());
+      lock.lock();
+    }
+  }
+}
@@ -0,0 +1,122 @@
+#ifndef ANIMATOR_H
+#define ANIMATOR_H
+
+#include "DesktopBackend.h"
+#include "MoveDispatcher.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Motor de animaciones de ventanas en su propio hilo
+ *
+ * Los manejadores de hotkeys solo llaman a Animate() con el destino y
+ * vuelven de inmediato; un único reloj de frames en el hilo del animador
+ * mueve a la vez todas las ventanas en vuelo.
+ *
+ * Las animaciones son interrumpibles: un destino nuevo para una ventana que
+ * ya se está animando continúa desde el rectángulo interpolado en ese
+ * instante y con la misma velocidad (curva de Hermite cúbica hacia el nuevo
+ * destino, que llega con velocidad cero), sin esperar ni saltar.
+ *
+ * La duración es tiempo real medido con un reloj monótono de alta
+ * resolución, no un número de pasos: si SetWindowPos tarda más que el
+ * presupuesto de un frame, los frames perdidos se descartan y el siguiente
+ * salta a donde toca, así que una app lenta no alarga la animación. Las
+ * curvas (seno, cúbica, muelle) se precalculan en tablas en Configure().
+ *
+ * Cada frame aplica todas las ventanas en vuelo en un único SetPosBatch.
+ * Con un MoveDispatcher todos los frames, intermedios incluidos, pasan por
+ * él de forma síncrona: se reparten en un SetPosBatch por proceso en
+ * paralelo y el frame espera como mucho su plazo. Una app colgada retrasa
+ * un frame una sola vez; después sus ventanas quedan fuera durante el
+ * enfriamiento.
+ *
+ * Con threaded = false no se crea hilo: el reloj es virtual y avanza con
+ * AdvanceFrame(nowMs), lo que permite reproducir secuencias en Linux.
+ */
+class Animator {
+public:
+  static const int FRAME_MS = 10; // Periodo del reloj de frames
+  static const int LUT_SIZE = 256;
+
+  enum Easing { EASE_SINE = 0, EASE_CUBIC = 1, EASE_SPRING = 2 };
+
+  Animator(DesktopBackend *backend, bool threaded = true,
+           MoveDispatcher *dispatcher = nullptr);
+  ~Animator();
+
+  // Duración de las animaciones nuevas y curva; recalcula las tablas
+  void Configure(int durationMs, Easing easing);
+  int GetDurationMs() const { return durationMs; }
+  static Easing ParseEasing(const std::string &name);
+
+  long long DroppedFrames() const { return droppedFrames.load(); }
+
+  // Anima hwnd hasta (x, y, w, h) partiendo de donde esté ahora
+  void Animate(HWND hwnd, int x, int y, int w, int h);
+  // Varias ventanas con el mismo instante de inicio: cada frame las mueve
+  // todas en un solo SetPosBatch
+  void AnimateBatch(const std::vector<WindowPos> &targets);
+  // Detiene la animación de hwnd (si la hay) sin mover la ventana. Espera
+  // al frame que se esté aplicando: al volver ya no llega ninguno y el
+  // llamador puede colocar la ventana él mismo
+  void Cancel(HWND hwnd);
+
+  bool IsAnimating(HWND hwnd);
+  size_t ActiveCount();
+  // Destino en vuelo de hwnd, el rectángulo que tendrá al acabar; false
+  // si no se está animando
+  bool TargetOf(HWND hwnd, RECT &out);
+
+  // Posición y velocidad (px/ms) de hwnd en el instante nowMs
+  bool Sample(HWND hwnd, double nowMs, float pos[4], float vel[4]);
+
+  // Aplica el frame del instante nowMs; devuelve cuántas siguen vivas
+  size_t AdvanceFrame(double nowMs);
+  double Now();
+
+private:
+  // Estado de una ventana en vuelo; componentes en orden x, y, w, h
+  struct Animation {
+    HWND hwnd;
+    float from[4];
+    float to[4];
+    float startVelocity[4]; // px/ms al empezar (0 salvo al redirigir)
+    double startMs;
+    double durationMs;
+    bool hermite; // Redirigida: curva que conserva la velocidad
+  };
+
+  DesktopBackend *backend;
+  MoveDispatcher *dispatcher; // Todos los frames (puede ser nullptr)
+  // Tabla compacta: almacenamiento denso + índice por HWND
+  std::vector<Animation> active;
+  std::unordered_map<HWND, size_t> indexOf;
+  std::mutex mtx;
+  // Un frame a la vez, de calcularlo a aplicarlo; antes que mtx
+  std::mutex frameMutex;
+  std::condition_variable wake;
+  std::thread worker;
+  bool threaded;
+  bool stopping = false;
+  double virtualNow = 0.0;
+  int durationMs = 120;
+  Easing easing = EASE_SINE;
+  float easeLut[LUT_SIZE + 1];  // e(u)
+  float slopeLut[LUT_SIZE + 1]; // e'(u), para la velocidad al redirigir
+  std::atomic<long long> droppedFrames{0};
+  std::chrono::steady_clock::time_point epoch;
+
+  void Evaluate(const Animation &anim, double nowMs, float pos[4],
+                float vel[4]) const;
+  void RemoveAt(size_t index);
+  void Run();
+};
+
+#endif // ANIMATOR_H
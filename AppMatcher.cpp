@@ -0,0 +1,223 @@
+#include "AppMatcher.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <queue>
+
+// ===== AUTÓMATA =====
+
+void PatternAutomaton::Build(const std::vector<std::string> &patterns) {
+  patternCount = (int)patterns.size();
+
+  // Alfabeto comprimido: una columna por byte usado en los patrones
+  memset(classOf, 0, sizeof(classOf));
+  classCount = 1;
+  for (const std::string &p : patterns) {
+    for (unsigned char c : p) {
+      if (classOf[c] == 0)
+        classOf[c] = (unsigned char)classCount++;
+    }
+  }
+
+  // Trie (-1 = sin transición)
+  next.assign(classCount, -1);
+  terminal.assign(1, 0);
+  outputs.assign(1, std::vector<int>());
+  for (int i = 0; i < patternCount; ++i) {
+    int state = 0;
+    for (unsigned char c : patterns[i]) {
+      int &slot = next[state * classCount + classOf[c]];
+      if (slot < 0) {
+        slot = (int)terminal.size();
+        next.resize(next.size() + classCount, -1);
+        terminal.push_back(0);
+        outputs.push_back(std::vector<int>());
+      }
+      state = next[state * classCount + classOf[c]];
+    }
+    terminal[state] = 1;
+    outputs[state].push_back(i);
+  }
+
+  // Enlaces de fallo en anchura, completando la tabla hasta un DFA
+  std::vector<int> fail(terminal.size(), 0);
+  std::queue<int> pending;
+  for (int c = 0; c < classCount; ++c) {
+    int &slot = next[c];
+    if (slot < 0) {
+      slot = 0;
+    } else {
+      fail[slot] = 0;
+      pending.push(slot);
+    }
+  }
+  while (!pending.empty()) {
+    int state = pending.front();
+    pending.pop();
+    int f = fail[state];
+    if (terminal[f])
+      terminal[state] = 1;
+    outputs[state].insert(outputs[state].end(), outputs[f].begin(),
+                          outputs[f].end());
+    for (int c = 0; c < classCount; ++c) {
+      int &slot = next[state * classCount + c];
+      int viaFail = next[f * classCount + c];
+      if (slot < 0) {
+        slot = viaFail;
+      } else {
+        fail[slot] = viaFail;
+        pending.push(slot);
+      }
+    }
+  }
+}
+
+bool PatternAutomaton::Any(const std::string &text) const {
+  if (patternCount == 0)
+    return false;
+  int state = 0;
+  for (unsigned char c : text) {
+    state = next[state * classCount + classOf[c]];
+    if (terminal[state])
+      return true;
+  }
+  return false;
+}
+
+void PatternAutomaton::Collect(const std::string &text,
+                               std::vector<int> &hits) const {
+  if (patternCount == 0)
+    return;
+  int state = 0;
+  for (unsigned char c : text) {
+    state = next[state * classCount + classOf[c]];
+    if (terminal[state])
+      hits.insert(hits.end(), outputs[state].begin(), outputs[state].end());
+  }
+}
+
+// ===== REGLAS =====
+
+std::string AppMatcher::ToLower(const std::string &s) {
+  std::string lower = s;
+  std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+  return lower;
+}
+
+bool AppMatcher::GlobMatch(const char *pattern, const char *text) {
+  // Comodines con retroceso al último '*' (lineal en la práctica)
+  const char *starP = nullptr;
+  const char *starT = nullptr;
+  while (*text) {
+    if (*pattern == '?' || (*pattern && *pattern != '*' && *pattern == *text)) {
+      pattern++;
+      text++;
+    } else if (*pattern == '*') {
+      starP = pattern++;
+      starT = text;
+    } else if (starP) {
+      pattern = starP + 1;
+      text = ++starT;
+    } else {
+      return false;
+    }
+  }
+  while (*pattern == '*')
+    pattern++;
+  return *pattern == 0;
+}
+
+void AppMatcher::Compile(const std::vector<std::string> &rules) {
+  for (FieldRules &f : fields)
+    f = FieldRules();
+  ruleCount = 0;
+
+  for (const std::string &raw : rules) {
+    std::string rule = ToLower(raw);
+    Field field = F_EXE;
+    if (rule.compare(0, 6, "class:") == 0) {
+      field = F_CLASS;
+      rule.erase(0, 6);
+    } else if (rule.compare(0, 6, "title:") == 0) {
+      field = F_TITLE;
+      rule.erase(0, 6);
+    }
+    if (rule.empty())
+      continue;
+
+    FieldRules &f = fields[field];
+    if (rule[0] == '=') {
+      f.exact.insert(rule.substr(1));
+    } else if (rule.find_first_of("*?") != std::string::npos) {
+      f.globs.push_back(rule);
+    } else {
+      f.substrings.push_back(rule);
+    }
+    ruleCount++;
+  }
+
+  for (FieldRules &f : fields) {
+    f.substringAutomaton.Build(f.substrings);
+
+    // Cada glob se indexa por su fragmento literal más largo
+    std::vector<std::string> keys;
+    std::vector<int> keyedGlob;
+    for (size_t g = 0; g < f.globs.size(); ++g) {
+      const std::string &pattern = f.globs[g];
+      std::string best, current;
+      for (char c : pattern) {
+        if (c == '*' || c == '?') {
+          if (current.size() > best.size())
+            best = current;
+          current.clear();
+        } else {
+          current += c;
+        }
+      }
+      if (current.size() > best.size())
+        best = current;
+
+      if (best.empty()) {
+        f.unkeyedGlobs.push_back((int)g);
+      } else {
+        keys.push_back(best);
+        keyedGlob.push_back((int)g);
+      }
+    }
+    f.globKeyAutomaton.Build(keys);
+    f.keyToGlob.swap(keyedGlob);
+  }
+}
+
+bool AppMatcher::FieldRules::Matches(const std::string &lower) const {
+  if (!exact.empty() && exact.count(lower))
+    return true;
+  if (substringAutomaton.Any(lower))
+    return true;
+  for (int g : unkeyedGlobs) {
+    if (GlobMatch(globs[g].c_str(), lower.c_str()))
+      return true;
+  }
+  if (!globKeyAutomaton.Empty()) {
+    static thread_local std::vector<int> hits; // Sin reservar por llamada
+    hits.clear();
+    globKeyAutomaton.Collect(lower, hits);
+    for (int key : hits) {
+      if (GlobMatch(globs[keyToGlob[key]].c_str(), lower.c_str()))
+        return true;
+    }
+  }
+  return false;
+}
+
+bool AppMatcher::Matches(const std::string &exeLower,
+                         const std::string *className,
+                         const std::string *title) const {
+  if (fields[F_EXE].Matches(exeLower))
+    return true;
+  if (className && NeedsClass() && fields[F_CLASS].Matches(ToLower(*className)))
+    return true;
+  if (title && NeedsTitle() && fields[F_TITLE].Matches(ToLower(*title)))
+    return true;
+  return false;
+}
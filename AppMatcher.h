@@ -0,0 +1,94 @@
+#ifndef APP_MATCHER_H
+#define APP_MATCHER_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Autómata de Aho-Corasick sobre un alfabeto comprimido
+ *
+ * Encuentra a la vez todas las apariciones de N patrones en un texto con un
+ * único recorrido: una consulta de tabla por carácter, sin importar cuántos
+ * patrones haya. Solo los bytes que aparecen en algún patrón tienen columna
+ * propia; el resto comparte la columna 0.
+ */
+class PatternAutomaton {
+public:
+  void Build(const std::vector<std::string> &patterns);
+  bool Empty() const { return patternCount == 0; }
+
+  // ¿Aparece algún patrón en el texto?
+  bool Any(const std::string &text) const;
+  // Índices de los patrones que aparecen (puede haber repetidos)
+  void Collect(const std::string &text, std::vector<int> &hits) const;
+
+private:
+  unsigned char classOf[256];
+  int classCount = 1;
+  int patternCount = 0;
+  std::vector<int> next;      // [estado * classCount + clase]
+  std::vector<char> terminal; // Algún patrón termina aquí (vía fallos)
+  std::vector<std::vector<int>> outputs;
+};
+
+/**
+ * @brief Reglas de exclusión / lista blanca compiladas
+ *
+ * Cada regla es una cadena:
+ *   - "notepad"          subcadena del ejecutable
+ *   - "=explorer.exe"    nombre exacto del ejecutable
+ *   - "steam*.exe"       glob (* y ?) sobre el ejecutable
+ *   - "class:Chrome_*"   igual, pero sobre la clase de la ventana
+ *   - "title:Picture-in-picture"  igual, pero sobre el título
+ *
+ * Las comparaciones no distinguen mayúsculas. Compile() construye, por
+ * campo, un hash de nombres exactos, un autómata para las subcadenas y otro
+ * para el fragmento literal más largo de cada glob (los globs solo se
+ * verifican si su fragmento aparece), así que comprobar un nombre cuesta
+ * O(longitud del nombre) con cualquier número de reglas.
+ */
+class AppMatcher {
+public:
+  void Compile(const std::vector<std::string> &rules);
+  bool Empty() const { return ruleCount == 0; }
+
+  // Solo hace falta pedir clase o título a la ventana si hay reglas de ese
+  // campo
+  bool NeedsClass() const { return !fields[F_CLASS].Empty(); }
+  bool NeedsTitle() const { return !fields[F_TITLE].Empty(); }
+
+  // exeLower en minúsculas; className / title pueden ser nullptr
+  bool Matches(const std::string &exeLower, const std::string *className,
+               const std::string *title) const;
+  bool MatchesExe(const std::string &exeLower) const {
+    return fields[F_EXE].Matches(exeLower);
+  }
+
+  static std::string ToLower(const std::string &s);
+
+private:
+  enum Field { F_EXE = 0, F_CLASS = 1, F_TITLE = 2, F_COUNT = 3 };
+
+  struct FieldRules {
+    std::unordered_set<std::string> exact;
+    std::vector<std::string> substrings;
+    std::vector<std::string> globs;
+    std::vector<int> keyToGlob;    // Patrón de globKeyAutomaton -> glob
+    std::vector<int> unkeyedGlobs; // Globs sin fragmento literal ("*")
+    PatternAutomaton substringAutomaton;
+    PatternAutomaton globKeyAutomaton;
+
+    bool Empty() const {
+      return exact.empty() && substrings.empty() && globs.empty();
+    }
+    bool Matches(const std::string &lower) const;
+  };
+
+  FieldRules fields[F_COUNT];
+  int ruleCount = 0;
+
+  static bool GlobMatch(const char *pattern, const char *text);
+};
+
+#endif // APP_MATCHER_H
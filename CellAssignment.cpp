@@ -0,0 +1,131 @@
+#include "CellAssignment.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+long long CellAssignment::Cost(const PixelRect &window, const PixelRect &cell) {
+  return std::llabs((long long)window.x - cell.x) +
+         std::llabs((long long)window.y - cell.y) +
+         std::llabs((long long)window.w - cell.w) +
+         std::llabs((long long)window.h - cell.h);
+}
+
+long long CellAssignment::TotalCost(const std::vector<PixelRect> &windows,
+                                    const std::vector<PixelRect> &cells,
+                                    const std::vector<int> &assignment) {
+  long long total = 0;
+  for (size_t i = 0; i < windows.size() && i < assignment.size(); ++i)
+    total += Cost(windows[i], cells[assignment[i]]);
+  return total;
+}
+
+std::vector<int> CellAssignment::Solve(const std::vector<PixelRect> &windows,
+                                       const std::vector<PixelRect> &cells,
+                                       int exactLimit) {
+  if (windows.empty() || windows.size() > cells.size())
+    return std::vector<int>();
+  if ((int)windows.size() <= exactLimit)
+    return Hungarian(windows, cells);
+  return Greedy(windows, cells);
+}
+
+std::vector<int>
+CellAssignment::Hungarian(const std::vector<PixelRect> &windows,
+                          const std::vector<PixelRect> &cells) {
+  // Potenciales u/v sobre filas (ventanas) y columnas (celdas), índices
+  // desde 1; p[j] = ventana asignada a la celda j (0 = libre)
+  const long long INF = std::numeric_limits<long long>::max() / 4;
+  int n = (int)windows.size(), m = (int)cells.size();
+  std::vector<long long> cost((size_t)n * m);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < m; ++j)
+      cost[(size_t)i * m + j] = Cost(windows[i], cells[j]);
+
+  std::vector<long long> u(n + 1, 0), v(m + 1, 0), minv(m + 1);
+  std::vector<int> p(m + 1, 0), way(m + 1, 0);
+  std::vector<char> used(m + 1);
+  for (int i = 1; i <= n; ++i) {
+    p[0] = i;
+    int j0 = 0;
+    std::fill(minv.begin(), minv.end(), INF);
+    std::fill(used.begin(), used.end(), 0);
+    do {
+      used[j0] = 1;
+      int i0 = p[j0], j1 = 0;
+      long long delta = INF;
+      const long long *row = &cost[(size_t)(i0 - 1) * m];
+      for (int j = 1; j <= m; ++j) {
+        if (used[j])
+          continue;
+        long long cur = row[j - 1] - u[i0] - v[j];
+        if (cur < minv[j]) {
+          minv[j] = cur;
+          way[j] = j0;
+        }
+        if (minv[j] < delta) {
+          delta = minv[j];
+          j1 = j;
+        }
+      }
+      for (int j = 0; j <= m; ++j) {
+        if (used[j]) {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        } else {
+          minv[j] -= delta;
+        }
+      }
+      j0 = j1;
+    } while (p[j0] != 0);
+    // Invertir el camino aumentante
+    do {
+      int j1 = way[j0];
+      p[j0] = p[j1];
+      j0 = j1;
+    } while (j0);
+  }
+
+  std::vector<int> result(n, -1);
+  for (int j = 1; j <= m; ++j)
+    if (p[j])
+      result[p[j] - 1] = j - 1;
+  return result;
+}
+
+std::vector<int> CellAssignment::Greedy(const std::vector<PixelRect> &windows,
+                                        const std::vector<PixelRect> &cells) {
+  // Primero las ventanas que tienen una celda más cercana (las que ya están
+  // casi en su sitio); cada una toma la celda libre más barata. O(n * m)
+  int n = (int)windows.size(), m = (int)cells.size();
+  std::vector<long long> best(n);
+  for (int i = 0; i < n; ++i) {
+    long long b = Cost(windows[i], cells[0]);
+    for (int j = 1; j < m; ++j)
+      b = std::min(b, Cost(windows[i], cells[j]));
+    best[i] = b;
+  }
+  std::vector<int> order(n);
+  for (int i = 0; i < n; ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [&best](int a, int b) { return best[a] < best[b]; });
+
+  std::vector<int> result(n, -1);
+  std::vector<char> taken(m, 0);
+  for (int i : order) {
+    int pick = -1;
+    long long pickCost = 0;
+    for (int j = 0; j < m; ++j) {
+      if (taken[j])
+        continue;
+      long long c = Cost(windows[i], cells[j]);
+      if (pick < 0 || c < pickCost) {
+        pick = j;
+        pickCost = c;
+      }
+    }
+    result[i] = pick;
+    taken[pick] = 1;
+  }
+  return result;
+}
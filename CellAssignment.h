@@ -0,0 +1,42 @@
+#ifndef CELL_ASSIGNMENT_H
+#define CELL_ASSIGNMENT_H
+
+#include "LayoutTable.h"
+#include <vector>
+
+/**
+ * @brief Reparto de ventanas entre celdas con el mínimo desplazamiento
+ *
+ * Ordenar y tiling calculan primero las celdas y luego deciden qué ventana
+ * va a cada una. En orden Z las ventanas cruzan la pantalla aunque ya
+ * estuvieran casi en su sitio; aquí se minimiza la suma de distancias
+ * (|dx| + |dy| + |dw| + |dh|) entre cada ventana y su celda, así que una
+ * disposición parecida a la actual apenas se mueve.
+ *
+ * Hasta exactLimit ventanas se usa el algoritmo húngaro (óptimo, O(n^3) en
+ * el peor caso); por encima, un reparto voraz O(n^2) que no garantiza el
+ * óptimo pero escala.
+ */
+class CellAssignment {
+public:
+  static const int DEFAULT_EXACT_LIMIT = 60;
+
+  // Devuelve, para cada ventana, el índice de su celda (todas distintas).
+  // Requiere windows.size() <= cells.size()
+  static std::vector<int> Solve(const std::vector<PixelRect> &windows,
+                                const std::vector<PixelRect> &cells,
+                                int exactLimit = DEFAULT_EXACT_LIMIT);
+
+  static long long Cost(const PixelRect &window, const PixelRect &cell);
+  static long long TotalCost(const std::vector<PixelRect> &windows,
+                             const std::vector<PixelRect> &cells,
+                             const std::vector<int> &assignment);
+
+private:
+  static std::vector<int> Hungarian(const std::vector<PixelRect> &windows,
+                                    const std::vector<PixelRect> &cells);
+  static std::vector<int> Greedy(const std::vector<PixelRect> &windows,
+                                 const std::vector<PixelRect> &cells);
+};
+
+#endif // CELL_ASSIGNMENT_H
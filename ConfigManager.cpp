@@ -1,6 +1,5 @@
 #include "ConfigManager.h"
 #include <algorithm>
-#include <windows.h>
 
 ConfigManager::ConfigManager(const std::string &path) : configPath(path) {
   // Si no existe, crear configuración por defecto
@@ -150,6 +149,16 @@ void ConfigManager::CreateDefault() {
   SetInt("margin", 6);
   SetInt("transparency_level", 180);
   SetInt("animation_speed", 12);
+  SetString("animation_easing", "sine");
+  SetInt("motion_speed", 900);      // px/s al empezar a mantener WASD
+  SetInt("motion_max_speed", 2700); // px/s tras motion_ramp_ms
+  SetInt("motion_ramp_ms", 600);
+  SetInt("sequence_timeout_ms", 1500);
+  SetInt("move_timeout_ms", 250);            // Plazo de SetWindowPos
+  SetInt("unresponsive_cooldown_ms", 30000); // Ventana colgada: no tocarla
+  SetInt("arrange_exact_max", 60); // Reparto óptimo hasta N ventanas
+  SetBool("auto_tiling", false);   // Árbol BSP: colocar ventanas nuevas
+  SetInt("snap_threshold", 12);    // Imán de bordes con WASD (0 = apagado)
 
   SetString("config_version", "1.0");
   SetString("hotkeys.config_panel", "Ctrl+Alt+0");
@@ -0,0 +1,66 @@
+#include "ContinuousMotion.h"
+
+// Un frame que llegue más tarde que esto (hilo parado, PC suspendido) no
+// debe lanzar la ventana al otro lado de la pantalla
+static const double MAX_FRAME_MS = 100.0;
+
+void ContinuousMotion::Configure(int startSpeed, int maxSpeed, int rampMs) {
+  if (startSpeed < 1)
+    startSpeed = 1;
+  if (maxSpeed < startSpeed)
+    maxSpeed = startSpeed;
+  if (rampMs < 0)
+    rampMs = 0;
+  this->startSpeed = startSpeed;
+  this->maxSpeed = maxSpeed;
+  this->rampMs = rampMs;
+}
+
+void ContinuousMotion::Begin(double nowMs) {
+  beginMs = nowMs;
+  lastMs = nowMs;
+  accX = 0.0;
+  accY = 0.0;
+  lastDirX = 0;
+  lastDirY = 0;
+}
+
+double ContinuousMotion::SpeedAt(double heldMs) const {
+  if (rampMs <= 0.0 || heldMs >= rampMs)
+    return maxSpeed;
+  if (heldMs <= 0.0)
+    return startSpeed;
+  // Rampa con arranque suave (cuadrática): los ajustes finos siguen siendo
+  // precisos y las pulsaciones largas cruzan la pantalla rápido
+  double u = heldMs / rampMs;
+  return startSpeed + (maxSpeed - startSpeed) * u * u;
+}
+
+void ContinuousMotion::Advance(double nowMs, int dirX, int dirY, int &dx,
+                               int &dy) {
+  double dt = nowMs - lastMs;
+  if (dt < 0.0)
+    dt = 0.0;
+  if (dt > MAX_FRAME_MS)
+    dt = MAX_FRAME_MS;
+
+  // Velocidad media del intervalo (trapecio): exacta para frames largos
+  double v = 0.5 * (SpeedAt(lastMs - beginMs) + SpeedAt(nowMs - beginMs));
+  lastMs = nowMs;
+
+  // Cambiar de sentido en un eje descarta el resto acumulado en ese eje
+  if (dirX != lastDirX)
+    accX = 0.0;
+  if (dirY != lastDirY)
+    accY = 0.0;
+  lastDirX = dirX;
+  lastDirY = dirY;
+
+  double dist = v * dt / 1000.0;
+  accX += dirX * dist;
+  accY += dirY * dist;
+  dx = (int)accX; // Trunca hacia cero: el resto queda para el siguiente
+  dy = (int)accY;
+  accX -= dx;
+  accY -= dy;
+}
@@ -0,0 +1,43 @@
+#ifndef CONTINUOUS_MOTION_H
+#define CONTINUOUS_MOTION_H
+
+/**
+ * @brief Velocidad del control continuo (Ctrl/Alt + WASD mantenido)
+ *
+ * Convierte el tiempo real entre frames en píxeles: la velocidad arranca en
+ * startSpeed (px/s) y sube hasta maxSpeed a lo largo de rampMs mientras la
+ * tecla siga pulsada. La parte fraccionaria de cada eje se acumula entre
+ * frames, así que la distancia recorrida depende solo del tiempo y no de
+ * cuándo despierte el hilo: un frame que llega tarde mueve más píxeles.
+ *
+ * No toca ventanas ni relojes; quien la usa le pasa el instante (ms de un
+ * reloj monótono) y aplica el desplazamiento con un único SetWindowPos.
+ */
+class ContinuousMotion {
+public:
+  ContinuousMotion() { Configure(900, 2700, 600); }
+
+  void Configure(int startSpeed, int maxSpeed, int rampMs);
+
+  // Empieza una pulsación continua en nowMs (reinicia rampa y acumuladores)
+  void Begin(double nowMs);
+  // Píxeles a aplicar este frame en la dirección (dirX, dirY) de -1/0/1
+  void Advance(double nowMs, int dirX, int dirY, int &dx, int &dy);
+
+  // Velocidad (px/s) tras llevar heldMs con la tecla pulsada
+  double SpeedAt(double heldMs) const;
+
+private:
+  double startSpeed = 0.0;
+  double maxSpeed = 0.0;
+  double rampMs = 0.0;
+
+  double beginMs = 0.0;
+  double lastMs = 0.0;
+  double accX = 0.0;
+  double accY = 0.0;
+  int lastDirX = 0;
+  int lastDirY = 0;
+};
+
+#endif // CONTINUOUS_MOTION_H
@@ -0,0 +1,150 @@
+#ifndef DESKTOP_BACKEND_H
+#define DESKTOP_BACKEND_H
+
+#include "WinCompat.h"
+#include <string>
+#include <vector>
+
+// Estructura para apps encontradas en el sistema
+struct DiscoveryApp {
+  std::string name;
+  std::string path;
+};
+
+// Monitor tal como lo reporta el backend
+struct MonitorDesc {
+  HMONITOR handle;
+  RECT rcMonitor; // Área completa del monitor
+  RECT rcWork;    // Área de trabajo (sin barra de tareas)
+  bool primary;
+  UINT dpi = 96; // DPI efectivo (96 = escala 100 %)
+};
+
+// Proceso en ejecución (entrada de un snapshot)
+struct ProcessDesc {
+  DWORD pid;
+  std::string exeName;
+};
+
+// Posición y tamaño destino de una ventana (SetPos / SetPosBatch)
+struct WindowPos {
+  HWND hwnd;
+  int x, y, w, h;
+  UINT flags;
+};
+
+// Cambios en una ventana de nivel superior que el backend reenvía
+enum WindowEvent {
+  WE_CREATED,
+  WE_DESTROYED,
+  WE_SHOWN,
+  WE_HIDDEN,
+  WE_CLOAKED,
+  WE_UNCLOAKED,
+  WE_TITLE_CHANGED,
+  WE_FOREGROUND,
+  WE_MOVED // El usuario terminó de moverla o redimensionarla, o (des)minimizó
+};
+
+/**
+ * @brief Receptor de eventos del escritorio
+ *
+ * El backend notifica aquí los cambios que invalidan cachés (topología de
+ * monitores, área de trabajo, ...). Los eventos llegan en el hilo que
+ * bombea mensajes (el hilo principal en Win32).
+ */
+class DesktopEventSink {
+public:
+  virtual ~DesktopEventSink() {}
+
+  // Cambió la topología de monitores, la resolución o el área de trabajo
+  virtual void OnDisplayChanged() = 0;
+
+  // Creación, destrucción, visibilidad, título o foco de una ventana
+  virtual void OnWindowEvent(HWND hwnd, WindowEvent event) {}
+};
+
+/**
+ * @brief Interfaz del escritorio sobre la que trabaja WindowManager
+ *
+ * Todo acceso al sistema de ventanas pasa por aquí. Win32Backend la
+ * implementa con la API de Windows y FakeDesktop con un escritorio simulado
+ * en memoria (ventanas, monitores, procesos y orden Z) que compila en Linux,
+ * para poder medir y probar la lógica de layouts, tiling y foco sin un
+ * escritorio real.
+ */
+class DesktopBackend {
+public:
+  virtual ~DesktopBackend() {}
+
+  // Backend nativo de la plataforma (Win32Backend en Windows)
+  static DesktopBackend *Native();
+
+  // Eventos (nullptr para dejar de recibirlos). Devuelve true si el backend
+  // entregará eventos de ventana; si no, quien cachee ventanas debe
+  // re-enumerarlas en cada lectura
+  virtual bool SetEventSink(DesktopEventSink *sink) = 0;
+
+  // Ventanas de nivel superior (en orden Z, de arriba a abajo)
+  virtual void ListTopLevelWindows(std::vector<HWND> &out) = 0;
+  virtual bool IsAlive(HWND hwnd) = 0;
+  virtual bool IsVisible(HWND hwnd) = 0;
+  virtual bool IsCloaked(HWND hwnd) = 0;
+  virtual LONG GetStyle(HWND hwnd) = 0;
+  virtual LONG GetExStyle(HWND hwnd) = 0;
+  virtual std::string GetTitle(HWND hwnd) = 0;
+  virtual std::string GetClass(HWND hwnd) = 0;
+  virtual DWORD GetWindowPid(HWND hwnd) = 0;
+  virtual HWND GetConsole() = 0;
+
+  // Geometría y orden Z
+  virtual bool GetRect(HWND hwnd, RECT &rect) = 0;
+  virtual void SetPos(HWND hwnd, int x, int y, int w, int h, UINT flags) = 0;
+  // Varias ventanas en una sola operación (DeferWindowPos en Win32): se
+  // mueven juntas, sin que se vea una detrás de otra
+  virtual void SetPosBatch(const std::vector<WindowPos> &batch) = 0;
+  virtual void RestoreWindow(HWND hwnd) = 0;
+  virtual void RaiseWindow(HWND hwnd, bool activate) = 0;
+  virtual void LowerWindow(HWND hwnd) = 0;
+  virtual void SetTopmost(HWND hwnd, bool topmost) = 0;
+  virtual void SetOpacity(HWND hwnd, int alpha) = 0; // 255 = opaca
+
+  // Foco y señales visuales
+  virtual HWND GetForeground() = 0;
+  virtual void ActivateWindow(HWND hwnd) = 0;
+  virtual void FlashCaption(HWND hwnd, DWORD timeout) = 0;
+  virtual void PostClose(HWND hwnd) = 0;
+  virtual void SendTaskView() = 0;
+  virtual bool GetCursorPoint(POINT &pt) = 0;
+
+  // Monitores
+  virtual void ListMonitors(std::vector<MonitorDesc> &out) = 0;
+  virtual bool GetMonitorForWindow(HWND hwnd, MonitorDesc &out) = 0;
+  virtual bool GetMonitorForPoint(POINT pt, MonitorDesc &out) = 0;
+  virtual HMONITOR MonitorHandleForWindow(HWND hwnd) = 0; // Sin GetMonitorInfo
+
+  // Procesos
+  virtual void ListProcesses(std::vector<ProcessDesc> &out) = 0;
+  virtual bool TerminatePid(DWORD pid) = 0;
+  virtual DWORD CurrentPid() = 0;
+
+  // Shell y sistema
+  virtual void LaunchPath(const std::string &path) = 0;
+  virtual std::vector<DiscoveryApp> DiscoverApps() = 0;
+  virtual void SetAutoStart(bool enabled) = 0;
+  virtual void ShowGameIndicator() = 0;
+  virtual void HideGameIndicator() = 0;
+  virtual bool RegisterSystemHotkey(HWND owner, int id, UINT modifiers,
+                                    UINT vk) = 0;
+  virtual void UnregisterSystemHotkey(HWND owner, int id) = 0;
+  // Temporizador: llega WM_TIMER con wParam = id devuelto (0 si falla). Con
+  // owner NULL el sistema elige el id salvo que se reutilice uno vivo
+  virtual UINT_PTR StartTimer(HWND owner, UINT_PTR id, UINT ms) = 0;
+  virtual void StopTimer(HWND owner, UINT_PTR id) = 0;
+
+  // Tiempo
+  virtual DWORD TickCount() = 0;
+  virtual void SleepMs(int ms) = 0;
+};
+
+#endif // DESKTOP_BACKEND_H
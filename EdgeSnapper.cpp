@@ -0,0 +1,90 @@
+#include "EdgeSnapper.h"
+#include <algorithm>
+#include <cstdlib>
+
+void EdgeSnapper::Clear() {
+  xEdges.clear();
+  yEdges.clear();
+}
+
+void EdgeSnapper::AddWindow(const PixelRect &rect) {
+  xEdges.push_back({rect.x, rect.y, rect.y + rect.h});
+  xEdges.push_back({rect.x + rect.w, rect.y, rect.y + rect.h});
+  yEdges.push_back({rect.y, rect.x, rect.x + rect.w});
+  yEdges.push_back({rect.y + rect.h, rect.x, rect.x + rect.w});
+}
+
+void EdgeSnapper::AddGuides(const PixelRect &area) {
+  AddWindow(area);
+  xEdges.push_back({area.x + area.w / 2, area.y, area.y + area.h});
+  yEdges.push_back({area.y + area.h / 2, area.x, area.x + area.w});
+}
+
+void EdgeSnapper::Finish() {
+  std::sort(xEdges.begin(), xEdges.end());
+  std::sort(yEdges.begin(), yEdges.end());
+}
+
+bool EdgeSnapper::Nearest(const std::vector<Edge> &edges, int from, int to,
+                          int lo, int hi, int threshold, int &out) {
+  if (from == to)
+    return false;
+  Edge key = {to - threshold, 0, 0};
+  bool found = false;
+  int bestDist = 0;
+  for (auto it = std::lower_bound(edges.begin(), edges.end(), key);
+       it != edges.end() && it->pos <= to + threshold; ++it) {
+    // Solo por delante del paso (o recién pasado): nunca hacia atrás
+    if ((long long)(it->pos - from) * (to - from) <= 0)
+      continue;
+    if (it->lo > hi + threshold || it->hi < lo - threshold)
+      continue; // Su tramo no toca el de la ventana
+    int dist = std::abs(it->pos - to);
+    if (!found || dist < bestDist) {
+      found = true;
+      bestDist = dist;
+      out = it->pos;
+    }
+  }
+  return found;
+}
+
+bool EdgeSnapper::SnapAxis(const std::vector<Edge> &edges, int from0,
+                           int from1, int &to0, int &to1, int lo, int hi,
+                           int threshold) {
+  int n0 = 0, n1 = 0;
+  bool has0 = Nearest(edges, from0, to0, lo, hi, threshold, n0);
+  bool has1 = Nearest(edges, from1, to1, lo, hi, threshold, n1);
+  if (!has0 && !has1)
+    return false;
+
+  if (to1 - to0 == from1 - from0) {
+    // Mover: gana el borde que queda más cerca y la ventana va entera
+    int delta = has0 ? n0 - to0 : n1 - to1;
+    if (has0 && has1 && std::abs(n1 - to1) < std::abs(n0 - to0))
+      delta = n1 - to1;
+    to0 += delta;
+    to1 += delta;
+    return true;
+  }
+  // Redimensionar: cada borde movido por su lado
+  if (has0)
+    to0 = n0;
+  if (has1)
+    to1 = n1;
+  return true;
+}
+
+bool EdgeSnapper::Snap(const PixelRect &from, PixelRect &to,
+                       int threshold) const {
+  if (threshold <= 0)
+    return false;
+  int x0 = to.x, x1 = to.x + to.w;
+  bool snapped = SnapAxis(xEdges, from.x, from.x + from.w, x0, x1, to.y,
+                          to.y + to.h, threshold);
+  int y0 = to.y, y1 = to.y + to.h;
+  snapped |= SnapAxis(yEdges, from.y, from.y + from.h, y0, y1, x0, x1,
+                      threshold);
+  to = {x0, y0, x1 - x0, y1 - y0};
+  return snapped;
+}
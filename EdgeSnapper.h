@@ -0,0 +1,62 @@
+#ifndef EDGE_SNAPPER_H
+#define EDGE_SNAPPER_H
+
+#include "LayoutTable.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Imán de bordes para el movimiento y redimensionado con teclado
+ *
+ * Guarda los bordes verticales (x) y horizontales (y) de las demás
+ * ventanas y las guías del monitor (bordes y mitades del área de trabajo)
+ * en dos arrays ordenados por posición. Snap() busca por búsqueda binaria
+ * los bordes a menos de 'threshold' píxeles de cada lado que se movió, así
+ * que un paso cuesta O(log n + k) aunque haya cientos de ventanas; los
+ * arrays solo se rehacen cuando se mueve otra ventana.
+ *
+ * Un borde solo atrae si su tramo toca el de la ventana (no se pega a una
+ * ventana de la otra punta de la pantalla) y si está por delante en la
+ * dirección del paso, así que el siguiente paso despega la ventana en vez
+ * de devolverla al mismo sitio.
+ *
+ * No toca el sistema, así que compila y se prueba en Linux.
+ */
+class EdgeSnapper {
+public:
+  static const int DEFAULT_THRESHOLD = 12;
+
+  void Clear();
+  // Los cuatro bordes de otra ventana
+  void AddWindow(const PixelRect &rect);
+  // Bordes y líneas centrales de un área de trabajo
+  void AddGuides(const PixelRect &area);
+  // Ordena los arrays; llamar tras añadir y antes de Snap()
+  void Finish();
+
+  // Ajusta 'to', el destino de un paso que parte de 'from'. Si se movieron
+  // los dos bordes de un eje sin cambiar el tamaño, desplaza la ventana
+  // entera; si solo uno, estira ese borde. Devuelve true si pegó alguno
+  bool Snap(const PixelRect &from, PixelRect &to, int threshold) const;
+
+  size_t EdgeCount() const { return xEdges.size() + yEdges.size(); }
+
+private:
+  struct Edge {
+    int pos;    // x de un borde vertical o y de uno horizontal
+    int lo, hi; // Tramo que cubre en el otro eje
+    bool operator<(const Edge &other) const { return pos < other.pos; }
+  };
+
+  std::vector<Edge> xEdges;
+  std::vector<Edge> yEdges;
+
+  // Mejor destino para un borde que va de 'from' a 'to', con el tramo
+  // [lo, hi] en el otro eje; false si ninguno atrae
+  static bool Nearest(const std::vector<Edge> &edges, int from, int to,
+                      int lo, int hi, int threshold, int &out);
+  static bool SnapAxis(const std::vector<Edge> &edges, int from0, int from1,
+                       int &to0, int &to1, int lo, int hi, int threshold);
+};
+
+#endif // EDGE_SNAPPER_H
@@ -0,0 +1,498 @@
+#include "FakeDesktop.h"
+#include <algorithm>
+
+#ifndef _WIN32
+// Fuera de Windows no hay escritorio real: el backend nativo es el simulado
+DesktopBackend *DesktopBackend::Native() {
+  static FakeDesktop instance;
+  return &instance;
+}
+#endif
+
+FakeDesktop::FakeDesktop() { ResetCounters(); }
+
+void FakeDesktop::ResetCounters() { counters = CallCounters(); }
+
+bool FakeDesktop::SetEventSink(DesktopEventSink *sink) {
+  eventSink = sink;
+  return sink != nullptr;
+}
+
+void FakeDesktop::Emit(HWND hwnd, WindowEvent event) {
+  if (eventSink)
+    eventSink->OnWindowEvent(hwnd, event);
+}
+
+// ===== GUION DEL ESCENARIO =====
+
+HMONITOR FakeDesktop::AddMonitor(const RECT &rcMonitor, const RECT &rcWork) {
+  MonitorDesc desc;
+  desc.handle = reinterpret_cast<HMONITOR>(nextMonitor);
+  nextMonitor += 4;
+  desc.rcMonitor = rcMonitor;
+  desc.rcWork = rcWork;
+  desc.primary = monitors.empty();
+  monitors.push_back(desc);
+  if (eventSink)
+    eventSink->OnDisplayChanged();
+  return desc.handle;
+}
+
+void FakeDesktop::RemoveMonitor(HMONITOR monitor) {
+  for (size_t i = 0; i < monitors.size(); ++i) {
+    if (monitors[i].handle == monitor) {
+      bool wasPrimary = monitors[i].primary;
+      monitors.erase(monitors.begin() + i);
+      if (wasPrimary && !monitors.empty())
+        monitors[0].primary = true;
+      if (eventSink)
+        eventSink->OnDisplayChanged();
+      return;
+    }
+  }
+}
+
+void FakeDesktop::SetWorkArea(HMONITOR monitor, const RECT &rcWork) {
+  for (MonitorDesc &mon : monitors) {
+    if (mon.handle == monitor) {
+      mon.rcWork = rcWork;
+      if (eventSink)
+        eventSink->OnDisplayChanged();
+      return;
+    }
+  }
+}
+
+void FakeDesktop::SetMonitorDpi(HMONITOR monitor, UINT dpi) {
+  for (MonitorDesc &mon : monitors) {
+    if (mon.handle == monitor) {
+      mon.dpi = dpi;
+      if (eventSink)
+        eventSink->OnDisplayChanged();
+      return;
+    }
+  }
+}
+
+void FakeDesktop::AddProcess(DWORD pid, const std::string &exeName) {
+  processes[pid] = exeName;
+}
+
+void FakeDesktop::RemoveProcess(DWORD pid) { processes.erase(pid); }
+
+HWND FakeDesktop::AddWindow(const std::string &title, DWORD pid,
+                            const RECT &rect, const std::string &className) {
+  FakeWindow w;
+  if (reusedHandle && !Lookup(reusedHandle)) {
+    w.handle = reusedHandle;
+  } else {
+    w.handle = reinterpret_cast<HWND>(nextHandle);
+    nextHandle += 4;
+  }
+  reusedHandle = NULL;
+  w.rect = rect;
+  w.style = WS_CAPTION;
+  w.exStyle = 0;
+  w.title = title;
+  w.className = className;
+  w.pid = pid;
+  w.visible = true;
+  w.cloaked = false;
+  w.minimized = false;
+  w.maximized = false;
+  w.normalRect = rect;
+  w.alpha = 255;
+
+  indexOf[w.handle] = windows.size();
+  windows.push_back(w);
+  zOrder.insert(zOrder.begin(), w.handle);
+  Emit(w.handle, WE_CREATED);
+  Emit(w.handle, WE_SHOWN);
+  return w.handle;
+}
+
+void FakeDesktop::RemoveWindow(HWND hwnd) {
+  auto it = indexOf.find(hwnd);
+  if (it == indexOf.end())
+    return;
+
+  // Borrado O(1) del almacenamiento denso: mover el último al hueco
+  size_t idx = it->second;
+  indexOf.erase(it);
+  if (idx != windows.size() - 1) {
+    windows[idx] = windows.back();
+    indexOf[windows[idx].handle] = idx;
+  }
+  windows.pop_back();
+
+  zOrder.erase(std::find(zOrder.begin(), zOrder.end(), hwnd));
+  Emit(hwnd, WE_DESTROYED);
+  if (foreground == hwnd) {
+    foreground = zOrder.empty() ? NULL : zOrder.front();
+    if (foreground)
+      Emit(foreground, WE_FOREGROUND);
+  }
+}
+
+void FakeDesktop::SetVisible(HWND hwnd, bool visible) {
+  FakeWindow *w = Lookup(hwnd);
+  if (!w || w->visible == visible)
+    return;
+  w->visible = visible;
+  Emit(hwnd, visible ? WE_SHOWN : WE_HIDDEN);
+}
+
+void FakeDesktop::SetCloaked(HWND hwnd, bool cloaked) {
+  FakeWindow *w = Lookup(hwnd);
+  if (!w || w->cloaked == cloaked)
+    return;
+  w->cloaked = cloaked;
+  Emit(hwnd, cloaked ? WE_CLOAKED : WE_UNCLOAKED);
+}
+
+void FakeDesktop::SetTitle(HWND hwnd, const std::string &title) {
+  FakeWindow *w = Lookup(hwnd);
+  if (!w)
+    return;
+  w->title = title;
+  Emit(hwnd, WE_TITLE_CHANGED);
+}
+
+void FakeDesktop::SetForeground(HWND hwnd) {
+  if (!Lookup(hwnd))
+    return;
+  foreground = hwnd;
+  MoveInZOrder(hwnd, true);
+  Emit(hwnd, WE_FOREGROUND);
+}
+
+void FakeDesktop::DragWindow(HWND hwnd, const RECT &rect) {
+  {
+    std::lock_guard<std::mutex> lock(posMutex);
+    FakeWindow *w = Lookup(hwnd);
+    if (!w)
+      return;
+    w->rect = rect;
+  }
+  Emit(hwnd, WE_MOVED);
+}
+
+void FakeDesktop::MaximizeWindow(HWND hwnd) {
+  MonitorDesc mon;
+  if (!GetMonitorForWindow(hwnd, mon))
+    return;
+  {
+    std::lock_guard<std::mutex> lock(posMutex);
+    FakeWindow *w = Lookup(hwnd);
+    if (!w || w->maximized)
+      return;
+    w->normalRect = w->rect;
+    w->rect = mon.rcWork;
+    w->maximized = true;
+  }
+  Emit(hwnd, WE_MOVED);
+}
+
+const FakeDesktop::FakeWindow *FakeDesktop::Find(HWND hwnd) const {
+  auto it = indexOf.find(hwnd);
+  return it == indexOf.end() ? nullptr : &windows[it->second];
+}
+
+FakeDesktop::FakeWindow *FakeDesktop::Lookup(HWND hwnd) {
+  auto it = indexOf.find(hwnd);
+  return it == indexOf.end() ? nullptr : &windows[it->second];
+}
+
+void FakeDesktop::MoveInZOrder(HWND hwnd, bool toTop) {
+  auto it = std::find(zOrder.begin(), zOrder.end(), hwnd);
+  if (it == zOrder.end())
+    return;
+  zOrder.erase(it);
+  if (toTop)
+    zOrder.insert(zOrder.begin(), hwnd);
+  else
+    zOrder.push_back(hwnd);
+}
+
+// ===== VENTANAS =====
+
+void FakeDesktop::ListTopLevelWindows(std::vector<HWND> &out) {
+  counters.listWindows++;
+  out = zOrder;
+}
+
+bool FakeDesktop::IsAlive(HWND hwnd) { return Lookup(hwnd) != nullptr; }
+
+bool FakeDesktop::IsVisible(HWND hwnd) {
+  FakeWindow *w = Lookup(hwnd);
+  return w && w->visible;
+}
+
+bool FakeDesktop::IsCloaked(HWND hwnd) {
+  FakeWindow *w = Lookup(hwnd);
+  return w && w->cloaked;
+}
+
+LONG FakeDesktop::GetStyle(HWND hwnd) {
+  FakeWindow *w = Lookup(hwnd);
+  return w ? w->style : 0;
+}
+
+LONG FakeDesktop::GetExStyle(HWND hwnd) {
+  FakeWindow *w = Lookup(hwnd);
+  return w ? w->exStyle : 0;
+}
+
+std::string FakeDesktop::GetTitle(HWND hwnd) {
+  FakeWindow *w = Lookup(hwnd);
+  return w ? w->title : std::string();
+}
+
+std::string FakeDesktop::GetClass(HWND hwnd) {
+  FakeWindow *w = Lookup(hwnd);
+  return w ? w->className : std::string();
+}
+
+DWORD FakeDesktop::GetWindowPid(HWND hwnd) {
+  FakeWindow *w = Lookup(hwnd);
+  return w ? w->pid : 0;
+}
+
+// ===== GEOMETRÍA Y ORDEN Z =====
+
+bool FakeDesktop::GetRect(HWND hwnd, RECT &rect) {
+  counters.getRect++;
+  FakeWindow *w = Lookup(hwnd);
+  if (!w)
+    return false;
+  rect = w->rect;
+  return true;
+}
+
+void FakeDesktop::SetPosDelay(HWND hwnd, int ms) {
+  {
+    std::lock_guard<std::mutex> lock(posMutex);
+    if (ms > 0)
+      posDelays[hwnd] = ms;
+    else
+      posDelays.erase(hwnd);
+  }
+  posRelease.notify_all();
+}
+
+void FakeDesktop::SetPos(HWND hwnd, int x, int y, int w, int h, UINT flags) {
+  {
+    std::lock_guard<std::mutex> lock(posMutex);
+    counters.setPos++;
+  }
+  Position({hwnd, x, y, w, h, flags});
+}
+
+void FakeDesktop::SetPosBatch(const std::vector<WindowPos> &batch) {
+  {
+    std::lock_guard<std::mutex> lock(posMutex);
+    counters.setPosBatch++;
+  }
+  for (const WindowPos &pos : batch)
+    Position(pos);
+}
+
+void FakeDesktop::Position(const WindowPos &pos) {
+  bool shown = false;
+  {
+    std::unique_lock<std::mutex> lock(posMutex);
+    auto it = posDelays.find(pos.hwnd);
+    if (it != posDelays.end()) {
+      int ms = it->second;
+      posRelease.wait_for(lock, std::chrono::milliseconds(ms), [&] {
+        auto d = posDelays.find(pos.hwnd);
+        return d == posDelays.end() || d->second != ms;
+      });
+    }
+    FakeWindow *fw = Lookup(pos.hwnd);
+    if (!fw)
+      return;
+    if (!(pos.flags & SWP_NOMOVE)) {
+      LONG cw = fw->rect.right - fw->rect.left;
+      LONG ch = fw->rect.bottom - fw->rect.top;
+      fw->rect.left = pos.x;
+      fw->rect.top = pos.y;
+      fw->rect.right = pos.x + cw;
+      fw->rect.bottom = pos.y + ch;
+    }
+    if (!(pos.flags & SWP_NOSIZE)) {
+      fw->rect.right = fw->rect.left + pos.w;
+      fw->rect.bottom = fw->rect.top + pos.h;
+    }
+    if ((pos.flags & SWP_SHOWWINDOW) && !fw->visible) {
+      fw->visible = true;
+      shown = true;
+    }
+  }
+  if (shown)
+    Emit(pos.hwnd, WE_SHOWN);
+}
+
+void FakeDesktop::RestoreWindow(HWND hwnd) {
+  std::lock_guard<std::mutex> lock(posMutex);
+  FakeWindow *w = Lookup(hwnd);
+  if (!w)
+    return;
+  w->minimized = false;
+  if (w->maximized) {
+    w->rect = w->normalRect; // Como SW_RESTORE
+    w->maximized = false;
+  }
+}
+
+void FakeDesktop::RaiseWindow(HWND hwnd, bool activate) {
+  if (activate)
+    SetForeground(hwnd);
+  else
+    MoveInZOrder(hwnd, true);
+}
+
+void FakeDesktop::LowerWindow(HWND hwnd) { MoveInZOrder(hwnd, false); }
+
+void FakeDesktop::SetTopmost(HWND hwnd, bool topmost) {
+  if (FakeWindow *w = Lookup(hwnd)) {
+    if (topmost)
+      w->exStyle |= WS_EX_TOPMOST;
+    else
+      w->exStyle &= ~WS_EX_TOPMOST;
+  }
+}
+
+void FakeDesktop::SetOpacity(HWND hwnd, int alpha) {
+  if (FakeWindow *w = Lookup(hwnd)) {
+    w->alpha = alpha;
+    if (alpha < 255)
+      w->exStyle |= WS_EX_LAYERED;
+    else
+      w->exStyle &= ~WS_EX_LAYERED;
+  }
+}
+
+// ===== FOCO =====
+
+void FakeDesktop::ActivateWindow(HWND hwnd) {
+  if (FakeWindow *w = Lookup(hwnd))
+    w->minimized = false;
+  SetForeground(hwnd);
+}
+
+bool FakeDesktop::GetCursorPoint(POINT &pt) {
+  pt = cursor;
+  return true;
+}
+
+// ===== MONITORES =====
+
+void FakeDesktop::ListMonitors(std::vector<MonitorDesc> &out) {
+  counters.monitorQueries++;
+  out = monitors;
+}
+
+bool FakeDesktop::DescribeMonitorAt(POINT pt, MonitorDesc &out) {
+  counters.monitorQueries++;
+  if (monitors.empty())
+    return false;
+
+  // Igual que MONITOR_DEFAULTTONEAREST: el que contiene el punto o el más
+  // cercano
+  size_t best = 0;
+  long long bestDist = -1;
+  for (size_t i = 0; i < monitors.size(); ++i) {
+    const RECT &r = monitors[i].rcMonitor;
+    long long dx = pt.x < r.left ? r.left - pt.x
+                   : pt.x >= r.right ? pt.x - r.right + 1
+                                     : 0;
+    long long dy = pt.y < r.top ? r.top - pt.y
+                   : pt.y >= r.bottom ? pt.y - r.bottom + 1
+                                      : 0;
+    long long dist = dx * dx + dy * dy;
+    if (bestDist < 0 || dist < bestDist) {
+      best = i;
+      bestDist = dist;
+    }
+  }
+  out = monitors[best];
+  return true;
+}
+
+bool FakeDesktop::GetMonitorForWindow(HWND hwnd, MonitorDesc &out) {
+  FakeWindow *w = Lookup(hwnd);
+  if (!w) {
+    if (monitors.empty())
+      return false;
+    counters.monitorQueries++;
+    out = monitors[0];
+    return true;
+  }
+  POINT center = {(w->rect.left + w->rect.right) / 2,
+                  (w->rect.top + w->rect.bottom) / 2};
+  return DescribeMonitorAt(center, out);
+}
+
+bool FakeDesktop::GetMonitorForPoint(POINT pt, MonitorDesc &out) {
+  return DescribeMonitorAt(pt, out);
+}
+
+HMONITOR FakeDesktop::MonitorHandleForWindow(HWND hwnd) {
+  MonitorDesc mon;
+  return GetMonitorForWindow(hwnd, mon) ? mon.handle : NULL;
+}
+
+// ===== PROCESOS =====
+
+void FakeDesktop::ListProcesses(std::vector<ProcessDesc> &out) {
+  counters.listProcesses++;
+  out.clear();
+  out.reserve(processes.size());
+  for (const auto &p : processes) {
+    ProcessDesc desc;
+    desc.pid = p.first;
+    desc.exeName = p.second;
+    out.push_back(desc);
+  }
+}
+
+bool FakeDesktop::TerminatePid(DWORD pid) {
+  if (processes.erase(pid) == 0)
+    return false;
+  std::vector<HWND> owned;
+  for (const auto &w : windows) {
+    if (w.pid == pid)
+      owned.push_back(w.handle);
+  }
+  for (HWND h : owned)
+    RemoveWindow(h);
+  return true;
+}
+
+// ===== HOTKEYS =====
+
+bool FakeDesktop::RegisterSystemHotkey(HWND owner, int id, UINT modifiers,
+                                       UINT vk) {
+  counters.hotkeyRegister++;
+  for (const auto &hk : hotkeys) {
+    if (hk.second.first == modifiers && hk.second.second == vk)
+      return false;
+  }
+  if (hotkeys.count(id))
+    return false;
+  hotkeys[id] = std::make_pair(modifiers, vk);
+  return true;
+}
+
+void FakeDesktop::UnregisterSystemHotkey(HWND owner, int id) {
+  counters.hotkeyUnregister++;
+  hotkeys.erase(id);
+}
+
+UINT_PTR FakeDesktop::StartTimer(HWND owner, UINT_PTR id, UINT ms) {
+  if (!owner && !timers.count(id))
+    id = nextTimer++; // Como SetTimer sin ventana
+  timers[id] = clockMs + ms;
+  return id;
+}
@@ -0,0 +1,169 @@
+#ifndef FAKE_DESKTOP_H
+#define FAKE_DESKTOP_H
+
+#include "DesktopBackend.h"
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief Escritorio simulado en memoria que implementa DesktopBackend
+ *
+ * Mantiene ventanas, monitores, procesos y orden Z sin tocar el sistema
+ * operativo, así que compila y corre en Linux. Sirve para medir cómo escalan
+ * TileAllWindows, ArrangeAllWindowsNoOverlap, etc. con miles de ventanas
+ * sintéticas y para reproducir escenarios de forma determinista.
+ *
+ * El reloj es virtual: SleepMs avanza TickCount sin dormir de verdad. Los
+ * métodos del guion emiten los mismos eventos de ventana que Win32Backend,
+ * de forma síncrona, para reproducir secuencias de eventos en Linux.
+ */
+class FakeDesktop : public DesktopBackend {
+public:
+  struct FakeWindow {
+    HWND handle;
+    RECT rect;
+    LONG style;
+    LONG exStyle;
+    std::string title;
+    std::string className;
+    DWORD pid;
+    bool visible;
+    bool cloaked;
+    bool minimized;
+    bool maximized;
+    RECT normalRect; // Al que vuelve RestoreWindow si está maximizada
+    int alpha;
+  };
+
+  // Contadores de llamadas para benchmarks
+  struct CallCounters {
+    long long setPos;
+    long long setPosBatch; // Lotes (cuentan como una llamada al sistema)
+    long long getRect;
+    long long listWindows;
+    long long listProcesses;
+    long long monitorQueries;
+    long long hotkeyRegister;
+    long long hotkeyUnregister;
+  };
+
+  FakeDesktop();
+
+  // Guion del escenario
+  HMONITOR AddMonitor(const RECT &rcMonitor, const RECT &rcWork);
+  void RemoveMonitor(HMONITOR monitor);
+  void SetWorkArea(HMONITOR monitor, const RECT &rcWork);
+  void SetMonitorDpi(HMONITOR monitor, UINT dpi);
+  void AddProcess(DWORD pid, const std::string &exeName);
+  void RemoveProcess(DWORD pid);
+  HWND AddWindow(const std::string &title, DWORD pid, const RECT &rect,
+                 const std::string &className = "FakeWindow");
+  void RemoveWindow(HWND hwnd);
+  // La siguiente AddWindow recibe hwnd (ya cerrada), como cuando Windows
+  // recicla un HWND
+  void ReuseHandle(HWND hwnd) { reusedHandle = hwnd; }
+  void SetVisible(HWND hwnd, bool visible);
+  void SetCloaked(HWND hwnd, bool cloaked);
+  void SetTitle(HWND hwnd, const std::string &title);
+  void SetForeground(HWND hwnd);
+  // El usuario arrastra la ventana a rect (SetPos no avisa, esto sí)
+  void DragWindow(HWND hwnd, const RECT &rect);
+  // El usuario la maximiza: ocupa el área de trabajo de su monitor
+  void MaximizeWindow(HWND hwnd);
+  void SetCursor(POINT pt) { cursor = pt; }
+  // Bloquea cada SetPos sobre hwnd durante ms de tiempo real (no del reloj
+  // virtual) para simular una app colgada; 0 lo quita y suelta a quien
+  // esté esperando. SetPos admite llamadas desde varios hilos
+  void SetPosDelay(HWND hwnd, int ms);
+
+  const FakeWindow *Find(HWND hwnd) const;
+  size_t WindowCount() const { return zOrder.size(); }
+  CallCounters &Counters() { return counters; }
+  void ResetCounters();
+
+  // DesktopBackend
+  bool SetEventSink(DesktopEventSink *sink) override;
+
+  void ListTopLevelWindows(std::vector<HWND> &out) override;
+  bool IsAlive(HWND hwnd) override;
+  bool IsVisible(HWND hwnd) override;
+  bool IsCloaked(HWND hwnd) override;
+  LONG GetStyle(HWND hwnd) override;
+  LONG GetExStyle(HWND hwnd) override;
+  std::string GetTitle(HWND hwnd) override;
+  std::string GetClass(HWND hwnd) override;
+  DWORD GetWindowPid(HWND hwnd) override;
+  HWND GetConsole() override { return NULL; }
+
+  bool GetRect(HWND hwnd, RECT &rect) override;
+  void SetPos(HWND hwnd, int x, int y, int w, int h, UINT flags) override;
+  void SetPosBatch(const std::vector<WindowPos> &batch) override;
+  void RestoreWindow(HWND hwnd) override;
+  void RaiseWindow(HWND hwnd, bool activate) override;
+  void LowerWindow(HWND hwnd) override;
+  void SetTopmost(HWND hwnd, bool topmost) override;
+  void SetOpacity(HWND hwnd, int alpha) override;
+
+  HWND GetForeground() override { return foreground; }
+  void ActivateWindow(HWND hwnd) override;
+  void FlashCaption(HWND hwnd, DWORD timeout) override {}
+  void PostClose(HWND hwnd) override { RemoveWindow(hwnd); }
+  void SendTaskView() override {}
+  bool GetCursorPoint(POINT &pt) override;
+
+  void ListMonitors(std::vector<MonitorDesc> &out) override;
+  bool GetMonitorForWindow(HWND hwnd, MonitorDesc &out) override;
+  bool GetMonitorForPoint(POINT pt, MonitorDesc &out) override;
+  HMONITOR MonitorHandleForWindow(HWND hwnd) override;
+
+  void ListProcesses(std::vector<ProcessDesc> &out) override;
+  bool TerminatePid(DWORD pid) override;
+  DWORD CurrentPid() override { return 1; }
+
+  void LaunchPath(const std::string &path) override {}
+  std::vector<DiscoveryApp> DiscoverApps() override { return {}; }
+  void SetAutoStart(bool enabled) override {}
+  void ShowGameIndicator() override {}
+  void HideGameIndicator() override {}
+  bool RegisterSystemHotkey(HWND owner, int id, UINT modifiers,
+                            UINT vk) override;
+  void UnregisterSystemHotkey(HWND owner, int id) override;
+  UINT_PTR StartTimer(HWND owner, UINT_PTR id, UINT ms) override;
+  void StopTimer(HWND owner, UINT_PTR id) override { timers.erase(id); }
+  bool IsTimerActive(UINT_PTR id) const { return timers.count(id) != 0; }
+
+  DWORD TickCount() override { return clockMs; }
+  void SleepMs(int ms) override { clockMs += ms; }
+
+private:
+  std::vector<FakeWindow> windows; // Almacenamiento denso
+  std::unordered_map<HWND, size_t> indexOf;
+  std::vector<HWND> zOrder; // De arriba a abajo
+  std::vector<MonitorDesc> monitors;
+  std::map<DWORD, std::string> processes;
+  std::map<int, std::pair<UINT, UINT>> hotkeys;
+  std::map<UINT_PTR, DWORD> timers; // id -> vencimiento en clockMs
+  UINT_PTR nextTimer = 1;
+  DesktopEventSink *eventSink = nullptr;
+  uintptr_t nextMonitor = 0x1000;
+  HWND foreground = NULL;
+  POINT cursor = {0, 0};
+  DWORD clockMs = 0;
+  uintptr_t nextHandle = 0x10;
+  HWND reusedHandle = NULL;
+  CallCounters counters;
+  std::mutex posMutex; // SetPos concurrente (MoveDispatcher)
+  std::condition_variable posRelease;
+  std::unordered_map<HWND, int> posDelays;
+
+  FakeWindow *Lookup(HWND hwnd);
+  void Position(const WindowPos &pos);
+  void Emit(HWND hwnd, WindowEvent event);
+  void MoveInZOrder(HWND hwnd, bool toTop);
+  bool DescribeMonitorAt(POINT pt, MonitorDesc &out);
+};
+
+#endif // FAKE_DESKTOP_H
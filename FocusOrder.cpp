@@ -0,0 +1,110 @@
+#include "FocusOrder.h"
+
+int FocusOrder::Alloc(HWND hwnd) {
+  Node node = {hwnd, -1, -1};
+  int index;
+  if (!freeNodes.empty()) {
+    index = freeNodes.back();
+    freeNodes.pop_back();
+    nodes[index] = node;
+  } else {
+    index = (int)nodes.size();
+    nodes.push_back(node);
+  }
+  indexOf[hwnd] = index;
+  return index;
+}
+
+void FocusOrder::Unlink(int index) {
+  Node &node = nodes[index];
+  if (node.prev >= 0)
+    nodes[node.prev].next = node.next;
+  else
+    head = node.next;
+  if (node.next >= 0)
+    nodes[node.next].prev = node.prev;
+  else
+    tail = node.prev;
+  node.prev = node.next = -1;
+}
+
+void FocusOrder::LinkFront(int index) {
+  nodes[index].prev = -1;
+  nodes[index].next = head;
+  if (head >= 0)
+    nodes[head].prev = index;
+  else
+    tail = index;
+  head = index;
+}
+
+void FocusOrder::LinkBack(int index) {
+  nodes[index].next = -1;
+  nodes[index].prev = tail;
+  if (tail >= 0)
+    nodes[tail].next = index;
+  else
+    head = index;
+  tail = index;
+}
+
+void FocusOrder::Touch(HWND hwnd) {
+  if (!hwnd)
+    return;
+  auto it = indexOf.find(hwnd);
+  if (it == indexOf.end()) {
+    LinkFront(Alloc(hwnd));
+    return;
+  }
+  if (it->second == head)
+    return;
+  Unlink(it->second);
+  LinkFront(it->second);
+}
+
+void FocusOrder::Append(HWND hwnd) {
+  if (hwnd && !indexOf.count(hwnd))
+    LinkBack(Alloc(hwnd));
+}
+
+bool FocusOrder::Remove(HWND hwnd) {
+  auto it = indexOf.find(hwnd);
+  if (it == indexOf.end())
+    return false;
+  int index = it->second;
+  indexOf.erase(it);
+  Unlink(index);
+  nodes[index].hwnd = NULL;
+  freeNodes.push_back(index);
+  return true;
+}
+
+void FocusOrder::Clear() {
+  nodes.clear();
+  freeNodes.clear();
+  indexOf.clear();
+  head = tail = -1;
+}
+
+HWND FocusOrder::Next(HWND hwnd) const {
+  auto it = indexOf.find(hwnd);
+  if (it == indexOf.end())
+    return NULL;
+  int next = nodes[it->second].next;
+  return nodes[next >= 0 ? next : head].hwnd;
+}
+
+HWND FocusOrder::Prev(HWND hwnd) const {
+  auto it = indexOf.find(hwnd);
+  if (it == indexOf.end())
+    return NULL;
+  int prev = nodes[it->second].prev;
+  return nodes[prev >= 0 ? prev : tail].hwnd;
+}
+
+void FocusOrder::Windows(std::vector<HWND> &out) const {
+  out.clear();
+  out.reserve(indexOf.size());
+  for (int index = head; index >= 0; index = nodes[index].next)
+    out.push_back(nodes[index].hwnd);
+}
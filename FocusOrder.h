@@ -0,0 +1,63 @@
+#ifndef FOCUS_ORDER_H
+#define FOCUS_ORDER_H
+
+#include "WinCompat.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Orden de uso reciente (MRU) de las ventanas, para cambiar de foco
+ *
+ * Lista doblemente enlazada intrusiva (nodos en un vector denso con lista
+ * libre, enlaces por índice) más un índice HWND -> nodo. Se mantiene con
+ * los eventos de foco: Touch() pasa la ventana al frente, Remove() la saca,
+ * todo en O(1). Next()/Prev() dan la vecina en O(1) sin enumerar ventanas.
+ *
+ * Al frente la más reciente. Next() va hacia las más antiguas y Prev() hacia
+ * las más recientes; ambas dan la vuelta al llegar al extremo.
+ *
+ * No toca el sistema, así que compila y se prueba en Linux. No es segura
+ * entre hilos: WindowManager la protege con su mutex.
+ */
+class FocusOrder {
+public:
+  // Pasa hwnd al frente (la añade si no estaba)
+  void Touch(HWND hwnd);
+  // Añade hwnd al final si no estaba (conocida pero nunca enfocada)
+  void Append(HWND hwnd);
+  bool Remove(HWND hwnd);
+  void Clear();
+
+  bool Contains(HWND hwnd) const { return indexOf.count(hwnd) != 0; }
+  size_t Size() const { return indexOf.size(); }
+  HWND Front() const { return head < 0 ? NULL : nodes[head].hwnd; }
+  HWND Back() const { return tail < 0 ? NULL : nodes[tail].hwnd; }
+
+  // Vecina de hwnd dando la vuelta; NULL si hwnd no está
+  HWND Next(HWND hwnd) const;
+  HWND Prev(HWND hwnd) const;
+
+  // De la más reciente a la más antigua
+  void Windows(std::vector<HWND> &out) const;
+
+private:
+  struct Node {
+    HWND hwnd;
+    int prev; // -1 en el frente
+    int next; // -1 al final
+  };
+
+  std::vector<Node> nodes;
+  std::vector<int> freeNodes;
+  std::unordered_map<HWND, int> indexOf;
+  int head = -1;
+  int tail = -1;
+
+  int Alloc(HWND hwnd);
+  void Unlink(int index);
+  void LinkFront(int index);
+  void LinkBack(int index);
+};
+
+#endif // FOCUS_ORDER_H
@@ -0,0 +1,107 @@
+#include "GeometryJournal.h"
+
+// ===== GeometryHistory =====
+
+void GeometryHistory::PushCapped(std::vector<Entry> &stack,
+                                 const Entry &entry) {
+  if (stack.size() >= CAPACITY)
+    stack.erase(stack.begin()); // La más vieja
+  stack.push_back(entry);
+}
+
+bool GeometryHistory::Push(const PixelRect &rect, uint64_t seq) {
+  redo.clear();
+  if (!undo.empty()) {
+    const PixelRect &top = undo.back().rect;
+    if (top.x == rect.x && top.y == rect.y && top.w == rect.w &&
+        top.h == rect.h)
+      return false;
+  }
+  PushCapped(undo, {rect, seq});
+  return true;
+}
+
+bool GeometryHistory::Undo(const PixelRect &current, Entry &out) {
+  if (undo.empty())
+    return false;
+  out = undo.back();
+  undo.pop_back();
+  PushCapped(redo, {current, out.seq});
+  return true;
+}
+
+bool GeometryHistory::Redo(const PixelRect &current, Entry &out) {
+  if (redo.empty())
+    return false;
+  out = redo.back();
+  redo.pop_back();
+  PushCapped(undo, {current, out.seq});
+  return true;
+}
+
+// ===== GeometryJournal =====
+
+bool GeometryJournal::Transaction::Touches(HWND hwnd) const {
+  for (const Entry &entry : entries) {
+    if (entry.hwnd == hwnd)
+      return true;
+  }
+  return false;
+}
+
+bool GeometryJournal::Record(uint64_t seq, std::vector<Entry> entries) {
+  ClearRedo();
+  if (entries.empty() || entries.size() > maxEntries || maxTransactions == 0)
+    return false;
+  entryCount += entries.size();
+  undo.push_back({seq, std::move(entries)});
+  Evict();
+  return true;
+}
+
+const GeometryJournal::Transaction *GeometryJournal::PeekUndo() const {
+  return undo.empty() ? nullptr : &undo.back();
+}
+
+const GeometryJournal::Transaction *GeometryJournal::PeekRedo() const {
+  return redo.empty() ? nullptr : &redo.back();
+}
+
+bool GeometryJournal::Move(std::deque<Transaction> &from,
+                           std::deque<Transaction> &to, uint64_t seq,
+                           std::vector<Entry> &current) {
+  if (from.empty() || from.back().seq != seq)
+    return false;
+  entryCount -= from.back().entries.size();
+  from.pop_back();
+  entryCount += current.size();
+  to.push_back({seq, std::move(current)});
+  Evict();
+  return true;
+}
+
+bool GeometryJournal::Undo(uint64_t seq, std::vector<Entry> current) {
+  return Move(undo, redo, seq, current);
+}
+
+bool GeometryJournal::Redo(uint64_t seq, std::vector<Entry> current) {
+  return Move(redo, undo, seq, current);
+}
+
+void GeometryJournal::ClearRedo() {
+  for (const Transaction &t : redo)
+    entryCount -= t.entries.size();
+  redo.clear();
+}
+
+void GeometryJournal::Evict() {
+  // Primero lo más viejo de deshacer; rehacer solo si no queda otra
+  while (undo.size() + redo.size() > maxTransactions ||
+         entryCount > maxEntries) {
+    std::deque<Transaction> &victim = undo.size() > 1 ? undo : redo;
+    if (victim.empty())
+      break;
+    entryCount -= victim.front().entries.size();
+    victim.pop_front();
+  }
+}
@@ -0,0 +1,126 @@
+#ifndef GEOMETRY_JOURNAL_H
+#define GEOMETRY_JOURNAL_H
+
+#include "DesktopBackend.h"
+#include "LayoutTable.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * @brief Historial de geometría de una ventana (deshacer/rehacer)
+ *
+ * Cada acción sobre la ventana (layout, mover, redimensionar, las 25
+ * posiciones, ...) guarda antes el rectángulo que tenía. Deshacer lo saca
+ * y deja el rectángulo actual en la pila de rehacer, y al revés. Cada
+ * entrada lleva el número de secuencia global de la acción, para decidir
+ * contra GeometryJournal cuál de las dos es más reciente.
+ *
+ * Como mucho CAPACITY entradas por pila: al pasarse se pierde la más vieja.
+ */
+class GeometryHistory {
+public:
+  static const size_t CAPACITY = 16;
+
+  struct Entry {
+    PixelRect rect;
+    uint64_t seq;
+  };
+
+  // Anota el rectángulo previo a una acción y vacía rehacer. Devuelve false
+  // (sin anotar) si es igual al último guardado
+  bool Push(const PixelRect &rect, uint64_t seq);
+
+  // Saca el último estado y guarda 'current' en la otra pila con la misma
+  // secuencia; false si no hay nada
+  bool Undo(const PixelRect &current, Entry &out);
+  bool Redo(const PixelRect &current, Entry &out);
+
+  const Entry *PeekUndo() const {
+    return undo.empty() ? nullptr : &undo.back();
+  }
+  const Entry *PeekRedo() const {
+    return redo.empty() ? nullptr : &redo.back();
+  }
+  void ClearRedo() { redo.clear(); }
+  size_t UndoSize() const { return undo.size(); }
+  size_t RedoSize() const { return redo.size(); }
+
+private:
+  std::vector<Entry> undo; // Vacíos hasta la primera acción
+  std::vector<Entry> redo;
+
+  static void PushCapped(std::vector<Entry> &stack, const Entry &entry);
+};
+
+/**
+ * @brief Diario global de operaciones sobre varias ventanas
+ *
+ * Ordenar, tiling y maestro/pila mueven muchas ventanas de una vez; el
+ * diario guarda la transacción entera (rectángulo previo de cada ventana)
+ * para deshacerla o rehacerla como un único lote. Cada entrada lleva una
+ * etiqueta (el Id del registro de la ventana) para que quien reproduzca la
+ * transacción salte las ventanas que ya no existen aunque su HWND se haya
+ * reutilizado.
+ *
+ * La memoria está acotada: como mucho maxTransactions transacciones y
+ * maxEntries entradas entre deshacer y rehacer; se descartan las más
+ * viejas. Solo guarda HWND y rectángulos, así que compila y se prueba en
+ * Linux.
+ */
+class GeometryJournal {
+public:
+  static const size_t DEFAULT_MAX_TRANSACTIONS = 32;
+  static const size_t DEFAULT_MAX_ENTRIES = 4096;
+
+  struct Entry {
+    HWND hwnd;
+    uint64_t tag; // Identidad de la ventana al anotarla
+    PixelRect rect;
+  };
+
+  struct Transaction {
+    uint64_t seq;
+    std::vector<Entry> entries;
+
+    bool Touches(HWND hwnd) const;
+  };
+
+  GeometryJournal(size_t maxTransactions = DEFAULT_MAX_TRANSACTIONS,
+                  size_t maxEntries = DEFAULT_MAX_ENTRIES)
+      : maxTransactions(maxTransactions), maxEntries(maxEntries) {}
+
+  // Secuencia compartida con los GeometryHistory de cada ventana
+  uint64_t NextSeq() { return ++lastSeq; }
+
+  // Anota una transacción nueva y vacía rehacer. Una transacción vacía o
+  // más grande que maxEntries no se anota
+  bool Record(uint64_t seq, std::vector<Entry> entries);
+
+  const Transaction *PeekUndo() const;
+  const Transaction *PeekRedo() const;
+
+  // Mueve la transacción 'seq' (que debe estar en la cima) a la otra pila,
+  // con 'current' como rectángulos; false si otro llegó antes
+  bool Undo(uint64_t seq, std::vector<Entry> current);
+  bool Redo(uint64_t seq, std::vector<Entry> current);
+
+  void ClearRedo();
+  size_t UndoSize() const { return undo.size(); }
+  size_t RedoSize() const { return redo.size(); }
+  size_t EntryCount() const { return entryCount; }
+
+private:
+  std::deque<Transaction> undo; // El final es la cima
+  std::deque<Transaction> redo;
+  size_t maxTransactions;
+  size_t maxEntries;
+  size_t entryCount = 0;
+  uint64_t lastSeq = 0;
+
+  bool Move(std::deque<Transaction> &from, std::deque<Transaction> &to,
+            uint64_t seq, std::vector<Entry> &current);
+  void Evict();
+};
+
+#endif // GEOMETRY_JOURNAL_H
@@ -0,0 +1,34 @@
+#include "GeometryTransaction.h"
+
+void GeometryTransaction::Set(HWND hwnd, int x, int y, int w, int h,
+                              UINT flags) {
+  if (!hwnd)
+    return;
+  WindowPos pos = {hwnd, x, y, w, h, flags};
+  auto it = indexOf.find(hwnd);
+  if (it != indexOf.end()) {
+    targets[it->second] = pos;
+    return;
+  }
+  indexOf[hwnd] = targets.size();
+  targets.push_back(pos);
+}
+
+size_t GeometryTransaction::DropUnchanged() {
+  size_t kept = 0;
+  for (size_t i = 0; i < targets.size(); ++i) {
+    const WindowPos &pos = targets[i];
+    RECT rc;
+    if (backend->GetRect(pos.hwnd, rc) && rc.left == pos.x &&
+        rc.top == pos.y && rc.right - rc.left == pos.w &&
+        rc.bottom - rc.top == pos.h)
+      continue;
+    targets[kept++] = pos;
+  }
+  size_t dropped = targets.size() - kept;
+  targets.resize(kept);
+  indexOf.clear();
+  for (size_t i = 0; i < targets.size(); ++i)
+    indexOf[targets[i].hwnd] = i;
+  return dropped;
+}
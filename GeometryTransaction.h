@@ -0,0 +1,38 @@
+#ifndef GEOMETRY_TRANSACTION_H
+#define GEOMETRY_TRANSACTION_H
+
+#include "DesktopBackend.h"
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Destinos de varias ventanas que se aplican de una vez
+ *
+ * Las operaciones sobre muchas ventanas (tiling, ordenar, maestro/pila)
+ * primero anotan aquí todos los rectángulos destino y luego los aplican
+ * juntos: un SetPosBatch (DeferWindowPos) por proceso, en paralelo, o con
+ * animaciones un lote por frame para todas las ventanas, en vez de una
+ * animación por ventana que se ve avanzar una detrás de otra.
+ */
+class GeometryTransaction {
+public:
+  explicit GeometryTransaction(DesktopBackend *backend) : backend(backend) {}
+
+  // Anota el destino de hwnd; si ya estaba, gana el último
+  void Set(HWND hwnd, int x, int y, int w, int h,
+           UINT flags = SWP_NOZORDER | SWP_NOACTIVATE);
+
+  // Descarta las ventanas que ya están en su destino; devuelve cuántas
+  size_t DropUnchanged();
+
+  bool Empty() const { return targets.empty(); }
+  size_t Size() const { return targets.size(); }
+  const std::vector<WindowPos> &Targets() const { return targets; }
+
+private:
+  DesktopBackend *backend;
+  std::vector<WindowPos> targets;
+  std::unordered_map<HWND, size_t> indexOf;
+};
+
+#endif // GEOMETRY_TRANSACTION_H
@@ -1,4 +1,5 @@
 #include "HotkeyManager.h"
+#include "KeymapProfiles.h"
 #include "Logger.h"
 #include <algorithm>
 #include <cctype>
@@ -6,7 +7,10 @@
 #include <string>
 
 
-HotkeyManager::HotkeyManager() : messageWindow(NULL) {
+HotkeyManager::HotkeyManager(DesktopBackend *backend)
+    : backend(backend), messageWindow(NULL), hotkeys(MAX_ID - MIN_ID),
+      comboOwner(COMBO_COUNT, 0), count(0), profile(nullptr), stepCount(0),
+      seqNode(-1), seqTimer(0), sequenceTimeoutMs(1500) {
   LOG_INFO("HotkeyManager inicializado");
 }
 
@@ -17,10 +21,45 @@ HotkeyManager::~HotkeyManager() {
 
 void HotkeyManager::SetMessageWindow(HWND hwnd) { messageWindow = hwnd; }
 
+int HotkeyManager::ComboIndex(UINT modifiers, UINT vk) {
+  // MOD_NOREPEAT y demás bits altos no distinguen combinaciones
+  return KeymapTrie::MakeCombo(modifiers, vk);
+}
+
+static void InvokeCallback(const InlineCallback &callback, int id) {
+  try {
+    callback(id);
+  } catch (const std::exception &e) {
+    LOG_ERROR(std::string("Excepcion en callback de hotkey ID ") +
+              std::to_string(id) + ": " + e.what());
+  } catch (...) {
+    LOG_ERROR(std::string("Excepcion desconocida en callback de hotkey ID ") +
+              std::to_string(id));
+  }
+}
+
+HotkeyManager::HotkeyInfo *HotkeyManager::Find(int id) {
+  if (id < MIN_ID || id >= MAX_ID || !hotkeys[id - MIN_ID].registered)
+    return nullptr;
+  return &hotkeys[id - MIN_ID];
+}
+
+const HotkeyManager::HotkeyInfo *HotkeyManager::Find(int id) const {
+  if (id < MIN_ID || id >= MAX_ID || !hotkeys[id - MIN_ID].registered)
+    return nullptr;
+  return &hotkeys[id - MIN_ID];
+}
+
 bool HotkeyManager::RegisterHotkey(int id, UINT modifiers, UINT vk,
                                    HotkeyCallback callback) {
+  if (id < MIN_ID || id >= MAX_ID) {
+    LOG_ERROR(std::string("Hotkey ID ") + std::to_string(id) +
+              " fuera de rango");
+    return false;
+  }
+
   // Validar que no estÃ© ya registrado
-  if (hotkeys.find(id) != hotkeys.end()) {
+  if (Find(id)) {
     LOG_WARNING(std::string("Hotkey ID ") + std::to_string(id) +
                 " ya esta registrado");
     return false;
@@ -33,8 +72,10 @@ bool HotkeyManager::RegisterHotkey(int id, UINT modifiers, UINT vk,
     return false;
   }
 
-  // Registrar con Windows
-  if (!RegisterHotKey(messageWindow, id, modifiers, vk)) {
+  // Registrar con Windows, salvo que el perfil en vigor lo desactive
+  bool enabled = EnabledByProfile(id);
+  if (enabled &&
+      !backend->RegisterSystemHotkey(messageWindow, id, modifiers, vk)) {
     LOG_ERROR(std::string("Fallo al registrar hotkey ID ") +
               std::to_string(id) + ": " + ModifiersToString(modifiers) + "+" +
               VkToString(vk));
@@ -42,14 +83,14 @@ bool HotkeyManager::RegisterHotkey(int id, UINT modifiers, UINT vk,
   }
 
   // Guardar informaciÃ³n
-  HotkeyInfo info;
-  info.id = id;
+  HotkeyInfo &info = hotkeys[id - MIN_ID];
   info.modifiers = modifiers;
   info.vk = vk;
   info.callback = callback;
   info.registered = true;
-
-  hotkeys[id] = info;
+  info.suspended = !enabled;
+  comboOwner[ComboIndex(modifiers, vk)] = (short)id;
+  ++count;
 
   LOG_INFO(std::string("Hotkey registrado: ID=") + std::to_string(id) + " " +
            ModifiersToString(modifiers) + "+" + VkToString(vk));
@@ -68,71 +109,296 @@ bool HotkeyManager::RegisterHotkey(int id, const std::string &hotkeyString,
 }
 
 bool HotkeyManager::UnregisterHotkey(int id) {
-  auto it = hotkeys.find(id);
-  if (it == hotkeys.end()) {
+  HotkeyInfo *info = Find(id);
+  if (!info) {
     return false;
   }
 
-  if (it->second.registered) {
-    UnregisterHotKey(messageWindow, id);
-    LOG_INFO(std::string("Hotkey desregistrado: ID=") + std::to_string(id));
-  }
+  if (!info->suspended)
+    backend->UnregisterSystemHotkey(messageWindow, id);
+  LOG_INFO(std::string("Hotkey desregistrado: ID=") + std::to_string(id));
 
-  hotkeys.erase(it);
+  comboOwner[ComboIndex(info->modifiers, info->vk)] = 0;
+  *info = HotkeyInfo();
+  --count;
   return true;
 }
 
 void HotkeyManager::UnregisterAll() {
-  for (auto &pair : hotkeys) {
-    if (pair.second.registered) {
-      UnregisterHotKey(messageWindow, pair.first);
+  EndSequence();
+  if (count > 0) {
+    for (int id = MIN_ID; id < MAX_ID; ++id) {
+      const HotkeyInfo &info = hotkeys[id - MIN_ID];
+      if (info.registered && !info.suspended) {
+        backend->UnregisterSystemHotkey(messageWindow, id);
+      }
     }
   }
-  hotkeys.clear();
+  std::fill(hotkeys.begin(), hotkeys.end(), HotkeyInfo());
+  std::fill(comboOwner.begin(), comboOwner.end(), (short)0);
+  count = 0;
   LOG_INFO("Todos los hotkeys desregistrados");
 }
 
+void HotkeyManager::SyncRange(int firstId, int lastId,
+                              const std::vector<Binding> &bindings) {
+  if (firstId < MIN_ID)
+    firstId = MIN_ID;
+  if (lastId > MAX_ID)
+    lastId = MAX_ID;
+  if (firstId >= lastId)
+    return;
+
+  std::vector<const Binding *> wanted(lastId - firstId, nullptr);
+  for (const Binding &b : bindings) {
+    if (b.id < firstId || b.id >= lastId) {
+      LOG_WARNING(std::string("Hotkey ID ") + std::to_string(b.id) +
+                  " fuera del rango sincronizado");
+      continue;
+    }
+    wanted[b.id - firstId] = &b;
+  }
+
+  // Primero liberar: una combinación que pasa de un ID a otro del rango
+  // debe quedar libre antes de registrarla en su nuevo ID
+  for (int id = firstId; id < lastId; ++id) {
+    const HotkeyInfo *cur = Find(id);
+    const Binding *want = wanted[id - firstId];
+    if (cur && (!want || cur->modifiers != want->modifiers ||
+                cur->vk != want->vk)) {
+      UnregisterHotkey(id);
+    }
+  }
+
+  for (int id = firstId; id < lastId; ++id) {
+    const Binding *want = wanted[id - firstId];
+    if (!want)
+      continue;
+    if (HotkeyInfo *cur = Find(id)) {
+      cur->callback = want->callback; // Misma combinación: sigue registrada
+    } else {
+      RegisterHotkey(id, want->modifiers, want->vk, want->callback);
+    }
+  }
+}
+
 void HotkeyManager::ProcessHotkey(int id) {
-  auto it = hotkeys.find(id);
-  if (it == hotkeys.end()) {
+  const HotkeyInfo *info = Find(id);
+  if (!info) {
     LOG_WARNING(std::string("Hotkey ID ") + std::to_string(id) +
                 " no encontrado");
     return;
   }
+  // Un WM_HOTKEY ya encolado cuando el perfil lo suspendió
+  if (info->suspended)
+    return;
 
-  if (it->second.callback) {
-    try {
-      it->second.callback(id);
-    } catch (const std::exception &e) {
-      LOG_ERROR(std::string("Excepcion en callback de hotkey ID ") +
-                std::to_string(id) + ": " + e.what());
-    } catch (...) {
-      LOG_ERROR(std::string("Excepcion desconocida en callback de hotkey ID ") +
-                std::to_string(id));
+  // Con una secuencia en curso, un hotkey propio la continúa si encaja en
+  // el trie; si no, la cancela y se ejecuta normalmente
+  if (seqNode >= 0 && id < HK_SEQUENCE_BASE) {
+    KeymapTrie::Combo combo = KeymapTrie::MakeCombo(info->modifiers, info->vk);
+    if (keymap.Step(seqNode, combo) >= 0) {
+      AdvanceSequence(combo);
+      return;
     }
+    EndSequence();
+  }
+
+  // Copia: el callback de un paso de secuencia libera su propia entrada
+  HotkeyCallback callback = info->callback;
+  if (callback) {
+    InvokeCallback(callback, id);
   }
 }
 
-bool HotkeyManager::IsRegistered(int id) const {
-  return hotkeys.find(id) != hotkeys.end();
+int HotkeyManager::SetSequences(const std::vector<Sequence> &sequences) {
+  EndSequence();
+  keymap.Clear();
+  sequenceActions.clear();
+
+  int accepted = 0;
+  std::vector<KeymapTrie::Combo> combos;
+  for (const Sequence &seq : sequences) {
+    if (!ParseSequenceString(seq.keys, combos) || combos.size() < 2) {
+      LOG_ERROR(std::string("Formato de secuencia invalido: ") + seq.keys);
+      continue;
+    }
+    if (!keymap.Add(combos, (int)sequenceActions.size())) {
+      LOG_WARNING(std::string("Secuencia repetida o prefijo de otra: ") +
+                  seq.keys);
+      continue;
+    }
+    sequenceActions.push_back({seq.actionId, seq.callback});
+    ++accepted;
+  }
+  keymap.Compile();
+
+  // Los líderes son los hijos de la raíz; solo ellos son hotkeys globales
+  std::vector<Binding> leaders;
+  int leaderCount = keymap.ChildCount(KeymapTrie::ROOT);
+  if (leaderCount > LEADER_COUNT) {
+    LOG_WARNING("Demasiados lideres de secuencia; se ignoran los ultimos");
+    leaderCount = LEADER_COUNT;
+  }
+  for (int i = 0; i < leaderCount; ++i) {
+    KeymapTrie::Combo combo = keymap.ChildKey(KeymapTrie::ROOT, i);
+    leaderCombos[i] = combo;
+    leaders.push_back({HK_LEADER_BASE + i, KeymapTrie::ComboModifiers(combo),
+                       KeymapTrie::ComboVk(combo), [this](int id) {
+                         seqNode = KeymapTrie::ROOT;
+                         AdvanceSequence(leaderCombos[id - HK_LEADER_BASE]);
+                       }});
+  }
+  SyncRange(HK_LEADER_BASE, HK_LEADER_BASE + LEADER_COUNT, leaders);
+  return accepted;
+}
+
+void HotkeyManager::AdvanceSequence(KeymapTrie::Combo combo) {
+  int next = keymap.Step(seqNode, combo);
+  ReleaseSequenceKeys();
+  if (next < 0) {
+    EndSequence(); // Tecla que no sigue ninguna secuencia (o Esc)
+    return;
+  }
+
+  int action = keymap.Action(next);
+  if (action >= 0) {
+    EndSequence();
+    SequenceAction done = sequenceActions[action];
+    if (done.callback) {
+      InvokeCallback(done.callback, done.actionId);
+    }
+    return;
+  }
+
+  seqNode = next;
+  ArmSequenceStep();
+}
+
+void HotkeyManager::ArmSequenceStep() {
+  int children = keymap.ChildCount(seqNode);
+  KeymapTrie::Combo escape = KeymapTrie::MakeCombo(0, VK_ESCAPE);
+  bool escapeContinues = keymap.Step(seqNode, escape) >= 0;
+
+  stepCount = 0;
+  for (int i = 0; i <= children && stepCount < STEP_COUNT; ++i) {
+    // Tras los pasos posibles, Esc para cancelar
+    if (i == children && escapeContinues)
+      break;
+    KeymapTrie::Combo combo =
+        i < children ? keymap.ChildKey(seqNode, i) : escape;
+    UINT modifiers = KeymapTrie::ComboModifiers(combo);
+    UINT vk = KeymapTrie::ComboVk(combo);
+
+    // Si ya es un hotkey propio, ProcessHotkey lo encamina a la secuencia;
+    // si lo tiene otra app, ese paso no se puede capturar
+    if (HasConflict(modifiers, vk))
+      continue;
+    int id = HK_SEQUENCE_BASE + stepCount;
+    if (!backend->RegisterSystemHotkey(messageWindow, id, modifiers, vk))
+      continue;
+
+    HotkeyInfo &info = hotkeys[id - MIN_ID];
+    info.modifiers = modifiers;
+    info.vk = vk;
+    info.registered = true;
+    info.callback = [this](int id) {
+      AdvanceSequence(stepCombos[id - HK_SEQUENCE_BASE]);
+    };
+    stepCombos[stepCount++] = combo;
+    ++count;
+  }
+
+  seqTimer = backend->StartTimer(
+      messageWindow, seqTimer ? seqTimer : SEQUENCE_TIMER_ID,
+      (UINT)sequenceTimeoutMs);
+}
+
+void HotkeyManager::ReleaseSequenceKeys() {
+  for (int i = 0; i < stepCount; ++i) {
+    int id = HK_SEQUENCE_BASE + i;
+    backend->UnregisterSystemHotkey(messageWindow, id);
+    hotkeys[id - MIN_ID] = HotkeyInfo();
+    --count;
+  }
+  stepCount = 0;
+}
+
+void HotkeyManager::EndSequence() {
+  ReleaseSequenceKeys();
+  if (seqTimer) {
+    backend->StopTimer(messageWindow, seqTimer);
+    seqTimer = 0;
+  }
+  seqNode = -1;
+}
+
+bool HotkeyManager::ProcessTimer(UINT_PTR timerId) {
+  if (!seqTimer || timerId != seqTimer)
+    return false;
+  LOG_DEBUG("Secuencia de teclas cancelada por timeout");
+  EndSequence();
+  return true;
+}
+
+bool HotkeyManager::IsRegistered(int id) const { return Find(id) != nullptr; }
+
+bool HotkeyManager::IsSuspended(int id) const {
+  const HotkeyInfo *info = Find(id);
+  return info && info->suspended;
+}
+
+bool HotkeyManager::EnabledByProfile(int id) const {
+  return !profile || profile->HotkeyEnabled(id);
+}
+
+void HotkeyManager::SetProfile(const KeymapProfile *newProfile) {
+  if (newProfile == profile)
+    return;
+  profile = newProfile;
+  // El foco cambió de app: una secuencia a medias ya no tiene sentido
+  EndSequence();
+
+  // Solo los IDs cuyo estado cambia tocan el sistema; los pasos temporales
+  // de secuencia no dependen del perfil
+  for (int id = MIN_ID; id < HK_SEQUENCE_BASE; ++id) {
+    HotkeyInfo &info = hotkeys[id - MIN_ID];
+    if (!info.registered)
+      continue;
+    bool enabled = EnabledByProfile(id);
+    if (enabled != info.suspended)
+      continue;
+    if (!enabled) {
+      backend->UnregisterSystemHotkey(messageWindow, id);
+    } else if (!backend->RegisterSystemHotkey(messageWindow, id,
+                                              info.modifiers, info.vk)) {
+      // Otra app la tomó mientras estaba suspendido: sigue suspendido
+      LOG_WARNING(std::string("No se pudo reactivar el hotkey ID ") +
+                  std::to_string(id));
+      continue;
+    }
+    info.suspended = !enabled;
+  }
 }
 
 std::vector<int> HotkeyManager::GetRegisteredIds() const {
   std::vector<int> ids;
-  for (const auto &pair : hotkeys) {
-    ids.push_back(pair.first);
+  ids.reserve(count);
+  for (int id = MIN_ID; id < MAX_ID && (int)ids.size() < count; ++id) {
+    if (hotkeys[id - MIN_ID].registered) {
+      ids.push_back(id);
+    }
   }
   return ids;
 }
 
 std::string HotkeyManager::GetHotkeyString(int id) const {
-  auto it = hotkeys.find(id);
-  if (it == hotkeys.end()) {
+  const HotkeyInfo *info = Find(id);
+  if (!info) {
     return "";
   }
 
-  return ModifiersToString(it->second.modifiers) + "+" +
-         VkToString(it->second.vk);
+  return ModifiersToString(info->modifiers) + "+" + VkToString(info->vk);
 }
 
 std::string HotkeyManager::ModifiersToString(UINT modifiers) {
@@ -291,11 +557,21 @@ bool HotkeyManager::ParseHotkeyString(const std::string &str, UINT &modifiers,
   return vk != 0;
 }
 
-bool HotkeyManager::HasConflict(UINT modifiers, UINT vk) const {
-  for (const auto &pair : hotkeys) {
-    if (pair.second.modifiers == modifiers && pair.second.vk == vk) {
-      return true;
+bool HotkeyManager::ParseSequenceString(const std::string &str,
+                                        std::vector<KeymapTrie::Combo> &out) {
+  out.clear();
+  std::istringstream iss(str);
+  std::string step;
+  while (std::getline(iss, step, ',')) {
+    UINT modifiers, vk;
+    if (!ParseHotkeyString(step, modifiers, vk)) {
+      return false;
     }
+    out.push_back(KeymapTrie::MakeCombo(modifiers, vk));
   }
-  return false;
+  return !out.empty();
+}
+
+bool HotkeyManager::HasConflict(UINT modifiers, UINT vk) const {
+  return comboOwner[ComboIndex(modifiers, vk)] != 0;
 }
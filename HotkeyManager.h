@@ -1,11 +1,13 @@
 #ifndef HOTKEY_MANAGER_H
 #define HOTKEY_MANAGER_H
 
-#include <functional>
-#include <map>
+#include "DesktopBackend.h"
+#include "InlineCallback.h"
+#include "KeymapTrie.h"
 #include <string>
 #include <vector>
-#include <windows.h>
+
+struct KeymapProfile;
 
 /**
  * @brief Gestor centralizado de hotkeys para WinVen
@@ -16,6 +18,22 @@
  * - Registro/desregistro automático
  * - Validación de conflictos
  * - Conversión string <-> hotkey ("Ctrl+Shift+A")
+ *
+ * Los IDs son densos (100-399), así que la tabla es un vector plano indexado
+ * por id - MIN_ID y los callbacks van en línea (InlineCallback): despachar un
+ * WM_HOTKEY es un acceso a array y una llamada indirecta, sin reservar
+ * memoria. Los conflictos se comprueban con un índice directo por
+ * (modificadores, tecla).
+ *
+ * Secuencias ("Ctrl+Alt+Space, W, 3"): solo el líder se registra de forma
+ * global. Al pulsarlo se registran temporalmente las teclas que pueden
+ * seguir (más Esc) y un timeout; cada paso avanza por un KeymapTrie y al
+ * completar la secuencia, fallar o vencer el timeout se liberan.
+ *
+ * Perfiles de teclado: los atajos que el perfil activo desactiva siguen en
+ * la tabla (combinación y callback) pero se desregistran del sistema, así
+ * que la combinación le llega a la app en primer plano. SetProfile() solo
+ * registra o desregistra los IDs cuyo estado cambia entre un perfil y otro.
  */
 class HotkeyManager {
 public:
@@ -26,6 +44,14 @@ public:
     HK_NAV_RIGHT = 101,
     HK_NAV_UP = 102,
     HK_NAV_DOWN = 103,
+    HK_FOCUS_LEFT = 104, // Foco por posición en pantalla
+    HK_FOCUS_RIGHT = 105,
+    HK_FOCUS_UP = 106,
+    HK_FOCUS_DOWN = 107,
+    HK_SWAP_LEFT = 108, // Intercambio con la vecina en pantalla
+    HK_SWAP_RIGHT = 109,
+    HK_SWAP_UP = 110,
+    HK_SWAP_DOWN = 111,
 
     // Window Management (120-139)
     HK_CYCLE_25 = 120,
@@ -33,23 +59,34 @@ public:
     HK_ARRANGE_ALL = 122,
     HK_SAFE_CLOSE = 123,
     HK_TRANSPARENCY = 124,
+    HK_REDO_POS = 125,
 
     // System (140-159)
     HK_OPEN_CONFIG = 140,
     HK_GAME_MODE = 141,
 
+    // Líderes de secuencias (160-199) - Dinámico
+    HK_LEADER_BASE = 160,
+
     // Layouts (200-299) - Dinámico
     HK_LAYOUT_BASE = 200,
 
     // Apps (300-399) - Dinámico
-    HK_APP_BASE = 300
+    HK_APP_BASE = 300,
+
+    // Pasos de una secuencia en curso (400-499) - Temporales
+    HK_SEQUENCE_BASE = 400
   };
 
+  // Rango de IDs que cubre la tabla [MIN_ID, MAX_ID)
+  static const int MIN_ID = 100;
+  static const int MAX_ID = 500;
+
   // Callback type
-  using HotkeyCallback = std::function<void(int id)>;
+  using HotkeyCallback = InlineCallback;
 
   // Constructor/Destructor
-  HotkeyManager();
+  HotkeyManager(DesktopBackend *backend = DesktopBackend::Native());
   ~HotkeyManager();
 
   // Configuración
@@ -62,8 +99,43 @@ public:
   bool UnregisterHotkey(int id);
   void UnregisterAll();
 
+  // Binding deseado para SyncRange
+  struct Binding {
+    int id;
+    UINT modifiers;
+    UINT vk;
+    HotkeyCallback callback;
+  };
+
+  // Deja el rango [firstId, lastId) igual que bindings tocando solo lo que
+  // cambia: se desregistran los IDs quitados o con otra combinación y se
+  // registran los nuevos; los que no cambian siguen vivos (solo se actualiza
+  // su callback), así que nunca hay un instante en que dejen de funcionar
+  void SyncRange(int firstId, int lastId, const std::vector<Binding> &bindings);
+
+  // Cambia el perfil en vigor (nullptr = todo activo). Los atajos que el
+  // perfil desactiva quedan suspendidos: fuera del sistema pero recordados
+  // para volver a registrarlos cuando otro perfil los permita
+  void SetProfile(const KeymapProfile *profile);
+  bool IsSuspended(int id) const;
+
+  // Secuencia de teclas: callback(actionId) al completarla
+  struct Sequence {
+    std::string keys; // "Ctrl+Alt+Space, W, 3"
+    int actionId;
+    HotkeyCallback callback;
+  };
+
+  // Sustituye todas las secuencias (los líderes sin cambios siguen vivos).
+  // Devuelve cuántas se aceptaron
+  int SetSequences(const std::vector<Sequence> &sequences);
+  void SetSequenceTimeout(int ms) { sequenceTimeoutMs = ms; }
+  bool IsSequencePending() const { return seqNode >= 0; }
+
   // Procesamiento
   void ProcessHotkey(int id);
+  // WM_TIMER: devuelve true si era el timeout de la secuencia en curso
+  bool ProcessTimer(UINT_PTR timerId);
 
   // Estado
   bool IsRegistered(int id) const;
@@ -75,21 +147,58 @@ public:
   static std::string VkToString(UINT vk);
   static bool ParseHotkeyString(const std::string &str, UINT &modifiers,
                                 UINT &vk);
+  static bool ParseSequenceString(const std::string &str,
+                                  std::vector<KeymapTrie::Combo> &out);
 
   // Validación
   bool HasConflict(UINT modifiers, UINT vk) const;
 
 private:
   struct HotkeyInfo {
-    int id;
     UINT modifiers;
     UINT vk;
     HotkeyCallback callback;
     bool registered;
+    bool suspended; // En la tabla pero no en el sistema (perfil)
   };
 
+  // Índice de conflictos: 4 bits de modificadores x 256 teclas
+  static const int COMBO_COUNT = 16 * 256;
+
+  DesktopBackend *backend;
   HWND messageWindow;
-  std::map<int, HotkeyInfo> hotkeys;
+  std::vector<HotkeyInfo> hotkeys; // [id - MIN_ID]
+  std::vector<short> comboOwner;   // [ComboIndex] -> id, 0 = libre
+  int count;
+  const KeymapProfile *profile;
+
+  bool EnabledByProfile(int id) const;
+  static int ComboIndex(UINT modifiers, UINT vk);
+  HotkeyInfo *Find(int id);
+  const HotkeyInfo *Find(int id) const;
+
+  // Secuencias
+  struct SequenceAction {
+    int actionId;
+    HotkeyCallback callback;
+  };
+  static const int LEADER_COUNT = 40;
+  static const int STEP_COUNT = 100;
+  static const UINT_PTR SEQUENCE_TIMER_ID = 0x5E9;
+
+  KeymapTrie keymap;
+  std::vector<SequenceAction> sequenceActions; // [acción del trie]
+  KeymapTrie::Combo leaderCombos[LEADER_COUNT];
+  KeymapTrie::Combo stepCombos[STEP_COUNT];
+  int stepCount;
+  int seqNode; // Nodo del trie en curso, -1 sin secuencia
+  UINT_PTR seqTimer;
+  int sequenceTimeoutMs;
+
+  void AdvanceSequence(KeymapTrie::Combo combo);
+  void ArmSequenceStep();
+  void ReleaseSequenceKeys();
+  void EndSequence();
 
   // Helpers
   std::string GetHotkeyDescription(int id) const;
@@ -0,0 +1,50 @@
+#ifndef INLINE_CALLBACK_H
+#define INLINE_CALLBACK_H
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief Callable void(int) guardado en línea, sin memoria dinámica
+ *
+ * Sustituye a std::function en tablas que se recorren en caliente: el
+ * callable (normalmente una lambda con capturas por referencia y algún
+ * índice) se copia dentro de un buffer fijo y se invoca a través de un
+ * único puntero a función. Si no cabe, o no es trivialmente copiable, el
+ * fallo es de compilación, nunca una reserva en tiempo de ejecución.
+ */
+class InlineCallback {
+public:
+  static const size_t CAPACITY = 6 * sizeof(void *);
+
+  InlineCallback() : invoke(nullptr) {}
+
+  template <typename F,
+            typename = typename std::enable_if<!std::is_same<
+                typename std::decay<F>::type, InlineCallback>::value>::type>
+  InlineCallback(F f) {
+    typedef typename std::decay<F>::type Fn;
+    static_assert(sizeof(Fn) <= CAPACITY,
+                  "Callback demasiado grande para InlineCallback");
+    static_assert(alignof(Fn) <= alignof(void *),
+                  "Alineación no soportada por InlineCallback");
+    static_assert(std::is_trivially_copyable<Fn>::value &&
+                      std::is_trivially_destructible<Fn>::value,
+                  "InlineCallback solo admite callables trivialmente "
+                  "copiables (capturas por referencia o por valor simple)");
+    new (storage) Fn(f);
+    invoke = [](const void *self, int id) {
+      (*static_cast<const Fn *>(self))(id);
+    };
+  }
+
+  void operator()(int id) const { invoke(storage, id); }
+  explicit operator bool() const { return invoke != nullptr; }
+
+private:
+  alignas(void *) unsigned char storage[CAPACITY];
+  void (*invoke)(const void *, int);
+};
+
+#endif // INLINE_CALLBACK_H
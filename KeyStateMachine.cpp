@@ -0,0 +1,107 @@
+#include "KeyStateMachine.h"
+
+int KeyStateMachine::KeyFromVk(UINT vk) {
+  switch (vk) {
+  case VK_CONTROL:
+  case VK_LCONTROL:
+  case VK_RCONTROL:
+    return K_CTRL;
+  case VK_MENU:
+  case VK_LMENU:
+  case VK_RMENU:
+    return K_ALT;
+  case VK_SHIFT:
+  case VK_LSHIFT:
+  case VK_RSHIFT:
+    return K_SHIFT;
+  case 'W':
+    return K_W;
+  case 'A':
+    return K_A;
+  case 'S':
+    return K_S;
+  case 'D':
+    return K_D;
+  default:
+    return -1;
+  }
+}
+
+UINT KeyStateMachine::VkFromKey(int key) {
+  static const UINT vks[K_COUNT] = {VK_CONTROL, VK_MENU, VK_SHIFT, 'W',
+                                    'A',        'S',     'D'};
+  return key >= 0 && key < K_COUNT ? vks[key] : 0;
+}
+
+void KeyStateMachine::Reset() {
+  for (int i = 0; i < K_COUNT; ++i)
+    down[i] = false;
+  mode = M_IDLE;
+  dirX = 0;
+  dirY = 0;
+  stepped = false;
+  nextDue = 0.0;
+}
+
+void KeyStateMachine::Recompute(double nowMs) {
+  bool ctrl = down[K_CTRL], alt = down[K_ALT], shift = down[K_SHIFT];
+  Mode newMode = M_IDLE;
+  int x = 0, y = 0;
+
+  // Mismas combinaciones que el bucle de sondeo original
+  if (ctrl && !alt) {
+    newMode = M_MOVE;
+    if (!shift) {
+      x = (down[K_D] ? 1 : 0) - (down[K_A] ? 1 : 0);
+      y = down[K_W] ? -1 : 0;
+    } else if (down[K_S]) {
+      y = 1; // Ctrl+S sin Shift queda libre para "Guardar"
+    }
+  } else if (alt && !ctrl) {
+    newMode = shift ? M_RESIZE_INVERSE : M_RESIZE;
+    x = (down[K_D] ? 1 : 0) - (down[K_A] ? 1 : 0);
+    y = (down[K_S] ? 1 : 0) - (down[K_W] ? 1 : 0);
+  }
+
+  // Al empezar a moverse (o cambiar de modo) el primer paso es inmediato;
+  // cambiar de dirección sin soltar mantiene el ritmo de repetición
+  bool wasActive = dirX != 0 || dirY != 0;
+  if (!wasActive || newMode != mode) {
+    stepped = false;
+    nextDue = nowMs;
+  }
+  mode = newMode;
+  dirX = x;
+  dirY = y;
+}
+
+bool KeyStateMachine::OnKey(int key, bool isDown, double nowMs) {
+  if (key < 0 || key >= K_COUNT || down[key] == isDown)
+    return false; // Autorepetición del teclado: sin cambios
+  Mode oldMode = mode;
+  int oldX = dirX, oldY = dirY;
+  down[key] = isDown;
+  Recompute(nowMs);
+  return mode != oldMode || dirX != oldX || dirY != oldY;
+}
+
+bool KeyStateMachine::Poll(double nowMs, Step &step) {
+  if (mode == M_IDLE || (dirX == 0 && dirY == 0))
+    return false;
+  if (stepped && nowMs < nextDue)
+    return false;
+
+  step.mode = mode;
+  step.x = dirX;
+  step.y = dirY;
+  step.repeat = stepped;
+  nextDue = stepped ? nowMs + REPEAT_MS : nowMs + INITIAL_DELAY_MS;
+  stepped = true;
+  return true;
+}
+
+double KeyStateMachine::NextDeadline() const {
+  if (mode == M_IDLE || (dirX == 0 && dirY == 0))
+    return -1.0;
+  return nextDue;
+}
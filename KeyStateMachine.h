@@ -0,0 +1,66 @@
+#ifndef KEY_STATE_MACHINE_H
+#define KEY_STATE_MACHINE_H
+
+#include "WinCompat.h"
+
+/**
+ * @brief Máquina de estados del control continuo (Ctrl/Alt + WASD)
+ *
+ * Se alimenta con eventos de tecla pulsada / soltada (en Windows, desde un
+ * hook WH_KEYBOARD_LL) en lugar de sondear el teclado. A partir de las
+ * teclas mantenidas deduce el modo (mover, redimensionar o redimensionar
+ * invertido) y la dirección, y marca cuándo toca el siguiente paso: el
+ * primero en cuanto se pulsa, los demás cada REPEAT_MS tras INITIAL_DELAY_MS.
+ *
+ * NextDeadline() dice cuándo hay que despertar; con nada pulsado devuelve
+ * -1 y el hilo puede dormir sin timeout. No depende de Win32: se prueba con
+ * secuencias de teclas sintéticas en Linux.
+ */
+class KeyStateMachine {
+public:
+  enum Key { K_CTRL, K_ALT, K_SHIFT, K_W, K_A, K_S, K_D, K_COUNT };
+
+  enum Mode { M_IDLE, M_MOVE, M_RESIZE, M_RESIZE_INVERSE };
+
+  static const int INITIAL_DELAY_MS = 150; // Antes de repetir
+  static const int REPEAT_MS = 16;         // ~60 pasos por segundo
+
+  // Paso pendiente: dirección por eje (-1, 0, 1) en el modo actual.
+  // repeat = false en el primer paso de una pulsación (toque)
+  struct Step {
+    Mode mode;
+    int x;
+    int y;
+    bool repeat;
+  };
+
+  KeyStateMachine() { Reset(); }
+
+  // Tecla que interesa para un código virtual, o -1
+  static int KeyFromVk(UINT vk);
+  static UINT VkFromKey(int key);
+
+  // Devuelve true si cambió el modo o la dirección
+  bool OnKey(int key, bool down, double nowMs);
+  void Reset();
+
+  bool IsDown(int key) const { return down[key]; }
+  Mode CurrentMode() const { return mode; }
+
+  // Si hay un paso vencido en nowMs lo devuelve y programa el siguiente
+  bool Poll(double nowMs, Step &step);
+  // Instante del próximo paso, o -1 si no hay nada pendiente
+  double NextDeadline() const;
+
+private:
+  bool down[K_COUNT];
+  Mode mode;
+  int dirX;
+  int dirY;
+  bool stepped;   // Ya se dio el primer paso de esta pulsación
+  double nextDue; // Siguiente paso (válido si stepped)
+
+  void Recompute(double nowMs);
+};
+
+#endif // KEY_STATE_MACHINE_H
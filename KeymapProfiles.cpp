@@ -0,0 +1,107 @@
+#include "KeymapProfiles.h"
+#include "HotkeyManager.h"
+#include <sstream>
+
+KeymapProfiles::KeymapProfiles() : active(nullptr) {
+  Compile(std::vector<Spec>(), HotkeyManager::MIN_ID, HotkeyManager::MAX_ID);
+}
+
+void KeymapProfiles::Compile(const std::vector<Spec> &specs, int firstId,
+                             int lastId) {
+  for (auto &profile : profiles)
+    retired.push_back(std::move(profile));
+  profiles.clear();
+  matchers.clear();
+  needsClass = false;
+  needsTitle = false;
+
+  std::unique_ptr<KeymapProfile> fallback(new KeymapProfile());
+  fallback->name = "default";
+  fallback->firstId = firstId;
+  fallback->hotkeyEnabled.assign(lastId - firstId, 1);
+  profiles.push_back(std::move(fallback));
+
+  for (const Spec &spec : specs) {
+    std::unique_ptr<KeymapProfile> profile(new KeymapProfile());
+    profile->name = spec.name;
+    profile->continuousMove = spec.continuousMove;
+    profile->continuousResize = spec.continuousResize;
+    profile->firstId = firstId;
+    profile->hotkeyEnabled.assign(lastId - firstId, 1);
+    for (const auto &range : spec.disabledIds) {
+      for (int id = range.first; id < range.second; ++id) {
+        if (id >= firstId && id < lastId)
+          profile->hotkeyEnabled[id - firstId] = 0;
+      }
+    }
+
+    AppMatcher matcher;
+    matcher.Compile(spec.rules);
+    needsClass = needsClass || matcher.NeedsClass();
+    needsTitle = needsTitle || matcher.NeedsTitle();
+    matchers.push_back(std::move(matcher));
+    profiles.push_back(std::move(profile));
+  }
+
+  active.store(profiles[0].get(), std::memory_order_release);
+}
+
+const KeymapProfile *KeymapProfiles::Select(const std::string &exeLower,
+                                            const std::string *className,
+                                            const std::string *title) const {
+  for (size_t i = 0; i < matchers.size(); ++i) {
+    if (matchers[i].Matches(exeLower, className, title))
+      return profiles[i + 1].get();
+  }
+  return profiles[0].get();
+}
+
+static std::string TrimSpaces(const std::string &s) {
+  size_t first = s.find_first_not_of(" \t");
+  if (first == std::string::npos)
+    return "";
+  return s.substr(first, s.find_last_not_of(" \t") - first + 1);
+}
+
+bool KeymapProfiles::ParseSpec(const std::string &name,
+                               const std::string &match,
+                               const std::string &disable, Spec &out) {
+  out = Spec();
+  out.name = name;
+
+  std::istringstream rules(match);
+  std::string item;
+  while (std::getline(rules, item, ',')) {
+    item = TrimSpaces(item);
+    if (!item.empty())
+      out.rules.push_back(item);
+  }
+  if (out.rules.empty())
+    return false;
+
+  std::istringstream groups(disable);
+  while (std::getline(groups, item, ',')) {
+    item = AppMatcher::ToLower(TrimSpaces(item));
+    if (item.empty())
+      continue;
+    if (item == "move")
+      out.continuousMove = false;
+    else if (item == "resize")
+      out.continuousResize = false;
+    else if (item == "nav")
+      out.disabledIds.push_back({HotkeyManager::HK_NAV_LEFT, 120});
+    else if (item == "windows")
+      out.disabledIds.push_back({HotkeyManager::HK_CYCLE_25, 140});
+    else if (item == "sequences")
+      out.disabledIds.push_back({HotkeyManager::HK_LEADER_BASE, 200});
+    else if (item == "layouts")
+      out.disabledIds.push_back(
+          {HotkeyManager::HK_LAYOUT_BASE, HotkeyManager::HK_APP_BASE});
+    else if (item == "apps")
+      out.disabledIds.push_back(
+          {HotkeyManager::HK_APP_BASE, HotkeyManager::HK_APP_BASE + 100});
+    else
+      return false; // Grupo desconocido
+  }
+  return true;
+}
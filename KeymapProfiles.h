@@ -0,0 +1,88 @@
+#ifndef KEYMAP_PROFILES_H
+#define KEYMAP_PROFILES_H
+
+#include "AppMatcher.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Perfil de teclado compilado: qué atajos actúan mientras cierta app está en
+// primer plano
+struct KeymapProfile {
+  std::string name;
+  bool continuousMove = true;   // Ctrl + WASD
+  bool continuousResize = true; // Alt + WASD
+  int firstId = 0;
+  std::vector<unsigned char> hotkeyEnabled; // [id - firstId]
+
+  bool HotkeyEnabled(int id) const {
+    int i = id - firstId;
+    return i < 0 || i >= (int)hotkeyEnabled.size() || hotkeyEnabled[i];
+  }
+};
+
+/**
+ * @brief Perfiles de teclado por aplicación
+ *
+ * Cada perfil se elige por el ejecutable, la clase o el título de la ventana
+ * en primer plano (mismas reglas que AppMatcher) y se compila de antemano en
+ * su propia tabla de atajos activos. Al cambiar el foco, Select() busca el
+ * primer perfil que encaja y Activate() publica su puntero con un store
+ * atómico. HotkeyManager::SetProfile() desregistra entonces solo los
+ * atajos que cambian de estado, para que la combinación le llegue a la app.
+ * El perfil 0 ("default") lo permite todo y se usa si ninguno encaja.
+ *
+ * Active() se lee desde cualquier hilo (el hilo de control continuo
+ * incluido). Los perfiles de una compilación anterior no se liberan, así
+ * que un puntero leído justo antes de recompilar sigue siendo válido.
+ */
+class KeymapProfiles {
+public:
+  struct Spec {
+    std::string name;
+    std::vector<std::string> rules; // Reglas de AppMatcher
+    bool continuousMove = true;
+    bool continuousResize = true;
+    std::vector<std::pair<int, int>> disabledIds; // Rangos [primero, último)
+  };
+
+  KeymapProfiles();
+
+  // Compila los perfiles; la tabla de cada uno cubre los IDs [firstId,
+  // lastId). Deja activo el perfil por defecto
+  void Compile(const std::vector<Spec> &specs, int firstId, int lastId);
+
+  // Spec a partir del texto de configuración: reglas separadas por comas y
+  // grupos a desactivar ("move, resize, nav, windows, layouts, apps,
+  // sequences")
+  static bool ParseSpec(const std::string &name, const std::string &match,
+                        const std::string &disable, Spec &out);
+
+  bool Empty() const { return profiles.size() <= 1; }
+  bool NeedsClass() const { return needsClass; }
+  bool NeedsTitle() const { return needsTitle; }
+
+  // Primer perfil cuyas reglas encajan (exeLower en minúsculas)
+  const KeymapProfile *Select(const std::string &exeLower,
+                              const std::string *className,
+                              const std::string *title) const;
+
+  const KeymapProfile *Active() const {
+    return active.load(std::memory_order_acquire);
+  }
+  // Devuelve true si cambió el perfil en vigor
+  bool Activate(const KeymapProfile *profile) {
+    return active.exchange(profile, std::memory_order_acq_rel) != profile;
+  }
+
+private:
+  std::vector<std::unique_ptr<KeymapProfile>> profiles; // [0] = por defecto
+  std::vector<AppMatcher> matchers; // [i] elige profiles[i + 1]
+  std::vector<std::unique_ptr<KeymapProfile>> retired;
+  std::atomic<const KeymapProfile *> active;
+  bool needsClass = false;
+  bool needsTitle = false;
+};
+
+#endif // KEYMAP_PROFILES_H
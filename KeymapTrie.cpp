@@ -0,0 +1,76 @@
+#include "KeymapTrie.h"
+#include <algorithm>
+
+void KeymapTrie::Clear() {
+  building.assign(1, std::vector<std::pair<Combo, int>>());
+  actions.assign(1, -1);
+  nodeFirst.assign(1, 0);
+  nodeCount.assign(1, 0);
+  edgeKeys.clear();
+  edgeTargets.clear();
+}
+
+bool KeymapTrie::Add(const std::vector<Combo> &sequence, int action) {
+  if (sequence.empty())
+    return false;
+
+  // Comprobar antes de tocar nada: sin prefijos ni duplicados
+  int node = ROOT;
+  size_t i = 0;
+  for (; i < sequence.size(); ++i) {
+    int next = -1;
+    for (const auto &edge : building[node]) {
+      if (edge.first == sequence[i]) {
+        next = edge.second;
+        break;
+      }
+    }
+    if (next < 0)
+      break;
+    node = next;
+    if (actions[node] >= 0)
+      return false; // Una secuencia ya registrada es prefijo de esta
+  }
+  if (i == sequence.size())
+    return false; // Repetida o prefijo de otra más larga
+
+  for (; i < sequence.size(); ++i) {
+    int child = (int)building.size();
+    building.push_back(std::vector<std::pair<Combo, int>>());
+    actions.push_back(-1);
+    building[node].push_back(std::make_pair(sequence[i], child));
+    node = child;
+  }
+  actions[node] = action;
+  return true;
+}
+
+void KeymapTrie::Compile() {
+  int nodes = (int)building.size();
+  nodeFirst.assign(nodes, 0);
+  nodeCount.assign(nodes, 0);
+  edgeKeys.clear();
+  edgeTargets.clear();
+
+  for (int n = 0; n < nodes; ++n) {
+    std::vector<std::pair<Combo, int>> &edges = building[n];
+    std::sort(edges.begin(), edges.end());
+    nodeFirst[n] = (int)edgeKeys.size();
+    nodeCount[n] = (int)edges.size();
+    for (const auto &edge : edges) {
+      edgeKeys.push_back(edge.first);
+      edgeTargets.push_back(edge.second);
+    }
+  }
+}
+
+int KeymapTrie::Step(int node, Combo c) const {
+  if (node < 0 || node >= (int)nodeCount.size())
+    return -1;
+  const Combo *first = edgeKeys.data() + nodeFirst[node];
+  const Combo *last = first + nodeCount[node];
+  const Combo *it = std::lower_bound(first, last, c);
+  if (it == last || *it != c)
+    return -1;
+  return edgeTargets[it - edgeKeys.data()];
+}
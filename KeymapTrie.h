@@ -0,0 +1,64 @@
+#ifndef KEYMAP_TRIE_H
+#define KEYMAP_TRIE_H
+
+#include "WinCompat.h"
+#include <vector>
+
+/**
+ * @brief Trie compilado de secuencias de teclas ("Ctrl+Alt+Space, W, 3")
+ *
+ * Cada paso de una secuencia es una combinación (modificadores + tecla)
+ * empaquetada en 12 bits. Add() construye el árbol y Compile() lo aplana en
+ * arrays contiguos: los hijos de cada nodo quedan ordenados en un rango de
+ * edgeKeys/edgeTargets, así que Step() es una búsqueda binaria en ese rango
+ * y reconocer una secuencia cuesta O(longitud) sin reservar memoria.
+ *
+ * Las secuencias no pueden ser prefijo unas de otras: al llegar a una hoja
+ * la acción se dispara sin esperar, y el timeout solo cancela.
+ */
+class KeymapTrie {
+public:
+  typedef unsigned short Combo; // (modificadores & 0xF) << 8 | vk
+
+  static Combo MakeCombo(UINT modifiers, UINT vk) {
+    return (Combo)(((modifiers & 0xF) << 8) | (vk & 0xFF));
+  }
+  static UINT ComboModifiers(Combo c) { return c >> 8; }
+  static UINT ComboVk(Combo c) { return c & 0xFF; }
+
+  KeymapTrie() { Clear(); }
+
+  void Clear();
+  // Devuelve false si la secuencia está vacía, repetida o es prefijo de otra
+  // (o al revés)
+  bool Add(const std::vector<Combo> &sequence, int action);
+  void Compile();
+
+  static const int ROOT = 0;
+
+  // Nodo al que lleva la combinación c desde node, o -1
+  int Step(int node, Combo c) const;
+  // Acción de una hoja, -1 en nodos intermedios
+  int Action(int node) const { return actions[node]; }
+
+  // Combinaciones que continúan la secuencia desde node
+  int ChildCount(int node) const { return nodeCount[node]; }
+  Combo ChildKey(int node, int i) const {
+    return edgeKeys[nodeFirst[node] + i];
+  }
+
+  int NodeCount() const { return (int)actions.size(); }
+
+private:
+  // Construcción: hijos sin ordenar por nodo
+  std::vector<std::vector<std::pair<Combo, int>>> building;
+
+  // Forma compilada (CSR)
+  std::vector<int> actions;
+  std::vector<int> nodeFirst;
+  std::vector<int> nodeCount;
+  std::vector<Combo> edgeKeys;
+  std::vector<int> edgeTargets;
+};
+
+#endif // KEYMAP_TRIE_H
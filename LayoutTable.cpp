@@ -0,0 +1,69 @@
+#include "LayoutTable.h"
+#include "WindowManager.h"
+
+PixelRect LayoutTable::Compute(const RECT &workArea,
+                               const WindowLayout &layout, int margin) {
+  int screenW = workArea.right - workArea.left;
+  int screenH = workArea.bottom - workArea.top;
+
+  int baseX = workArea.left + (int)(screenW * layout.x);
+  int baseY = workArea.top + (int)(screenH * layout.y);
+  int baseW = (int)(screenW * layout.width);
+  int baseH = (int)(screenH * layout.height);
+
+  PixelRect r;
+  r.x = baseX + margin;
+  r.y = baseY + margin;
+  r.w = baseW - (margin * 2);
+  r.h = baseH - (margin * 2);
+
+  if (r.w < 100)
+    r.w = 100;
+  if (r.h < 100)
+    r.h = 100;
+  return r;
+}
+
+void LayoutTable::Rebuild(const std::vector<MonitorDesc> &monitors,
+                          const std::vector<WindowLayout> &layouts,
+                          const std::vector<WindowLayout> &positions25,
+                          int margin) {
+  layoutCount = (int)layouts.size();
+  positionCount = (int)positions25.size();
+  monitorHandles.clear();
+  rects.clear();
+  rects.reserve(monitors.size() * (layoutCount + positionCount));
+
+  for (const MonitorDesc &mon : monitors) {
+    monitorHandles.push_back(mon.handle);
+    for (const WindowLayout &layout : layouts)
+      rects.push_back(Compute(mon.rcWork, layout, margin));
+    for (const WindowLayout &layout : positions25)
+      rects.push_back(Compute(mon.rcWork, layout, margin));
+  }
+}
+
+int LayoutTable::FindMonitor(HMONITOR monitor) const {
+  // Pocos monitores: búsqueda lineal sobre un vector contiguo
+  for (size_t i = 0; i < monitorHandles.size(); ++i) {
+    if (monitorHandles[i] == monitor)
+      return (int)i;
+  }
+  return -1;
+}
+
+const PixelRect *LayoutTable::LayoutRect(int monitor, int layoutIndex) const {
+  if (monitor < 0 || monitor >= MonitorCount() || layoutIndex < 0 ||
+      layoutIndex >= layoutCount)
+    return nullptr;
+  return &rects[monitor * (layoutCount + positionCount) + layoutIndex];
+}
+
+const PixelRect *LayoutTable::PositionRect(int monitor,
+                                           int positionIndex) const {
+  if (monitor < 0 || monitor >= MonitorCount() || positionIndex < 0 ||
+      positionIndex >= positionCount)
+    return nullptr;
+  return &rects[monitor * (layoutCount + positionCount) + layoutCount +
+                positionIndex];
+}
@@ -0,0 +1,49 @@
+#ifndef LAYOUT_TABLE_H
+#define LAYOUT_TABLE_H
+
+#include "DesktopBackend.h"
+#include <vector>
+
+struct WindowLayout;
+
+// Rectángulo final en píxeles (margen ya aplicado)
+struct PixelRect {
+  int x;
+  int y;
+  int w;
+  int h;
+};
+
+/**
+ * @brief Tabla precompilada de rectángulos por monitor
+ *
+ * Guarda, para cada monitor, el rectángulo final de cada layout y de cada
+ * una de las 25 posiciones, con el margen ya aplicado. Se reconstruye solo
+ * cuando cambia la topología de monitores, el área de trabajo o el margen;
+ * aplicar un layout pasa a ser una búsqueda en la tabla más un movimiento.
+ */
+class LayoutTable {
+public:
+  void Rebuild(const std::vector<MonitorDesc> &monitors,
+               const std::vector<WindowLayout> &layouts,
+               const std::vector<WindowLayout> &positions25, int margin);
+
+  // Índice del monitor en la tabla, -1 si no se conoce
+  int FindMonitor(HMONITOR monitor) const;
+  int MonitorCount() const { return (int)monitorHandles.size(); }
+
+  const PixelRect *LayoutRect(int monitor, int layoutIndex) const;
+  const PixelRect *PositionRect(int monitor, int positionIndex) const;
+
+  // Cálculo de un rectángulo (misma fórmula que usa la tabla)
+  static PixelRect Compute(const RECT &workArea, const WindowLayout &layout,
+                           int margin);
+
+private:
+  std::vector<HMONITOR> monitorHandles;
+  std::vector<PixelRect> rects; // [monitor][layouts..., positions25...]
+  int layoutCount = 0;
+  int positionCount = 0;
+};
+
+#endif // LAYOUT_TABLE_H
@@ -1,21 +1,18 @@
 #include "Logger.h"
+#include <chrono>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 // Inicialización de variables estáticas
 bool WinVenLogger::enabled = true;
 WinVenLogger::Level WinVenLogger::minLevel = WinVenLogger::L_INFO;
 std::string WinVenLogger::logPath = "winven.log";
-CRITICAL_SECTION WinVenLogger::cs;
-
-void WinVenLogger::Initialize() {
-  static bool initialized = false;
-  if (!initialized) {
-    InitializeCriticalSection(&cs);
-    initialized = true;
-  }
-}
+std::mutex WinVenLogger::mtx;
 
 void WinVenLogger::SetEnabled(bool enable) { enabled = enable; }
 
@@ -24,14 +21,20 @@ void WinVenLogger::SetMinLevel(Level level) { minLevel = level; }
 void WinVenLogger::SetLogFile(const std::string &path) { logPath = path; }
 
 std::string WinVenLogger::GetTimestamp() {
-  SYSTEMTIME st;
-  GetLocalTime(&st);
+  auto now = std::chrono::system_clock::now();
+  std::time_t t = std::chrono::system_clock::to_time_t(now);
+  int millis = (int)(std::chrono::duration_cast<std::chrono::milliseconds>(
+                         now.time_since_epoch())
+                         .count() %
+                     1000);
+  std::tm st = *std::localtime(&t);
 
   std::ostringstream oss;
-  oss << std::setfill('0') << std::setw(4) << st.wYear << "-" << std::setw(2)
-      << st.wMonth << "-" << std::setw(2) << st.wDay << " " << std::setw(2)
-      << st.wHour << ":" << std::setw(2) << st.wMinute << ":" << std::setw(2)
-      << st.wSecond << "." << std::setw(3) << st.wMilliseconds;
+  oss << std::setfill('0') << std::setw(4) << (st.tm_year + 1900) << "-"
+      << std::setw(2) << (st.tm_mon + 1) << "-" << std::setw(2) << st.tm_mday
+      << " " << std::setw(2) << st.tm_hour << ":" << std::setw(2)
+      << st.tm_min << ":" << std::setw(2) << st.tm_sec << "." << std::setw(3)
+      << millis;
 
   return oss.str();
 }
@@ -64,9 +67,7 @@ void WinVenLogger::Log(Level level, const std::string &message) {
     return;
   }
 
-  Initialize();
-
-  EnterCriticalSection(&cs);
+  std::lock_guard<std::mutex> lock(mtx);
 
   try {
     std::ostringstream oss;
@@ -74,14 +75,12 @@ void WinVenLogger::Log(Level level, const std::string &message) {
     WriteToFile(oss.str());
 
 // También output a OutputDebugString para debugging en Visual Studio
-#ifdef _DEBUG
+#if defined(_WIN32) && defined(_DEBUG)
     OutputDebugStringA((oss.str() + "\n").c_str());
 #endif
   } catch (...) {
     // Silenciar errores de logging para no crashear la app
   }
-
-  LeaveCriticalSection(&cs);
 }
 
 void WinVenLogger::Debug(const std::string &message) { Log(L_DEBUG, message); }
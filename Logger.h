@@ -2,8 +2,8 @@
 #define LOGGER_H
 
 #include <fstream>
+#include <mutex>
 #include <string>
-#include <windows.h>
 
 /**
  * @brief Sistema de logging ligero para WinVen
@@ -45,13 +45,12 @@ private:
   static bool enabled;
   static Level minLevel;
   static std::string logPath;
-  static CRITICAL_SECTION cs; // Thread safety
+  static std::mutex mtx; // Thread safety
 
   // Helpers
   static std::string GetTimestamp();
   static std::string LevelToString(Level level);
   static void WriteToFile(const std::string &message);
-  static void Initialize();
 };
 
 // Macros convenientes
@@ -0,0 +1,163 @@
+#include "MonitorTopology.h"
+#include <algorithm>
+
+void MonitorTopology::Rebuild(const std::vector<MonitorDesc> &list) {
+  monitors = list;
+  std::stable_sort(monitors.begin(), monitors.end(),
+                   [](const MonitorDesc &a, const MonitorDesc &b) {
+                     if (a.rcMonitor.left != b.rcMonitor.left)
+                       return a.rcMonitor.left < b.rcMonitor.left;
+                     return a.rcMonitor.top < b.rcMonitor.top;
+                   });
+
+  int n = (int)monitors.size();
+  primary = n > 0 ? 0 : -1;
+  bounds = {0, 0, 0, 0};
+  xs.clear();
+  ys.clear();
+  for (int i = 0; i < n; ++i) {
+    const RECT &m = monitors[i].rcMonitor;
+    if (monitors[i].primary)
+      primary = i;
+    if (i == 0) {
+      bounds = m;
+    } else {
+      bounds.left = std::min(bounds.left, m.left);
+      bounds.top = std::min(bounds.top, m.top);
+      bounds.right = std::max(bounds.right, m.right);
+      bounds.bottom = std::max(bounds.bottom, m.bottom);
+    }
+    xs.push_back(m.left);
+    xs.push_back(m.right);
+    ys.push_back(m.top);
+    ys.push_back(m.bottom);
+  }
+  std::sort(xs.begin(), xs.end());
+  xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+  std::sort(ys.begin(), ys.end());
+  ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+  // Cada celda cae entera dentro de un monitor o en un hueco
+  int cols = xs.empty() ? 0 : (int)xs.size() - 1;
+  int rows = ys.empty() ? 0 : (int)ys.size() - 1;
+  cells.assign((size_t)cols * rows, -1);
+  for (int i = 0; i < n; ++i) {
+    const RECT &m = monitors[i].rcMonitor;
+    int c0 = (int)(std::lower_bound(xs.begin(), xs.end(), m.left) -
+                   xs.begin());
+    int c1 = (int)(std::lower_bound(xs.begin(), xs.end(), m.right) -
+                   xs.begin());
+    int r0 = (int)(std::lower_bound(ys.begin(), ys.end(), m.top) -
+                   ys.begin());
+    int r1 = (int)(std::lower_bound(ys.begin(), ys.end(), m.bottom) -
+                   ys.begin());
+    for (int row = r0; row < r1; ++row)
+      for (int col = c0; col < c1; ++col)
+        if (cells[(size_t)row * cols + col] < 0)
+          cells[(size_t)row * cols + col] = i;
+  }
+
+  // Vecino por lado: el más próximo de los que comparten tramo de borde
+  neighbors.assign((size_t)n * 4, -1);
+  for (int i = 0; i < n; ++i) {
+    const RECT &a = monitors[i].rcMonitor;
+    for (int side = SIDE_LEFT; side <= SIDE_DOWN; ++side) {
+      bool horizontal = side == SIDE_LEFT || side == SIDE_RIGHT;
+      int best = -1;
+      LONG bestGap = 0, bestOverlap = 0;
+      for (int j = 0; j < n; ++j) {
+        if (j == i)
+          continue;
+        const RECT &b = monitors[j].rcMonitor;
+        LONG gap = side == SIDE_LEFT    ? a.left - b.right
+                   : side == SIDE_RIGHT ? b.left - a.right
+                   : side == SIDE_UP    ? a.top - b.bottom
+                                        : b.top - a.bottom;
+        LONG overlap =
+            horizontal
+                ? std::min(a.bottom, b.bottom) - std::max(a.top, b.top)
+                : std::min(a.right, b.right) - std::max(a.left, b.left);
+        if (gap < 0 || overlap <= 0)
+          continue;
+        if (best < 0 || gap < bestGap ||
+            (gap == bestGap && overlap > bestOverlap)) {
+          best = j;
+          bestGap = gap;
+          bestOverlap = overlap;
+        }
+      }
+      neighbors[(size_t)i * 4 + side] = best;
+    }
+  }
+}
+
+int MonitorTopology::IndexOf(HMONITOR monitor) const {
+  for (size_t i = 0; i < monitors.size(); ++i) {
+    if (monitors[i].handle == monitor)
+      return (int)i;
+  }
+  return -1;
+}
+
+int MonitorTopology::Nearest(POINT pt) const {
+  // Misma distancia que MONITOR_DEFAULTTONEAREST
+  int best = -1;
+  long long bestDist = -1;
+  for (size_t i = 0; i < monitors.size(); ++i) {
+    const RECT &r = monitors[i].rcMonitor;
+    long long dx = pt.x < r.left ? r.left - pt.x
+                   : pt.x >= r.right ? pt.x - r.right + 1
+                                     : 0;
+    long long dy = pt.y < r.top ? r.top - pt.y
+                   : pt.y >= r.bottom ? pt.y - r.bottom + 1
+                                      : 0;
+    long long dist = dx * dx + dy * dy;
+    if (bestDist < 0 || dist < bestDist) {
+      best = (int)i;
+      bestDist = dist;
+    }
+  }
+  return best;
+}
+
+int MonitorTopology::IndexAt(POINT pt) const {
+  if (monitors.empty())
+    return -1;
+  // Corte a la izquierda / encima del punto; fuera de la rejilla si no hay
+  int col = (int)(std::upper_bound(xs.begin(), xs.end(), pt.x) - xs.begin()) -
+            1;
+  int row = (int)(std::upper_bound(ys.begin(), ys.end(), pt.y) - ys.begin()) -
+            1;
+  int cols = (int)xs.size() - 1, rows = (int)ys.size() - 1;
+  if (col >= 0 && col < cols && row >= 0 && row < rows) {
+    int index = cells[(size_t)row * cols + col];
+    if (index >= 0)
+      return index;
+  }
+  return Nearest(pt);
+}
+
+int MonitorTopology::IndexForRect(const RECT &rect) const {
+  POINT center = {(rect.left + rect.right) / 2, (rect.top + rect.bottom) / 2};
+  return IndexAt(center);
+}
+
+int MonitorTopology::Next(int index) const {
+  int n = (int)monitors.size();
+  if (index < 0 || index >= n)
+    return -1;
+  return (index + 1) % n;
+}
+
+int MonitorTopology::Prev(int index) const {
+  int n = (int)monitors.size();
+  if (index < 0 || index >= n)
+    return -1;
+  return (index - 1 + n) % n;
+}
+
+int MonitorTopology::Neighbor(int index, Side side) const {
+  if (index < 0 || index >= (int)monitors.size())
+    return -1;
+  return neighbors[(size_t)index * 4 + side];
+}
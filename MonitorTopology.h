@@ -0,0 +1,68 @@
+#ifndef MONITOR_TOPOLOGY_H
+#define MONITOR_TOPOLOGY_H
+
+#include "LayoutTable.h"
+#include "WinCompat.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Foto de los monitores: áreas, DPI, orden y vecinos
+ *
+ * Se construye con una sola lista de monitores (un EnumDisplayMonitors) y
+ * se rehace únicamente cuando el sistema avisa de un cambio de pantallas o
+ * de área de trabajo; entre medias ninguna consulta toca el sistema.
+ *
+ * Los monitores quedan ordenados de izquierda a derecha y de arriba abajo,
+ * que es el orden de "siguiente monitor". Para buscar el monitor de un
+ * punto se cortan los bordes de todos los monitores en una rejilla
+ * irregular (a lo sumo 2m columnas y 2m filas) con el monitor de cada
+ * celda ya resuelto: la consulta son dos búsquedas binarias sobre esos
+ * cortes y una lectura, sin recorrer monitores ni depender del número de
+ * ventanas. Solo un punto fuera de todos (un hueco o fuera del escritorio)
+ * recorre la lista para dar el más cercano, como MONITOR_DEFAULTTONEAREST.
+ *
+ * Una ventana pertenece al monitor que contiene su centro. No toca el
+ * sistema, así que compila y se prueba en Linux; no es segura entre hilos.
+ */
+class MonitorTopology {
+public:
+  enum Side { SIDE_LEFT, SIDE_RIGHT, SIDE_UP, SIDE_DOWN };
+
+  void Rebuild(const std::vector<MonitorDesc> &monitors);
+
+  size_t Size() const { return monitors.size(); }
+  bool Empty() const { return monitors.empty(); }
+  const MonitorDesc &At(int index) const { return monitors[index]; }
+  const std::vector<MonitorDesc> &Monitors() const { return monitors; }
+  // Unión de todos los monitores (el escritorio virtual)
+  const RECT &Bounds() const { return bounds; }
+  int Primary() const { return primary; }
+
+  // Índices en el orden de la topología; -1 si no hay monitores
+  int IndexOf(HMONITOR monitor) const;
+  int IndexAt(POINT pt) const;
+  int IndexForRect(const RECT &rect) const;
+
+  // Siguiente y anterior dando la vuelta
+  int Next(int index) const;
+  int Prev(int index) const;
+  // Monitor pegado por ese lado; -1 si no hay ninguno
+  int Neighbor(int index, Side side) const;
+
+private:
+  std::vector<MonitorDesc> monitors;
+  std::vector<int> neighbors; // 4 por monitor, en el orden de Side
+  RECT bounds = {0, 0, 0, 0};
+  int primary = -1;
+
+  // Rejilla de cortes: celda (col, row) = [xs[col], xs[col + 1]) x
+  // [ys[row], ys[row + 1]); cells guarda el monitor o -1 si es un hueco
+  std::vector<LONG> xs;
+  std::vector<LONG> ys;
+  std::vector<int> cells;
+
+  int Nearest(POINT pt) const;
+};
+
+#endif // MONITOR_TOPOLOGY_H
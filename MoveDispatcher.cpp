@@ -0,0 +1,234 @@
+#include "MoveDispatcher.h"
+#include "Logger.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+typedef std::chrono::steady_clock Clock;
+
+// Movimientos de un proceso dentro de un lote, en orden, uno a uno o en una
+// sola llamada (batch)
+struct MoveDispatcher::Job {
+  DWORD pid;
+  bool batch = false;
+  std::vector<WindowPos> moves;
+  size_t current = 0;   // Movimiento en curso (o el siguiente)
+  bool started = false; // Hay un SetPos de moves[current] en marcha
+  Clock::time_point since;
+  int applied = 0;
+  bool finished = false;
+  bool abandoned = false; // Venció el plazo; el hilo quedó atascado
+};
+
+struct MoveDispatcher::Shared {
+  DesktopBackend *backend;
+  std::mutex mtx;
+  std::condition_variable work;     // Hay trabajos en la cola
+  std::condition_variable progress; // Un SetPos empezó o un trabajo acabó
+  std::deque<std::shared_ptr<Job>> queue;
+  std::set<DWORD> stuckPids; // Procesos con un hilo aún dentro de SetPos
+  std::unordered_map<HWND, DWORD> unresponsive; // -> fin del enfriamiento
+  int timeoutMs = 250;
+  int cooldownMs = 30000;
+  bool stopping = false;
+};
+
+MoveDispatcher::MoveDispatcher(DesktopBackend *backend, int workers)
+    : shared(std::make_shared<Shared>()) {
+  shared->backend = backend;
+  if (workers < 1)
+    workers = 1;
+  std::lock_guard<std::mutex> lock(shared->mtx);
+  for (int i = 0; i < workers; ++i)
+    Spawn();
+}
+
+MoveDispatcher::~MoveDispatcher() {
+  {
+    std::lock_guard<std::mutex> lock(shared->mtx);
+    shared->stopping = true;
+    shared->queue.clear();
+  }
+  shared->work.notify_all();
+}
+
+void MoveDispatcher::Spawn() {
+  // Sin join: un hilo atascado en una app colgada no debe bloquear la
+  // salida. El estado compartido vive mientras quede algún hilo
+  std::thread(&MoveDispatcher::Run, shared).detach();
+}
+
+void MoveDispatcher::Configure(int timeoutMs, int cooldownMs) {
+  std::lock_guard<std::mutex> lock(shared->mtx);
+  shared->timeoutMs = timeoutMs > 0 ? timeoutMs : 1;
+  shared->cooldownMs = cooldownMs > 0 ? cooldownMs : 0;
+}
+
+void MoveDispatcher::Run(std::shared_ptr<Shared> s) {
+  std::unique_lock<std::mutex> lock(s->mtx);
+  for (;;) {
+    s->work.wait(lock, [&s] { return s->stopping || !s->queue.empty(); });
+    if (s->stopping)
+      return;
+    std::shared_ptr<Job> job = s->queue.front();
+    s->queue.pop_front();
+
+    if (job->batch) {
+      job->started = true;
+      job->since = Clock::now();
+      s->progress.notify_all();
+      lock.unlock();
+      s->backend->SetPosBatch(job->moves);
+      lock.lock();
+      job->started = false;
+      if (!job->abandoned)
+        job->applied = (int)job->moves.size();
+    }
+    while (!job->batch && job->current < job->moves.size()) {
+      const WindowPos m = job->moves[job->current];
+      job->started = true;
+      job->since = Clock::now();
+      s->progress.notify_all(); // El llamador arma el plazo
+      lock.unlock();
+      s->backend->SetPos(m.hwnd, m.x, m.y, m.w, m.h, m.flags);
+      lock.lock();
+      job->started = false;
+      if (job->abandoned)
+        break;
+      job->applied++;
+      job->current++;
+    }
+
+    if (job->abandoned) {
+      // Ya hay un sustituto en el pool: este hilo sobra
+      s->stuckPids.erase(job->pid);
+      return;
+    }
+    job->finished = true;
+    s->progress.notify_all();
+  }
+}
+
+MoveDispatcher::Result MoveDispatcher::Apply(
+    const std::vector<WindowPos> &moves) {
+  return Dispatch(moves, false);
+}
+
+MoveDispatcher::Result MoveDispatcher::ApplyBatch(
+    const std::vector<WindowPos> &moves) {
+  return Dispatch(moves, true);
+}
+
+MoveDispatcher::Result MoveDispatcher::Dispatch(
+    const std::vector<WindowPos> &moves, bool batch) {
+  Result result = {0, 0, 0};
+  if (moves.empty())
+    return result;
+
+  DesktopBackend *backend = shared->backend;
+  DWORD now = backend->TickCount();
+  std::vector<DWORD> pids;
+  pids.reserve(moves.size());
+  for (const WindowPos &m : moves)
+    pids.push_back(backend->GetWindowPid(m.hwnd));
+
+  std::unique_lock<std::mutex> lock(shared->mtx);
+  std::vector<std::shared_ptr<Job>> jobs;
+  std::unordered_map<DWORD, size_t> jobOf;
+  for (size_t i = 0; i < moves.size(); ++i) {
+    auto it = shared->unresponsive.find(moves[i].hwnd);
+    if (it != shared->unresponsive.end()) {
+      if ((LONG)(it->second - now) > 0) {
+        result.skipped++;
+        continue;
+      }
+      shared->unresponsive.erase(it);
+    }
+    if (shared->stuckPids.count(pids[i])) {
+      result.skipped++;
+      continue;
+    }
+    // Un trabajo por proceso también en modo batch: cada proceso recibe su
+    // propio SetPosBatch y los procesos avanzan en paralelo
+    auto jt = jobOf.find(pids[i]);
+    if (jt == jobOf.end()) {
+      jt = jobOf.emplace(pids[i], jobs.size()).first;
+      jobs.push_back(std::make_shared<Job>());
+      jobs.back()->pid = pids[i];
+      jobs.back()->batch = batch;
+    }
+    jobs[jt->second]->moves.push_back(moves[i]);
+  }
+  for (const std::shared_ptr<Job> &job : jobs)
+    shared->queue.push_back(job);
+  shared->work.notify_all();
+
+  const Clock::duration timeout = std::chrono::milliseconds(shared->timeoutMs);
+  for (;;) {
+    bool pending = false;
+    bool hasDeadline = false;
+    Clock::time_point deadline;
+    Clock::time_point t = Clock::now();
+    for (const std::shared_ptr<Job> &job : jobs) {
+      if (job->finished || job->abandoned)
+        continue;
+      if (job->started && t >= job->since + timeout) {
+        // Vencido: marcar la ventana, soltar el hilo y seguir sin él
+        job->abandoned = true;
+        shared->stuckPids.insert(job->pid);
+        Spawn();
+        DWORD until = backend->TickCount() + shared->cooldownMs;
+        if (job->batch) {
+          // No se sabe qué ventana del lote lo frenó, pero todas son del
+          // mismo proceso (mismo hilo de interfaz): todas se apartan
+          for (const WindowPos &m : job->moves)
+            shared->unresponsive[m.hwnd] = until;
+          result.timedOut += (int)job->moves.size();
+        } else {
+          shared->unresponsive[job->moves[job->current].hwnd] = until;
+          result.timedOut++;
+          result.skipped += (int)(job->moves.size() - job->current - 1);
+        }
+        LOG_WARNING("Ventana sin respuesta al moverla; se omite durante " +
+                    std::to_string(shared->cooldownMs) + " ms");
+        continue;
+      }
+      pending = true;
+      if (job->started && (!hasDeadline || job->since + timeout < deadline)) {
+        deadline = job->since + timeout;
+        hasDeadline = true;
+      }
+    }
+    if (!pending)
+      break;
+    if (hasDeadline)
+      shared->progress.wait_until(lock, deadline);
+    else
+      shared->progress.wait(lock);
+  }
+
+  for (const std::shared_ptr<Job> &job : jobs)
+    result.applied += job->applied;
+  return result;
+}
+
+bool MoveDispatcher::IsUnresponsive(HWND hwnd) {
+  DWORD now = shared->backend->TickCount();
+  std::lock_guard<std::mutex> lock(shared->mtx);
+  auto it = shared->unresponsive.find(hwnd);
+  return it != shared->unresponsive.end() && (LONG)(it->second - now) > 0;
+}
+
+size_t MoveDispatcher::UnresponsiveCount() {
+  DWORD now = shared->backend->TickCount();
+  std::lock_guard<std::mutex> lock(shared->mtx);
+  size_t count = 0;
+  for (const auto &entry : shared->unresponsive)
+    if ((LONG)(entry.second - now) > 0)
+      count++;
+  return count;
+}
@@ -0,0 +1,63 @@
+#ifndef MOVE_DISPATCHER_H
+#define MOVE_DISPATCHER_H
+
+#include "DesktopBackend.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Aplica lotes de SetPos en paralelo, protegido contra apps colgadas
+ *
+ * SetWindowPos sobre una ventana cuyo hilo no responde puede bloquear al
+ * llamador indefinidamente. Apply() reparte el lote por proceso propietario
+ * (las ventanas de un mismo proceso suelen compartir hilo de interfaz, así
+ * que entre ellas no hay nada que ganar en paralelo) y lo ejecuta en un pool
+ * de hilos. Cada movimiento tiene un plazo: si vence, la ventana queda
+ * marcada como "no responde" durante el enfriamiento, el resto de su proceso
+ * se salta y Apply() vuelve sin esperarla. Un hilo atascado se sustituye por
+ * otro para no perder paralelismo.
+ *
+ * ApplyBatch() reparte igual por proceso, pero cada proceso recibe sus
+ * movimientos en un único SetPosBatch (DeferWindowPos): las ventanas de un
+ * proceso se mueven juntas, los procesos van en paralelo y una app colgada
+ * solo retiene su propio lote.
+ *
+ * El plazo se mide en tiempo real; el enfriamiento con backend->TickCount(),
+ * así que con FakeDesktop se puede expirar avanzando el reloj virtual.
+ */
+class MoveDispatcher {
+public:
+  struct Result {
+    int applied;  // SetPos completados dentro del plazo
+    int timedOut; // Ventanas marcadas como no responde en este lote
+    int skipped;  // En enfriamiento, o detrás de una que venció
+  };
+
+  explicit MoveDispatcher(DesktopBackend *backend, int workers = 4);
+  // Los hilos atascados en una ventana colgada se sueltan (detach) y
+  // terminan solos cuando el sistema les devuelve el control
+  ~MoveDispatcher();
+
+  void Configure(int timeoutMs, int cooldownMs);
+
+  // Vuelve cuando todos los movimientos terminaron, vencieron o se saltaron
+  Result Apply(const std::vector<WindowPos> &moves);
+  // Un SetPosBatch por proceso, con el mismo plazo. Si uno vence no se sabe
+  // qué ventana lo frenó: todas las de ese proceso cuentan en timedOut y
+  // quedan en enfriamiento; los demás procesos no se ven afectados
+  Result ApplyBatch(const std::vector<WindowPos> &moves);
+
+  bool IsUnresponsive(HWND hwnd);
+  size_t UnresponsiveCount();
+
+private:
+  struct Job;
+  struct Shared;
+  std::shared_ptr<Shared> shared; // También lo retienen los hilos
+
+  static void Run(std::shared_ptr<Shared> shared);
+  void Spawn();
+  Result Dispatch(const std::vector<WindowPos> &moves, bool batch);
+};
+
+#endif // MOVE_DISPATCHER_H
@@ -0,0 +1,95 @@
+#include "ProcessCache.h"
+#include <algorithm>
+#include <cctype>
+
+ProcessCache::ProcessCache(DesktopBackend *backend, size_t capacity,
+                           DWORD maxAgeMs)
+    : backend(backend), capacity(capacity), maxAgeMs(maxAgeMs) {}
+
+void ProcessCache::Clear() {
+  entries.clear();
+  lru.clear();
+  missing.clear();
+  everRefreshed = false;
+}
+
+void ProcessCache::Touch(Entry &entry) {
+  lru.splice(lru.begin(), lru, entry.lruPos);
+}
+
+void ProcessCache::Refresh(DWORD wanted) {
+  std::vector<ProcessDesc> processes;
+  backend->ListProcesses(processes);
+  snapshots++;
+  lastRefresh = backend->TickCount();
+  everRefreshed = true;
+
+  std::unordered_set<DWORD> alive;
+  alive.reserve(processes.size());
+  for (const ProcessDesc &proc : processes) {
+    alive.insert(proc.pid);
+    auto it = entries.find(proc.pid);
+    if (it != entries.end()) {
+      // El PID puede haberse reutilizado: actualizar el nombre
+      if (it->second.info.exeName != proc.exeName) {
+        it->second.info.exeName = proc.exeName;
+        it->second.info.lowerName = proc.exeName;
+        std::transform(it->second.info.lowerName.begin(),
+                       it->second.info.lowerName.end(),
+                       it->second.info.lowerName.begin(), ::tolower);
+      }
+      continue;
+    }
+
+    Entry entry;
+    entry.info.exeName = proc.exeName;
+    entry.info.lowerName = proc.exeName;
+    std::transform(entry.info.lowerName.begin(), entry.info.lowerName.end(),
+                   entry.info.lowerName.begin(), ::tolower);
+    // Las nuevas entran al final: aún no las ha pedido nadie
+    entry.lruPos = lru.insert(lru.end(), proc.pid);
+    entries.emplace(proc.pid, std::move(entry));
+  }
+
+  // Procesos que terminaron
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (alive.count(it->first) == 0) {
+      lru.erase(it->second.lruPos);
+      it = entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // Límite de tamaño: expulsar las menos usadas (nunca la que se busca)
+  auto wantedIt = entries.find(wanted);
+  if (wantedIt != entries.end())
+    Touch(wantedIt->second);
+  while (entries.size() > capacity) {
+    entries.erase(lru.back());
+    lru.pop_back();
+  }
+}
+
+const ProcessCache::Info *ProcessCache::Lookup(DWORD pid) {
+  if (!everRefreshed || backend->TickCount() - lastRefresh > maxAgeMs) {
+    missing.clear();
+    Refresh(pid);
+  }
+
+  auto it = entries.find(pid);
+  if (it == entries.end()) {
+    // Un PID desconocido provoca un snapshot (proceso recién creado); si
+    // tampoco está ahí, no se vuelve a buscar hasta que caduque la caché
+    if (missing.count(pid))
+      return nullptr;
+    Refresh(pid);
+    it = entries.find(pid);
+    if (it == entries.end()) {
+      missing.insert(pid);
+      return nullptr;
+    }
+  }
+  Touch(it->second);
+  return &it->second.info;
+}
@@ -0,0 +1,61 @@
+#ifndef PROCESS_CACHE_H
+#define PROCESS_CACHE_H
+
+#include "DesktopBackend.h"
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * @brief Caché PID -> ejecutable con refresco por lotes
+ *
+ * Evita tomar un snapshot de procesos por cada ventana: una caché más vieja
+ * que maxAgeMs, o un PID que aún no se conoce, provoca un único snapshot que
+ * refresca todas las entradas a la vez, así que filtrar N ventanas cuesta
+ * normalmente un snapshot. Los PID que ya no aparecen se descartan en cada
+ * refresco, lo que también limita cuánto puede durar un PID reutilizado.
+ *
+ * El tamaño está acotado: al superar la capacidad se expulsa la entrada
+ * usada hace más tiempo (LRU).
+ */
+class ProcessCache {
+public:
+  struct Info {
+    std::string exeName;
+    std::string lowerName; // exeName en minúsculas, para comparar sin caso
+  };
+
+  ProcessCache(DesktopBackend *backend, size_t capacity = 1024,
+               DWORD maxAgeMs = 5000);
+
+  // nullptr si el PID no existe (ni tras refrescar)
+  const Info *Lookup(DWORD pid);
+
+  // Olvida todo; el próximo Lookup toma un snapshot nuevo
+  void Clear();
+
+  size_t Size() const { return entries.size(); }
+  long long SnapshotCount() const { return snapshots; }
+
+private:
+  struct Entry {
+    Info info;
+    std::list<DWORD>::iterator lruPos;
+  };
+
+  DesktopBackend *backend;
+  size_t capacity;
+  DWORD maxAgeMs;
+  std::unordered_map<DWORD, Entry> entries;
+  std::list<DWORD> lru;              // Frente = usado más recientemente
+  std::unordered_set<DWORD> missing; // PIDs ya buscados sin éxito
+  DWORD lastRefresh = 0;
+  bool everRefreshed = false;
+  long long snapshots = 0;
+
+  void Refresh(DWORD wanted);
+  void Touch(Entry &entry);
+};
+
+#endif // PROCESS_CACHE_H
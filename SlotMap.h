@@ -0,0 +1,77 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Tabla de registros con identificadores generacionales de 64 bits
+ *
+ * Id = (generación << 32) | índice del hueco. Al borrar, la generación del
+ * hueco sube y el hueco vuelve a la lista libre, así que un Id viejo nunca
+ * encuentra el registro de otro (al contrario que una HWND reutilizada por
+ * el sistema). Insertar, buscar y borrar son O(1) y la memoria queda
+ * acotada por el máximo de registros vivos a la vez, no por los creados.
+ */
+template <typename T> class SlotMap {
+public:
+  typedef uint64_t Id;
+  static constexpr Id NONE = 0; // Nunca es un Id válido (generación >= 1)
+
+  Id Insert(const T &value) {
+    uint32_t index;
+    if (!freeSlots.empty()) {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+    } else {
+      index = (uint32_t)slots.size();
+      slots.push_back(Slot());
+    }
+    Slot &slot = slots[index];
+    slot.live = true;
+    slot.value = value;
+    count++;
+    return ((Id)slot.generation << 32) | index;
+  }
+
+  // nullptr si el Id ya se borró o nunca existió
+  T *Get(Id id) {
+    uint32_t index = (uint32_t)id;
+    if (index >= slots.size())
+      return nullptr;
+    Slot &slot = slots[index];
+    if (!slot.live || slot.generation != (uint32_t)(id >> 32))
+      return nullptr;
+    return &slot.value;
+  }
+
+  bool Remove(Id id) {
+    if (!Get(id))
+      return false;
+    uint32_t index = (uint32_t)id;
+    Slot &slot = slots[index];
+    slot.live = false;
+    slot.value = T(); // Soltar lo que tenga reservado
+    if (++slot.generation == 0)
+      slot.generation = 1;
+    freeSlots.push_back(index);
+    count--;
+    return true;
+  }
+
+  size_t Size() const { return count; }
+  size_t Capacity() const { return slots.size(); }
+
+private:
+  struct Slot {
+    uint32_t generation = 1;
+    bool live = false;
+    T value;
+  };
+
+  std::vector<Slot> slots;
+  std::vector<uint32_t> freeSlots;
+  size_t count = 0;
+};
+
+#endif // SLOT_MAP_H
@@ -0,0 +1,148 @@
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <cstdlib>
+
+SpatialIndex::SpatialIndex(int cellSize)
+    : cellSize(cellSize > 0 ? cellSize : DEFAULT_CELL_SIZE) {}
+
+int SpatialIndex::CellOf(const PixelRect &rect) const {
+  // Centro en coordenadas dobles para no perder el medio píxel
+  long long cx = 2LL * rect.x + rect.w - 2LL * bounds.x;
+  long long cy = 2LL * rect.y + rect.h - 2LL * bounds.y;
+  if (cx < 0 || cy < 0 || cx >= 2LL * bounds.w || cy >= 2LL * bounds.h)
+    return -1;
+  long long col = cx / (2LL * cellSize), row = cy / (2LL * cellSize);
+  return (int)(row * cols + col);
+}
+
+void SpatialIndex::Unbucket(HWND hwnd, int cell) {
+  if (cell < 0)
+    return;
+  std::vector<HWND> &bucket = cells[cell];
+  auto it = std::find(bucket.begin(), bucket.end(), hwnd);
+  if (it != bucket.end()) {
+    *it = bucket.back();
+    bucket.pop_back();
+  }
+}
+
+void SpatialIndex::SetBounds(const PixelRect &bounds) {
+  this->bounds = bounds;
+  cols = bounds.w > 0 ? (bounds.w + cellSize - 1) / cellSize : 0;
+  rows = bounds.h > 0 ? (bounds.h + cellSize - 1) / cellSize : 0;
+  cells.assign((size_t)cols * rows, std::vector<HWND>());
+  for (auto &entry : entries) {
+    entry.second.cell = CellOf(entry.second.rect);
+    if (entry.second.cell >= 0)
+      cells[entry.second.cell].push_back(entry.first);
+  }
+}
+
+void SpatialIndex::Update(HWND hwnd, const PixelRect &rect) {
+  int cell = CellOf(rect);
+  auto it = entries.find(hwnd);
+  if (it == entries.end()) {
+    entries[hwnd] = {rect, cell};
+  } else {
+    it->second.rect = rect;
+    if (it->second.cell == cell)
+      return;
+    Unbucket(hwnd, it->second.cell);
+    it->second.cell = cell;
+  }
+  if (cell >= 0)
+    cells[cell].push_back(hwnd);
+}
+
+bool SpatialIndex::Remove(HWND hwnd) {
+  auto it = entries.find(hwnd);
+  if (it == entries.end())
+    return false;
+  Unbucket(hwnd, it->second.cell);
+  entries.erase(it);
+  return true;
+}
+
+void SpatialIndex::Clear() {
+  entries.clear();
+  for (std::vector<HWND> &bucket : cells)
+    bucket.clear();
+}
+
+bool SpatialIndex::RectOf(HWND hwnd, PixelRect &out) const {
+  auto it = entries.find(hwnd);
+  if (it == entries.end())
+    return false;
+  out = it->second.rect;
+  return true;
+}
+
+void SpatialIndex::Windows(std::vector<HWND> &out) const {
+  out.clear();
+  out.reserve(entries.size());
+  for (const auto &entry : entries)
+    out.push_back(entry.first);
+}
+
+HWND SpatialIndex::Nearest(const PixelRect &from, Direction dir,
+                           HWND skip) const {
+  if (cells.empty())
+    return NULL;
+  long long sx = 2LL * from.x + from.w, sy = 2LL * from.y + from.h;
+  bool horizontal = dir == DIR_LEFT || dir == DIR_RIGHT;
+  int sign = (dir == DIR_RIGHT || dir == DIR_DOWN) ? 1 : -1;
+
+  // Celda del origen, llevada al borde si la ventana está fuera
+  int scol = (int)std::min<long long>(
+      cols - 1, std::max<long long>(0, (sx - 2LL * bounds.x) /
+                                           (2LL * cellSize)));
+  int srow = (int)std::min<long long>(
+      rows - 1, std::max<long long>(0, (sy - 2LL * bounds.y) /
+                                           (2LL * cellSize)));
+
+  HWND best = NULL;
+  long long bestScore = 0;
+  auto scan = [&](int col, int row) {
+    // Solo las celdas del lado de la dirección
+    int along = horizontal ? col - scol : row - srow;
+    if (along * sign < 0)
+      return;
+    for (HWND hwnd : cells[row * cols + col]) {
+      if (hwnd == skip)
+        continue;
+      const PixelRect &r = entries.find(hwnd)->second.rect;
+      long long cx = 2LL * r.x + r.w, cy = 2LL * r.y + r.h;
+      long long d = horizontal ? (cx - sx) * sign : (cy - sy) * sign;
+      if (d <= 0)
+        continue;
+      long long score = d + 2 * std::llabs(horizontal ? cy - sy : cx - sx);
+      if (!best || score < bestScore) {
+        best = hwnd;
+        bestScore = score;
+      }
+    }
+  };
+
+  // Anillo r: toda celda está a >= (r - 1) celdas del centro en algún eje,
+  // y la puntuación nunca es menor que esa distancia
+  int maxRing = std::max(cols, rows);
+  for (int r = 0; r <= maxRing; ++r) {
+    if (best && 2LL * (r - 1) * cellSize >= bestScore)
+      break;
+    int c0 = scol - r, c1 = scol + r, r0 = srow - r, r1 = srow + r;
+    for (int col = std::max(c0, 0); col <= std::min(c1, cols - 1); ++col) {
+      if (r0 >= 0)
+        scan(col, r0);
+      if (r1 < rows && r1 != r0)
+        scan(col, r1);
+    }
+    for (int row = std::max(r0 + 1, 0); row <= std::min(r1 - 1, rows - 1);
+         ++row) {
+      if (c0 >= 0)
+        scan(c0, row);
+      if (c1 < cols && c1 != c0)
+        scan(c1, row);
+    }
+  }
+  return best;
+}
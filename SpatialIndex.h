@@ -0,0 +1,72 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "LayoutTable.h"
+#include "WinCompat.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Índice espacial de ventanas para navegar por dirección
+ *
+ * Rejilla uniforme de celdas de cellSize píxeles sobre el escritorio
+ * virtual (la unión de todos los monitores): cada ventana cae en la celda
+ * de su centro. Actualizar o quitar una ventana es O(1). Nearest() busca
+ * en anillos de celdas alrededor del origen, solo del lado de la
+ * dirección pedida, y se detiene en cuanto ningún anillo más lejano puede
+ * mejorar la mejor candidata, así que solo mira las ventanas cercanas y no
+ * las n. Como la rejilla cubre todos los monitores, la búsqueda pasa de
+ * uno a otro sin casos especiales.
+ *
+ * Puntuación de una candidata a la derecha (las demás direcciones son
+ * simétricas): dx + 2 * |dy| entre centros, con dx > 0. Gana la más
+ * cercana en la dirección y, a igual distancia, la mejor alineada.
+ *
+ * Las ventanas con el centro fuera del escritorio (p.ej. minimizadas en
+ * -32000) se recuerdan pero no se devuelven. No toca el sistema, así que
+ * compila y se prueba en Linux; no es segura entre hilos.
+ */
+class SpatialIndex {
+public:
+  enum Direction { DIR_LEFT, DIR_RIGHT, DIR_UP, DIR_DOWN };
+
+  static const int DEFAULT_CELL_SIZE = 256;
+
+  explicit SpatialIndex(int cellSize = DEFAULT_CELL_SIZE);
+
+  // Rectángulo del escritorio virtual; recoloca todas las ventanas
+  void SetBounds(const PixelRect &bounds);
+  const PixelRect &Bounds() const { return bounds; }
+
+  void Update(HWND hwnd, const PixelRect &rect);
+  bool Remove(HWND hwnd);
+  void Clear();
+
+  bool Contains(HWND hwnd) const { return entries.count(hwnd) != 0; }
+  size_t Size() const { return entries.size(); }
+  bool RectOf(HWND hwnd, PixelRect &out) const;
+  void Windows(std::vector<HWND> &out) const;
+
+  // Ventana más cercana a 'from' en esa dirección, sin contar 'skip';
+  // NULL si no hay ninguna
+  HWND Nearest(const PixelRect &from, Direction dir, HWND skip = NULL) const;
+
+private:
+  struct Entry {
+    PixelRect rect;
+    int cell; // -1 si el centro queda fuera de la rejilla
+  };
+
+  int cellSize;
+  PixelRect bounds = {0, 0, 0, 0};
+  int cols = 0;
+  int rows = 0;
+  std::vector<std::vector<HWND>> cells;
+  std::unordered_map<HWND, Entry> entries;
+
+  int CellOf(const PixelRect &rect) const;
+  void Unbucket(HWND hwnd, int cell);
+};
+
+#endif // SPATIAL_INDEX_H
@@ -0,0 +1,227 @@
+#include "TilingTree.h"
+#include <algorithm>
+
+int TilingTree::Alloc() {
+  Node node;
+  node.parent = -1;
+  node.child[0] = node.child[1] = -1;
+  node.hwnd = NULL;
+  node.vertical = true;
+  node.queued = false;
+  node.ratio = 0.5f;
+  node.leaves = 1;
+  node.rect = {0, 0, 0, 0};
+  if (!freeNodes.empty()) {
+    int index = freeNodes.back();
+    freeNodes.pop_back();
+    node.queued = nodes[index].queued; // Puede seguir en 'changed'
+    nodes[index] = node;
+    return index;
+  }
+  nodes.push_back(node);
+  return (int)nodes.size() - 1;
+}
+
+void TilingTree::Free(int index) {
+  nodes[index].hwnd = NULL;
+  nodes[index].child[0] = nodes[index].child[1] = -1;
+  freeNodes.push_back(index);
+}
+
+void TilingTree::MarkChanged(int index) {
+  if (!nodes[index].queued) {
+    nodes[index].queued = true;
+    changed.push_back(index);
+  }
+}
+
+void TilingTree::AddLeaves(int index, int delta) {
+  for (; index >= 0; index = nodes[index].parent)
+    nodes[index].leaves += delta;
+}
+
+void TilingTree::Layout(int index, const PixelRect &rect) {
+  Node &node = nodes[index];
+  if (node.child[0] < 0) {
+    if (node.rect.x != rect.x || node.rect.y != rect.y ||
+        node.rect.w != rect.w || node.rect.h != rect.h) {
+      node.rect = rect;
+      MarkChanged(index);
+    }
+    return;
+  }
+  node.rect = rect;
+  PixelRect a = rect, b = rect;
+  if (node.vertical) {
+    a.w = (int)(rect.w * node.ratio + 0.5f);
+    b.x = rect.x + a.w;
+    b.w = rect.w - a.w;
+  } else {
+    a.h = (int)(rect.h * node.ratio + 0.5f);
+    b.y = rect.y + a.h;
+    b.h = rect.h - a.h;
+  }
+  int left = node.child[0], right = node.child[1];
+  Layout(left, a);
+  Layout(right, b);
+}
+
+void TilingTree::SetArea(const PixelRect &area, int gap) {
+  bool gapChanged = gap != this->gap;
+  this->area = area;
+  this->gap = gap;
+  if (root < 0)
+    return;
+  Layout(root, area);
+  if (gapChanged) {
+    // Mismo rectángulo pero otro hueco: hay que volver a aplicarlo
+    for (const auto &entry : leafOf)
+      MarkChanged(entry.second);
+  }
+}
+
+bool TilingTree::Insert(HWND hwnd, HWND target) {
+  if (!hwnd || leafOf.count(hwnd))
+    return false;
+  int leaf = Alloc();
+  nodes[leaf].hwnd = hwnd;
+  leafOf[hwnd] = leaf;
+  if (root < 0) {
+    root = leaf;
+    Layout(root, area);
+    return true;
+  }
+
+  int split = -1;
+  auto it = target ? leafOf.find(target) : leafOf.end();
+  if (it != leafOf.end() && it->second != leaf) {
+    split = it->second;
+  } else {
+    // Bajar por el hijo con menos hojas: árbol equilibrado
+    split = root;
+    while (nodes[split].child[0] >= 0) {
+      const Node &n = nodes[split];
+      split = nodes[n.child[0]].leaves < nodes[n.child[1]].leaves ? n.child[0]
+                                                                   : n.child[1];
+    }
+  }
+
+  // La hoja partida pasa a ser hija de un nodo interno nuevo en su sitio
+  int inner = Alloc();
+  Node &in = nodes[inner];
+  in.parent = nodes[split].parent;
+  in.child[0] = split;
+  in.child[1] = leaf;
+  in.rect = nodes[split].rect;
+  in.vertical = in.rect.w >= in.rect.h;
+  in.leaves = 1; // AddLeaves suma la nueva
+  if (in.parent < 0) {
+    root = inner;
+  } else {
+    Node &p = nodes[in.parent];
+    p.child[p.child[0] == split ? 0 : 1] = inner;
+  }
+  nodes[split].parent = inner;
+  nodes[leaf].parent = inner;
+  AddLeaves(inner, 1);
+  Layout(inner, nodes[inner].rect);
+  return true;
+}
+
+bool TilingTree::Remove(HWND hwnd) {
+  auto it = leafOf.find(hwnd);
+  if (it == leafOf.end())
+    return false;
+  int leaf = it->second;
+  leafOf.erase(it);
+  int parent = nodes[leaf].parent;
+  Free(leaf);
+  if (parent < 0) {
+    root = -1;
+    return true;
+  }
+
+  const Node &p = nodes[parent];
+  int sibling = p.child[0] == leaf ? p.child[1] : p.child[0];
+  int grand = p.parent;
+  PixelRect rect = p.rect;
+  nodes[sibling].parent = grand;
+  if (grand < 0) {
+    root = sibling;
+  } else {
+    Node &g = nodes[grand];
+    g.child[g.child[0] == parent ? 0 : 1] = sibling;
+    AddLeaves(grand, -1);
+  }
+  Free(parent);
+  Layout(sibling, rect);
+  return true;
+}
+
+bool TilingTree::Swap(HWND a, HWND b) {
+  auto ia = leafOf.find(a), ib = leafOf.find(b);
+  if (ia == leafOf.end() || ib == leafOf.end() || a == b)
+    return false;
+  std::swap(nodes[ia->second].hwnd, nodes[ib->second].hwnd);
+  std::swap(ia->second, ib->second);
+  MarkChanged(ia->second);
+  MarkChanged(ib->second);
+  return true;
+}
+
+bool TilingTree::SetSplitRatio(HWND hwnd, float ratio) {
+  auto it = leafOf.find(hwnd);
+  if (it == leafOf.end() || nodes[it->second].parent < 0)
+    return false;
+  int parent = nodes[it->second].parent;
+  Node &p = nodes[parent];
+  ratio = std::min(0.9f, std::max(0.1f, ratio));
+  // La proporción guardada es la de child[0]
+  p.ratio = p.child[0] == it->second ? ratio : 1.0f - ratio;
+  Layout(parent, p.rect);
+  return true;
+}
+
+int TilingTree::DepthOf(int index) const {
+  if (index < 0 || nodes[index].child[0] < 0)
+    return index < 0 ? 0 : 1;
+  return 1 + std::max(DepthOf(nodes[index].child[0]),
+                      DepthOf(nodes[index].child[1]));
+}
+
+int TilingTree::Depth() const { return DepthOf(root); }
+
+bool TilingTree::RectOf(HWND hwnd, PixelRect &out) const {
+  auto it = leafOf.find(hwnd);
+  if (it == leafOf.end())
+    return false;
+  const PixelRect &r = nodes[it->second].rect;
+  out.x = r.x + gap;
+  out.y = r.y + gap;
+  out.w = std::max(1, r.w - gap * 2);
+  out.h = std::max(1, r.h - gap * 2);
+  return true;
+}
+
+void TilingTree::Windows(std::vector<HWND> &out) const {
+  out.clear();
+  out.reserve(leafOf.size());
+  for (const auto &entry : leafOf)
+    out.push_back(entry.first);
+}
+
+void TilingTree::TakeChanges(std::vector<WindowPos> &out) {
+  for (int index : changed) {
+    Node &node = nodes[index];
+    if (!node.queued)
+      continue; // Repetido tras reutilizar el nodo
+    node.queued = false;
+    if (!node.hwnd || node.child[0] >= 0)
+      continue; // Liberado o convertido en nodo interno
+    PixelRect r;
+    RectOf(node.hwnd, r);
+    out.push_back({node.hwnd, r.x, r.y, r.w, r.h,
+                   SWP_NOZORDER | SWP_NOACTIVATE});
+  }
+  changed.clear();
+}
@@ -0,0 +1,80 @@
+#ifndef TILING_TREE_H
+#define TILING_TREE_H
+
+#include "DesktopBackend.h"
+#include "LayoutTable.h"
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Árbol BSP persistente de tiling para un monitor
+ *
+ * Cada nodo interno parte su rectángulo en dos (izquierda|derecha o
+ * arriba/abajo) con una proporción; cada hoja es una ventana. A diferencia
+ * de TileAllWindows, el árbol recuerda la disposición: insertar, quitar o
+ * intercambiar una ventana es una edición O(profundidad) que solo recalcula
+ * el subárbol afectado, y TakeChanges() devuelve únicamente las ventanas
+ * cuyo rectángulo cambió.
+ *
+ * Insert() sin destino baja por el hijo con menos hojas, así que el árbol
+ * queda equilibrado (profundidad ~log2 n) y la ventana nueva parte una de
+ * las hojas más grandes. La dirección del corte sigue el lado más largo.
+ *
+ * No toca el sistema: solo HWND como clave y rectángulos, así que compila y
+ * se prueba en Linux.
+ */
+class TilingTree {
+public:
+  TilingTree() {}
+
+  // Área del monitor y hueco entre ventanas; recoloca todo el árbol
+  void SetArea(const PixelRect &area, int gap);
+  const PixelRect &Area() const { return area; }
+
+  // Parte la hoja de target (o la elegida por equilibrio si es NULL)
+  bool Insert(HWND hwnd, HWND target = NULL);
+  // El hermano ocupa el hueco de la hoja quitada
+  bool Remove(HWND hwnd);
+  bool Swap(HWND a, HWND b);
+  // Proporción del corte que separa hwnd de su hermano (0.1 - 0.9)
+  bool SetSplitRatio(HWND hwnd, float ratio);
+
+  bool Contains(HWND hwnd) const { return leafOf.count(hwnd) != 0; }
+  size_t Size() const { return leafOf.size(); }
+  int Depth() const;
+  // Rectángulo de la ventana con el hueco ya aplicado
+  bool RectOf(HWND hwnd, PixelRect &out) const;
+  void Windows(std::vector<HWND> &out) const;
+
+  // Ventanas movidas desde la última llamada, con su destino
+  void TakeChanges(std::vector<WindowPos> &out);
+
+private:
+  struct Node {
+    int parent;
+    int child[2];   // -1 en las hojas
+    HWND hwnd;      // Solo en las hojas
+    bool vertical;  // Corte izquierda|derecha
+    bool queued;    // Está en 'changed'
+    float ratio;    // Parte de child[0]
+    int leaves;     // Hojas del subárbol
+    PixelRect rect; // Rectángulo asignado (sin hueco)
+  };
+
+  std::vector<Node> nodes; // Almacenamiento denso con lista libre
+  std::vector<int> freeNodes;
+  std::unordered_map<HWND, int> leafOf;
+  std::vector<int> changed;
+  int root = -1;
+  PixelRect area = {0, 0, 0, 0};
+  int gap = 0;
+
+  int Alloc();
+  void Free(int index);
+  void Layout(int index, const PixelRect &rect);
+  void MarkChanged(int index);
+  void AddLeaves(int index, int delta);
+  int DepthOf(int index) const;
+};
+
+#endif // TILING_TREE_H
@@ -0,0 +1,643 @@
+#include "Win32Backend.h"
+#include <cstring>
+#include <dwmapi.h>
+#include <objbase.h>
+#include <shellapi.h>
+#include <shlobj.h>
+#include <shlwapi.h>
+#include <tlhelp32.h>
+
+#pragma comment(lib, "dwmapi.lib")
+
+DesktopBackend *DesktopBackend::Native() {
+  static Win32Backend instance;
+  return &instance;
+}
+
+// ===== EVENTOS =====
+
+LRESULT CALLBACK Win32Backend::NotifyWndProc(HWND hwnd, UINT msg,
+                                             WPARAM wParam, LPARAM lParam) {
+  Win32Backend *self =
+      reinterpret_cast<Win32Backend *>(GetWindowLongPtrA(hwnd, GWLP_USERDATA));
+  if (self && self->eventSink) {
+    if (msg == WM_DISPLAYCHANGE ||
+        (msg == WM_SETTINGCHANGE && wParam == SPI_SETWORKAREA)) {
+      self->eventSink->OnDisplayChanged();
+    }
+  }
+  return DefWindowProcA(hwnd, msg, wParam, lParam);
+}
+
+// Solo hay un backend nativo: los callbacks de WinEvent no llevan contexto
+static Win32Backend *winEventOwner = nullptr;
+
+void CALLBACK Win32Backend::WinEventProc(HWINEVENTHOOK hook, DWORD event,
+                                         HWND hwnd, LONG idObject,
+                                         LONG idChild, DWORD eventThread,
+                                         DWORD eventTime) {
+  if (!winEventOwner || !winEventOwner->eventSink || !hwnd ||
+      idObject != OBJID_WINDOW || idChild != CHILDID_SELF)
+    return;
+
+  WindowEvent kind;
+  switch (event) {
+  case EVENT_OBJECT_CREATE:
+    kind = WE_CREATED;
+    break;
+  case EVENT_OBJECT_DESTROY:
+    kind = WE_DESTROYED;
+    break;
+  case EVENT_OBJECT_SHOW:
+    kind = WE_SHOWN;
+    break;
+  case EVENT_OBJECT_HIDE:
+    kind = WE_HIDDEN;
+    break;
+  case EVENT_OBJECT_CLOAKED:
+    kind = WE_CLOAKED;
+    break;
+  case EVENT_OBJECT_UNCLOAKED:
+    kind = WE_UNCLOAKED;
+    break;
+  case EVENT_OBJECT_NAMECHANGE:
+    kind = WE_TITLE_CHANGED;
+    break;
+  case EVENT_SYSTEM_FOREGROUND:
+    kind = WE_FOREGROUND;
+    break;
+  case EVENT_SYSTEM_MOVESIZEEND:
+  case EVENT_SYSTEM_MINIMIZESTART:
+  case EVENT_SYSTEM_MINIMIZEEND:
+    kind = WE_MOVED;
+    break;
+  default:
+    return;
+  }
+
+  // Solo ventanas de nivel superior (una ventana destruida ya no tiene padre)
+  if (kind != WE_DESTROYED &&
+      GetAncestor(hwnd, GA_PARENT) != GetDesktopWindow())
+    return;
+
+  winEventOwner->eventSink->OnWindowEvent(hwnd, kind);
+}
+
+bool Win32Backend::InstallWinEventHooks() {
+  if (winEventHooks[0])
+    return true;
+
+  // Rangos separados para no recibir EVENT_OBJECT_LOCATIONCHANGE, que se
+  // dispara en cada frame de cualquier movimiento: de los arrastres solo
+  // interesa el final
+  const DWORD ranges[6][2] = {
+      {EVENT_OBJECT_CREATE, EVENT_OBJECT_HIDE},
+      {EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE},
+      {EVENT_OBJECT_CLOAKED, EVENT_OBJECT_UNCLOAKED},
+      {EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND},
+      {EVENT_SYSTEM_MOVESIZEEND, EVENT_SYSTEM_MOVESIZEEND},
+      {EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND}};
+
+  winEventOwner = this;
+  for (int i = 0; i < 6; ++i) {
+    // Fuera de contexto: los eventos llegan por la cola de este hilo
+    winEventHooks[i] =
+        SetWinEventHook(ranges[i][0], ranges[i][1], NULL, WinEventProc, 0, 0,
+                        WINEVENT_OUTOFCONTEXT);
+    if (!winEventHooks[i]) {
+      RemoveWinEventHooks();
+      return false;
+    }
+  }
+  return true;
+}
+
+void Win32Backend::RemoveWinEventHooks() {
+  for (int i = 0; i < 6; ++i) {
+    if (winEventHooks[i]) {
+      UnhookWinEvent(winEventHooks[i]);
+      winEventHooks[i] = NULL;
+    }
+  }
+}
+
+bool Win32Backend::SetEventSink(DesktopEventSink *sink) {
+  eventSink = sink;
+  if (!sink) {
+    RemoveWinEventHooks();
+    return false;
+  }
+
+  bool windowEvents = InstallWinEventHooks();
+  if (notifyHwnd)
+    return windowEvents;
+
+  // Ventana de nivel superior oculta: las ventanas message-only no reciben
+  // los broadcasts de WM_DISPLAYCHANGE / WM_SETTINGCHANGE
+  WNDCLASSEXA wc = {0};
+  wc.cbSize = sizeof(WNDCLASSEXA);
+  wc.lpfnWndProc = NotifyWndProc;
+  wc.hInstance = GetModuleHandle(NULL);
+  wc.lpszClassName = "WinVenNotifyClass";
+  RegisterClassExA(&wc);
+
+  notifyHwnd = CreateWindowExA(WS_EX_TOOLWINDOW, "WinVenNotifyClass",
+                               "WinVenNotify", WS_POPUP, 0, 0, 0, 0, NULL,
+                               NULL, GetModuleHandle(NULL), NULL);
+  if (notifyHwnd)
+    SetWindowLongPtrA(notifyHwnd, GWLP_USERDATA, (LONG_PTR)this);
+  return windowEvents;
+}
+
+// ===== VENTANAS =====
+
+static BOOL CALLBACK CollectWindowsProc(HWND hwnd, LPARAM lParam) {
+  reinterpret_cast<std::vector<HWND> *>(lParam)->push_back(hwnd);
+  return TRUE;
+}
+
+void Win32Backend::ListTopLevelWindows(std::vector<HWND> &out) {
+  out.clear();
+  EnumWindows(CollectWindowsProc, reinterpret_cast<LPARAM>(&out));
+}
+
+bool Win32Backend::IsAlive(HWND hwnd) { return hwnd && IsWindow(hwnd); }
+
+bool Win32Backend::IsVisible(HWND hwnd) { return IsWindowVisible(hwnd) != 0; }
+
+bool Win32Backend::IsCloaked(HWND hwnd) {
+  int cloaked = 0;
+  return SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked,
+                                         sizeof(cloaked))) &&
+         cloaked;
+}
+
+LONG Win32Backend::GetStyle(HWND hwnd) {
+  return GetWindowLongA(hwnd, GWL_STYLE);
+}
+
+LONG Win32Backend::GetExStyle(HWND hwnd) {
+  return GetWindowLongA(hwnd, GWL_EXSTYLE);
+}
+
+std::string Win32Backend::GetTitle(HWND hwnd) {
+  char title[256];
+  int len = GetWindowTextA(hwnd, title, sizeof(title));
+  return std::string(title, len > 0 ? len : 0);
+}
+
+std::string Win32Backend::GetClass(HWND hwnd) {
+  char className[256];
+  int len = GetClassNameA(hwnd, className, sizeof(className));
+  return std::string(className, len > 0 ? len : 0);
+}
+
+DWORD Win32Backend::GetWindowPid(HWND hwnd) {
+  DWORD pid = 0;
+  GetWindowThreadProcessId(hwnd, &pid);
+  return pid;
+}
+
+HWND Win32Backend::GetConsole() { return GetConsoleWindow(); }
+
+// ===== GEOMETRÍA Y ORDEN Z =====
+
+bool Win32Backend::GetRect(HWND hwnd, RECT &rect) {
+  return GetWindowRect(hwnd, &rect) != 0;
+}
+
+void Win32Backend::SetPos(HWND hwnd, int x, int y, int w, int h, UINT flags) {
+  SetWindowPos(hwnd, NULL, x, y, w, h, flags);
+}
+
+void Win32Backend::SetPosBatch(const std::vector<WindowPos> &batch) {
+  if (batch.empty())
+    return;
+  HDWP hdwp = BeginDeferWindowPos((int)batch.size());
+  std::vector<bool> deferred(batch.size(), false);
+  for (size_t i = 0; i < batch.size(); ++i) {
+    const WindowPos &p = batch[i];
+    UINT flags = p.flags & ~SWP_ASYNCWINDOWPOS; // No vale en DeferWindowPos
+    if (!hdwp || IsHungAppWindow(p.hwnd)) {
+      // Una app colgada bloquearía EndDeferWindowPos entero: por separado
+      SetWindowPos(p.hwnd, NULL, p.x, p.y, p.w, p.h,
+                   flags | SWP_ASYNCWINDOWPOS);
+      continue;
+    }
+    HDWP next = DeferWindowPos(hdwp, p.hwnd, NULL, p.x, p.y, p.w, p.h, flags);
+    if (next) {
+      hdwp = next;
+      deferred[i] = true;
+      continue;
+    }
+    // Si DeferWindowPos falla el lote se pierde: rehacer lo ya diferido
+    hdwp = NULL;
+    for (size_t j = 0; j <= i; ++j) {
+      if (j == i || deferred[j])
+        SetWindowPos(batch[j].hwnd, NULL, batch[j].x, batch[j].y, batch[j].w,
+                     batch[j].h, batch[j].flags & ~SWP_ASYNCWINDOWPOS);
+    }
+  }
+  if (hdwp)
+    EndDeferWindowPos(hdwp);
+}
+
+void Win32Backend::RestoreWindow(HWND hwnd) { ShowWindow(hwnd, SW_RESTORE); }
+
+void Win32Backend::RaiseWindow(HWND hwnd, bool activate) {
+  SetWindowPos(hwnd, HWND_TOP, 0, 0, 0, 0,
+               SWP_NOMOVE | SWP_NOSIZE | (activate ? 0 : SWP_NOACTIVATE));
+  if (activate)
+    SetForegroundWindow(hwnd);
+}
+
+void Win32Backend::LowerWindow(HWND hwnd) {
+  SetWindowPos(hwnd, HWND_BOTTOM, 0, 0, 0, 0,
+               SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+}
+
+void Win32Backend::SetTopmost(HWND hwnd, bool topmost) {
+  SetWindowPos(hwnd, topmost ? HWND_TOPMOST : HWND_NOTOPMOST, 0, 0, 0, 0,
+               SWP_NOMOVE | SWP_NOSIZE);
+}
+
+void Win32Backend::SetOpacity(HWND hwnd, int alpha) {
+  LONG style = GetWindowLongA(hwnd, GWL_EXSTYLE);
+  if (alpha < 255) {
+    if (!(style & WS_EX_LAYERED))
+      SetWindowLongA(hwnd, GWL_EXSTYLE, style | WS_EX_LAYERED);
+    SetLayeredWindowAttributes(hwnd, 0, (BYTE)alpha, LWA_ALPHA);
+  } else {
+    SetLayeredWindowAttributes(hwnd, 0, 255, LWA_ALPHA);
+    SetWindowLongA(hwnd, GWL_EXSTYLE, style & ~WS_EX_LAYERED);
+  }
+}
+
+// ===== FOCO =====
+
+HWND Win32Backend::GetForeground() { return GetForegroundWindow(); }
+
+void Win32Backend::ActivateWindow(HWND hwnd) {
+  DWORD currentThreadId = GetCurrentThreadId();
+  DWORD targetThreadId = GetWindowThreadProcessId(hwnd, NULL);
+
+  bool attached = false;
+  if (currentThreadId != targetThreadId) {
+    attached = AttachThreadInput(currentThreadId, targetThreadId, TRUE);
+  }
+
+  AllowSetForegroundWindow(ASFW_ANY);
+
+  if (IsIconic(hwnd)) {
+    ShowWindow(hwnd, SW_RESTORE);
+  }
+
+  SetWindowPos(hwnd, HWND_TOP, 0, 0, 0, 0,
+               SWP_NOMOVE | SWP_NOSIZE | SWP_SHOWWINDOW);
+
+  SetForegroundWindow(hwnd);
+  SetActiveWindow(hwnd);
+  BringWindowToTop(hwnd);
+  SetFocus(hwnd);
+
+  if (attached) {
+    AttachThreadInput(currentThreadId, targetThreadId, FALSE);
+  }
+}
+
+void Win32Backend::FlashCaption(HWND hwnd, DWORD timeout) {
+  FLASHWINFO fi;
+  fi.cbSize = sizeof(FLASHWINFO);
+  fi.hwnd = hwnd;
+  fi.dwFlags = FLASHW_CAPTION;
+  fi.uCount = 1;
+  fi.dwTimeout = timeout;
+  FlashWindowEx(&fi);
+}
+
+void Win32Backend::PostClose(HWND hwnd) { PostMessageA(hwnd, WM_CLOSE, 0, 0); }
+
+void Win32Backend::SendTaskView() {
+  INPUT inputs[8] = {0};
+  int n = 0;
+  inputs[n].type = INPUT_KEYBOARD;
+  inputs[n].ki.wVk = VK_CONTROL;
+  inputs[n].ki.dwFlags = KEYEVENTF_KEYUP;
+  n++;
+  inputs[n].type = INPUT_KEYBOARD;
+  inputs[n].ki.wVk = VK_MENU;
+  inputs[n].ki.dwFlags = KEYEVENTF_KEYUP;
+  n++;
+  inputs[n].type = INPUT_KEYBOARD;
+  inputs[n].ki.wVk = VK_LWIN;
+  n++;
+  inputs[n].type = INPUT_KEYBOARD;
+  inputs[n].ki.wVk = VK_TAB;
+  n++;
+  inputs[n].type = INPUT_KEYBOARD;
+  inputs[n].ki.wVk = VK_TAB;
+  inputs[n].ki.dwFlags = KEYEVENTF_KEYUP;
+  n++;
+  inputs[n].type = INPUT_KEYBOARD;
+  inputs[n].ki.wVk = VK_LWIN;
+  inputs[n].ki.dwFlags = KEYEVENTF_KEYUP;
+  n++;
+  SendInput(n, inputs, sizeof(INPUT));
+}
+
+bool Win32Backend::GetCursorPoint(POINT &pt) { return GetCursorPos(&pt) != 0; }
+
+// ===== MONITORES =====
+
+// GetDpiForMonitor está en shcore.dll (Windows 8.1+): se carga al vuelo
+// para seguir arrancando en sistemas sin ella
+typedef HRESULT(WINAPI *GetDpiForMonitorFn)(HMONITOR, int, UINT *, UINT *);
+
+static UINT MonitorDpi(HMONITOR hm) {
+  static GetDpiForMonitorFn getDpi = []() -> GetDpiForMonitorFn {
+    HMODULE shcore = LoadLibraryA("shcore.dll");
+    return shcore ? reinterpret_cast<GetDpiForMonitorFn>(
+                        GetProcAddress(shcore, "GetDpiForMonitor"))
+                  : nullptr;
+  }();
+  UINT dpiX = 0, dpiY = 0;
+  if (getDpi && SUCCEEDED(getDpi(hm, 0 /* MDT_EFFECTIVE_DPI */, &dpiX, &dpiY)))
+    return dpiX;
+  // Sin DPI por monitor: el del sistema, igual en todos
+  HDC screen = GetDC(NULL);
+  UINT dpi = screen ? (UINT)GetDeviceCaps(screen, LOGPIXELSX) : 96;
+  if (screen)
+    ReleaseDC(NULL, screen);
+  return dpi ? dpi : 96;
+}
+
+static bool DescribeMonitor(HMONITOR hm, MonitorDesc &out) {
+  MONITORINFO mi = {sizeof(mi)};
+  if (!GetMonitorInfoA(hm, &mi))
+    return false;
+  out.handle = hm;
+  out.rcMonitor = mi.rcMonitor;
+  out.rcWork = mi.rcWork;
+  out.primary = (mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
+  out.dpi = MonitorDpi(hm);
+  return true;
+}
+
+static BOOL CALLBACK CollectMonitorsProc(HMONITOR hm, HDC hdc, LPRECT lr,
+                                         LPARAM d) {
+  MonitorDesc desc;
+  if (DescribeMonitor(hm, desc))
+    reinterpret_cast<std::vector<MonitorDesc> *>(d)->push_back(desc);
+  return TRUE;
+}
+
+void Win32Backend::ListMonitors(std::vector<MonitorDesc> &out) {
+  out.clear();
+  EnumDisplayMonitors(NULL, NULL, CollectMonitorsProc, (LPARAM)&out);
+}
+
+bool Win32Backend::GetMonitorForWindow(HWND hwnd, MonitorDesc &out) {
+  HMONITOR hm = MonitorFromWindow(hwnd ? hwnd : GetDesktopWindow(),
+                                  MONITOR_DEFAULTTONEAREST);
+  return DescribeMonitor(hm, out);
+}
+
+bool Win32Backend::GetMonitorForPoint(POINT pt, MonitorDesc &out) {
+  return DescribeMonitor(MonitorFromPoint(pt, MONITOR_DEFAULTTONEAREST), out);
+}
+
+HMONITOR Win32Backend::MonitorHandleForWindow(HWND hwnd) {
+  return MonitorFromWindow(hwnd ? hwnd : GetDesktopWindow(),
+                           MONITOR_DEFAULTTONEAREST);
+}
+
+// ===== PROCESOS =====
+
+void Win32Backend::ListProcesses(std::vector<ProcessDesc> &out) {
+  out.clear();
+  HANDLE hSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+  if (hSnap == INVALID_HANDLE_VALUE)
+    return;
+
+  PROCESSENTRY32 pe32;
+  pe32.dwSize = sizeof(PROCESSENTRY32);
+  if (Process32First(hSnap, &pe32)) {
+    do {
+      ProcessDesc desc;
+      desc.pid = pe32.th32ProcessID;
+      desc.exeName = pe32.szExeFile;
+      out.push_back(desc);
+    } while (Process32Next(hSnap, &pe32));
+  }
+  CloseHandle(hSnap);
+}
+
+bool Win32Backend::TerminatePid(DWORD pid) {
+  HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, pid);
+  if (!hProcess)
+    return false;
+  BOOL ok = TerminateProcess(hProcess, 0);
+  CloseHandle(hProcess);
+  return ok != 0;
+}
+
+DWORD Win32Backend::CurrentPid() { return GetCurrentProcessId(); }
+
+// ===== SHELL Y SISTEMA =====
+
+void Win32Backend::LaunchPath(const std::string &path) {
+  ShellExecuteA(NULL, "open", path.c_str(), NULL, NULL, SW_SHOWNORMAL);
+}
+
+static std::string ResolveShortcut(const std::string &shortcutPath) {
+  HRESULT hres;
+  IShellLinkA *psl;
+  char szPath[MAX_PATH];
+  szPath[0] = '\0';
+
+  hres = CoCreateInstance(CLSID_ShellLink, NULL, CLSCTX_INPROC_SERVER,
+                          IID_IShellLinkA, (LPVOID *)&psl);
+  if (SUCCEEDED(hres)) {
+    IPersistFile *ppf;
+    hres = psl->QueryInterface(IID_IPersistFile, (LPVOID *)&ppf);
+    if (SUCCEEDED(hres)) {
+      WCHAR wsz[MAX_PATH];
+      MultiByteToWideChar(CP_ACP, 0, shortcutPath.c_str(), -1, wsz, MAX_PATH);
+      hres = ppf->Load(wsz, STGM_READ);
+      if (SUCCEEDED(hres)) {
+        psl->GetPath(szPath, MAX_PATH, NULL, SLGP_RAWPATH);
+      }
+      ppf->Release();
+    }
+    psl->Release();
+  }
+  return std::string(szPath);
+}
+
+static void ScanLnkFiles(const std::string &directory,
+                         std::vector<DiscoveryApp> &apps) {
+  std::string searchPath = directory + "\\*";
+  WIN32_FIND_DATAA fd;
+  HANDLE hFind = FindFirstFileA(searchPath.c_str(), &fd);
+
+  if (hFind != INVALID_HANDLE_VALUE) {
+    do {
+      if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        if (strcmp(fd.cFileName, ".") != 0 && strcmp(fd.cFileName, "..") != 0) {
+          ScanLnkFiles(directory + "\\" + fd.cFileName, apps);
+        }
+      } else {
+        std::string filename = fd.cFileName;
+        if (filename.length() > 4 &&
+            filename.substr(filename.length() - 4) == ".lnk") {
+          std::string fullPath = directory + "\\" + filename;
+          std::string target = ResolveShortcut(fullPath);
+          if (!target.empty() && target.substr(target.length() - 4) == ".exe") {
+            DiscoveryApp app;
+            app.name = filename.substr(0, filename.length() - 4);
+            app.path = target;
+            apps.push_back(app);
+          }
+        }
+      }
+    } while (FindNextFileA(hFind, &fd));
+    FindClose(hFind);
+  }
+}
+
+std::vector<DiscoveryApp> Win32Backend::DiscoverApps() {
+  std::vector<DiscoveryApp> apps;
+  char path[MAX_PATH];
+
+  // Menu de inicio (Usuario)
+  if (SHGetSpecialFolderPathA(NULL, path, CSIDL_PROGRAMS, FALSE)) {
+    ScanLnkFiles(path, apps);
+  }
+
+  // Menu de inicio (Global)
+  if (SHGetSpecialFolderPathA(NULL, path, CSIDL_COMMON_PROGRAMS, FALSE)) {
+    ScanLnkFiles(path, apps);
+  }
+
+  // Desktop (Global)
+  if (SHGetSpecialFolderPathA(NULL, path, CSIDL_COMMON_DESKTOPDIRECTORY,
+                              FALSE)) {
+    ScanLnkFiles(path, apps);
+  }
+
+  return apps;
+}
+
+void Win32Backend::SetAutoStart(bool enabled) {
+  HKEY hKey;
+  if (RegOpenKeyExA(HKEY_CURRENT_USER,
+                    "Software\\Microsoft\\Windows\\CurrentVersion\\Run", 0,
+                    KEY_SET_VALUE, &hKey) == ERROR_SUCCESS) {
+    if (enabled) {
+      char path[MAX_PATH];
+      GetModuleFileNameA(NULL, path, MAX_PATH);
+      RegSetValueExA(hKey, "WinVen", 0, REG_SZ, (BYTE *)path,
+                     (DWORD)(strlen(path) + 1));
+    } else {
+      RegDeleteValueA(hKey, "WinVen");
+    }
+    RegCloseKey(hKey);
+  }
+}
+
+// ===== GAME MODE INDICATOR =====
+
+static LRESULT CALLBACK GameModeWndProc(HWND hwnd, UINT msg, WPARAM wParam,
+                                        LPARAM lParam) {
+  if (msg == WM_PAINT) {
+    PAINTSTRUCT ps;
+    HDC hdc = BeginPaint(hwnd, &ps);
+    RECT r;
+    GetClientRect(hwnd, &r);
+
+    // Transparent background text
+    SetBkMode(hdc, TRANSPARENT);
+    SetTextColor(hdc, RGB(0, 255, 0)); // Green text for visibility
+
+    HFONT hFont =
+        CreateFontA(16, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE, ANSI_CHARSET,
+                    OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY,
+                    DEFAULT_PITCH | FF_SWISS, "Arial");
+    HFONT hOldFont = (HFONT)SelectObject(hdc, hFont);
+
+    TextOutA(hdc, 2, 0, "JUEGO", 5);
+
+    SelectObject(hdc, hOldFont);
+    DeleteObject(hFont);
+    EndPaint(hwnd, &ps);
+    return 0;
+  }
+  // Handle destruction to avoid zombie window classes if needed, though we use
+  // a static class
+  return DefWindowProcA(hwnd, msg, wParam, lParam);
+}
+
+void Win32Backend::ShowGameIndicator() {
+  if (gameModeIndicatorHwnd && IsWindow(gameModeIndicatorHwnd))
+    return;
+
+  static bool classRegistered = false;
+  const char *className = "GameModeIndClass";
+
+  if (!classRegistered) {
+    WNDCLASSEXA wc = {0};
+    wc.cbSize = sizeof(WNDCLASSEXA);
+    wc.lpfnWndProc = GameModeWndProc;
+    wc.hInstance = GetModuleHandle(NULL);
+    wc.lpszClassName = className;
+    wc.hbrBackground = (HBRUSH)GetStockObject(NULL_BRUSH);
+    wc.hCursor = LoadCursor(NULL, IDC_ARROW);
+    RegisterClassExA(&wc);
+    classRegistered = true;
+  }
+
+  // Create a layered window at top-left
+  gameModeIndicatorHwnd = CreateWindowExA(
+      WS_EX_TOPMOST | WS_EX_TOOLWINDOW | WS_EX_LAYERED | WS_EX_TRANSPARENT,
+      className, "GameMode", WS_POPUP | WS_VISIBLE, 5, 5, 60, 20, // x, y, w, h
+      NULL, NULL, GetModuleHandle(NULL), NULL);
+
+  // Set window opacity
+  SetLayeredWindowAttributes(gameModeIndicatorHwnd, 0, 255, LWA_ALPHA);
+
+  SetWindowPos(gameModeIndicatorHwnd, HWND_TOPMOST, 0, 0, 0, 0,
+               SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+}
+
+void Win32Backend::HideGameIndicator() {
+  if (gameModeIndicatorHwnd) {
+    if (IsWindow(gameModeIndicatorHwnd))
+      DestroyWindow(gameModeIndicatorHwnd);
+    gameModeIndicatorHwnd = NULL;
+  }
+}
+
+// ===== HOTKEYS =====
+
+bool Win32Backend::RegisterSystemHotkey(HWND owner, int id, UINT modifiers,
+                                        UINT vk) {
+  return RegisterHotKey(owner, id, modifiers, vk) != 0;
+}
+
+void Win32Backend::UnregisterSystemHotkey(HWND owner, int id) {
+  UnregisterHotKey(owner, id);
+}
+
+UINT_PTR Win32Backend::StartTimer(HWND owner, UINT_PTR id, UINT ms) {
+  UINT_PTR result = SetTimer(owner, id, ms, NULL);
+  // Con ventana, SetTimer devuelve un valor no nulo pero el id es el pedido
+  return owner && result ? id : result;
+}
+
+void Win32Backend::StopTimer(HWND owner, UINT_PTR id) { KillTimer(owner, id); }
+
+// ===== TIEMPO =====
+
+DWORD Win32Backend::TickCount() { return GetTickCount(); }
+
+void Win32Backend::SleepMs(int ms) { Sleep(ms); }
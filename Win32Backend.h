@@ -0,0 +1,78 @@
+#ifndef WIN32_BACKEND_H
+#define WIN32_BACKEND_H
+
+#include "DesktopBackend.h"
+
+/**
+ * @brief Implementación de DesktopBackend sobre la API Win32
+ */
+class Win32Backend : public DesktopBackend {
+private:
+  HWND gameModeIndicatorHwnd = NULL;
+  HWND notifyHwnd = NULL; // Ventana oculta para WM_DISPLAYCHANGE
+  DesktopEventSink *eventSink = nullptr;
+  HWINEVENTHOOK winEventHooks[6] = {NULL, NULL, NULL, NULL, NULL, NULL};
+
+  static LRESULT CALLBACK NotifyWndProc(HWND hwnd, UINT msg, WPARAM wParam,
+                                        LPARAM lParam);
+  static void CALLBACK WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                    LONG idObject, LONG idChild,
+                                    DWORD eventThread, DWORD eventTime);
+  bool InstallWinEventHooks();
+  void RemoveWinEventHooks();
+
+public:
+  bool SetEventSink(DesktopEventSink *sink) override;
+
+  void ListTopLevelWindows(std::vector<HWND> &out) override;
+  bool IsAlive(HWND hwnd) override;
+  bool IsVisible(HWND hwnd) override;
+  bool IsCloaked(HWND hwnd) override;
+  LONG GetStyle(HWND hwnd) override;
+  LONG GetExStyle(HWND hwnd) override;
+  std::string GetTitle(HWND hwnd) override;
+  std::string GetClass(HWND hwnd) override;
+  DWORD GetWindowPid(HWND hwnd) override;
+  HWND GetConsole() override;
+
+  bool GetRect(HWND hwnd, RECT &rect) override;
+  void SetPos(HWND hwnd, int x, int y, int w, int h, UINT flags) override;
+  void SetPosBatch(const std::vector<WindowPos> &batch) override;
+  void RestoreWindow(HWND hwnd) override;
+  void RaiseWindow(HWND hwnd, bool activate) override;
+  void LowerWindow(HWND hwnd) override;
+  void SetTopmost(HWND hwnd, bool topmost) override;
+  void SetOpacity(HWND hwnd, int alpha) override;
+
+  HWND GetForeground() override;
+  void ActivateWindow(HWND hwnd) override;
+  void FlashCaption(HWND hwnd, DWORD timeout) override;
+  void PostClose(HWND hwnd) override;
+  void SendTaskView() override;
+  bool GetCursorPoint(POINT &pt) override;
+
+  void ListMonitors(std::vector<MonitorDesc> &out) override;
+  bool GetMonitorForWindow(HWND hwnd, MonitorDesc &out) override;
+  bool GetMonitorForPoint(POINT pt, MonitorDesc &out) override;
+  HMONITOR MonitorHandleForWindow(HWND hwnd) override;
+
+  void ListProcesses(std::vector<ProcessDesc> &out) override;
+  bool TerminatePid(DWORD pid) override;
+  DWORD CurrentPid() override;
+
+  void LaunchPath(const std::string &path) override;
+  std::vector<DiscoveryApp> DiscoverApps() override;
+  void SetAutoStart(bool enabled) override;
+  void ShowGameIndicator() override;
+  void HideGameIndicator() override;
+  bool RegisterSystemHotkey(HWND owner, int id, UINT modifiers,
+                            UINT vk) override;
+  void UnregisterSystemHotkey(HWND owner, int id) override;
+  UINT_PTR StartTimer(HWND owner, UINT_PTR id, UINT ms) override;
+  void StopTimer(HWND owner, UINT_PTR id) override;
+
+  DWORD TickCount() override;
+  void SleepMs(int ms) override;
+};
+
+#endif // WIN32_BACKEND_H
@@ -0,0 +1,97 @@
+#ifndef WIN_COMPAT_H
+#define WIN_COMPAT_H
+
+/**
+ * @brief Tipos básicos de Win32 para compilar la lógica fuera de Windows
+ *
+ * En Windows simplemente incluye <windows.h>. En otras plataformas define el
+ * subconjunto mínimo (handles, RECT, POINT, MOD_*, SWP_*, estilos) que usan
+ * WindowManager y los módulos neutrales, para poder compilarlos contra el
+ * escritorio simulado (FakeDesktop) en Linux.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdint>
+
+typedef struct HWND__ *HWND;
+typedef struct HMONITOR__ *HMONITOR;
+typedef unsigned long DWORD;
+typedef unsigned int UINT;
+typedef long LONG;
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef uintptr_t UINT_PTR;
+
+struct RECT {
+  LONG left;
+  LONG top;
+  LONG right;
+  LONG bottom;
+};
+
+struct POINT {
+  LONG x;
+  LONG y;
+};
+
+#ifndef NULL
+#define NULL 0
+#endif
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+// Modificadores de RegisterHotKey
+#define MOD_ALT 0x0001
+#define MOD_CONTROL 0x0002
+#define MOD_SHIFT 0x0004
+#define MOD_WIN 0x0008
+
+// Códigos de tecla virtuales (los que nombran hotkeys y el control WASD)
+#define VK_BACK 0x08
+#define VK_TAB 0x09
+#define VK_RETURN 0x0D
+#define VK_SHIFT 0x10
+#define VK_CONTROL 0x11
+#define VK_MENU 0x12
+#define VK_ESCAPE 0x1B
+#define VK_SPACE 0x20
+#define VK_PRIOR 0x21
+#define VK_NEXT 0x22
+#define VK_END 0x23
+#define VK_HOME 0x24
+#define VK_LEFT 0x25
+#define VK_UP 0x26
+#define VK_RIGHT 0x27
+#define VK_DOWN 0x28
+#define VK_INSERT 0x2D
+#define VK_DELETE 0x2E
+#define VK_LSHIFT 0xA0
+#define VK_RSHIFT 0xA1
+#define VK_LCONTROL 0xA2
+#define VK_RCONTROL 0xA3
+#define VK_LMENU 0xA4
+#define VK_RMENU 0xA5
+
+// Flags de SetWindowPos
+#define SWP_NOSIZE 0x0001
+#define SWP_NOMOVE 0x0002
+#define SWP_NOZORDER 0x0004
+#define SWP_NOACTIVATE 0x0010
+#define SWP_SHOWWINDOW 0x0040
+#define SWP_ASYNCWINDOWPOS 0x4000
+
+// Estilos de ventana
+#define WS_CHILD 0x40000000L
+#define WS_CAPTION 0x00C00000L
+#define WS_EX_TOPMOST 0x00000008L
+#define WS_EX_LAYERED 0x00080000L
+
+#endif // _WIN32
+
+#endif // WIN_COMPAT_H
@@ -1,24 +1,64 @@
 #include "WindowManager.h"
+#include "HotkeyManager.h"
+#include "Logger.h"
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
-#include <objbase.h>
-#include <set>
-#include <shellapi.h>
-#include <shlobj.h>
-#include <shlwapi.h>
 #include <sstream>
-#include <tlhelp32.h>
 
 #include <ctime>
-#include <fstream>
 
-WindowManager::WindowManager(const std::string &configPath)
-    : configFile(configPath) {
+static PixelRect ToPixelRect(const RECT &r) {
+  return {(int)r.left, (int)r.top, (int)(r.right - r.left),
+          (int)(r.bottom - r.top)};
+}
+
+WindowManager::WindowManager(const std::string &configPath,
+                             DesktopBackend *desktop)
+    : backend(desktop ? desktop : DesktopBackend::Native()),
+      configFile(configPath),
+      registry(backend, [this](HWND hwnd) { return IsExcluded(hwnd); }),
+      processCache(backend), moveDispatcher(backend),
+      animator(backend, true, &moveDispatcher) {
+  registry.SetLive(backend->SetEventSink(this));
   InitializePositions25();
+
+  // Whitelist de procesos del sistema y esenciales (nombres exactos)
+  essentialApps.Compile({"=explorer.exe",
+                         "=svchost.exe",
+                         "=csrss.exe",
+                         "=wininit.exe",
+                         "=services.exe",
+                         "=lsass.exe",
+                         "=winlogon.exe",
+                         "=dwm.exe",
+                         "=smss.exe",
+                         "=taskhostw.exe",
+                         "=RuntimeBroker.exe",
+                         "=sihost.exe",
+                         "=ctfmon.exe",
+                         "=smartscreen.exe",
+                         "=conhost.exe",
+                         "=System",
+                         "=registry",
+                         "=audiodg.exe",
+                         "=spoolsv.exe",
+                         "=dasHost.exe",
+                         "=SearchUI.exe",
+                         "=ShellExperienceHost.exe",
+                         "=StandardCollector.Service.exe",
+                         "=WmiPrvSE.exe",
+                         "=Memory Compression",
+                         "=ntoskrnl.exe",
+                         "=gestor_ven.exe",
+                         "=ConfiguracionWinVen.exe",
+                         "=cmd.exe"});
+
   LoadConfig();
+  CompileExclusions();
   if (layouts.empty()) {
     CreateDefaultLayouts();
     CreateDefaultAppShortcuts();
@@ -27,19 +67,22 @@ WindowManager::WindowManager(const std::string &configPath)
 }
 
 bool WindowManager::RegisterAllHotkeys(HWND messageWindow) {
+  std::lock_guard<std::mutex> lock(catalogMutex);
   bool success = true;
   for (size_t i = 0; i < layouts.size(); ++i) {
     if (layouts[i].hotkey != 0) {
-      if (!RegisterHotKey(messageWindow, 200 + i, MOD_CONTROL | MOD_ALT,
-                          layouts[i].hotkey)) {
+      if (!backend->RegisterSystemHotkey(messageWindow, 200 + i,
+                                         MOD_CONTROL | MOD_ALT,
+                                         layouts[i].hotkey)) {
         success = false;
       }
     }
   }
   for (size_t i = 0; i < appShortcuts.size(); ++i) {
     if (appShortcuts[i].hotkey != 0) {
-      if (!RegisterHotKey(messageWindow, 300 + i, appShortcuts[i].modifier,
-                          appShortcuts[i].hotkey)) {
+      if (!backend->RegisterSystemHotkey(messageWindow, 300 + i,
+                                         appShortcuts[i].modifier,
+                                         appShortcuts[i].hotkey)) {
         success = false;
       } else {
       }
@@ -48,325 +91,510 @@ bool WindowManager::RegisterAllHotkeys(HWND messageWindow) {
   return success;
 }
 
-WindowManager::~WindowManager() { UnregisterAllHotkeys(); }
+WindowManager::~WindowManager() {
+  UnregisterAllHotkeys();
+  backend->SetEventSink(nullptr);
+}
+
+RECT WindowManager::GetWorkArea(HWND hwnd) {
+  MonitorDesc mon;
+  if (!GetMonitorFor(hwnd, mon)) {
+    RECT empty = {0, 0, 0, 0};
+    return empty;
+  }
+  return mon.rcWork;
+}
+
+// ===== MONITORES =====
+
+void WindowManager::EnsureTopology() {
+  if (!topologyDirty.exchange(false))
+    return;
+  std::vector<MonitorDesc> monitors;
+  backend->ListMonitors(monitors);
+  topology.Rebuild(monitors);
+}
+
+int WindowManager::TopologyIndexFor(HWND hwnd) {
+  EnsureTopology();
+  RECT r;
+  if (hwnd && backend->GetRect(hwnd, r))
+    return topology.IndexForRect(r);
+  return topology.Primary(); // Como MonitorFromWindow del escritorio
+}
+
+bool WindowManager::GetMonitorFor(HWND hwnd, MonitorDesc &out) {
+  std::lock_guard<std::mutex> lock(topologyMutex);
+  int index = TopologyIndexFor(hwnd);
+  if (index < 0)
+    return false;
+  out = topology.At(index);
+  return true;
+}
+
+bool WindowManager::GetMonitorAt(POINT pt, MonitorDesc &out) {
+  std::lock_guard<std::mutex> lock(topologyMutex);
+  EnsureTopology();
+  int index = topology.IndexAt(pt);
+  if (index < 0)
+    return false;
+  out = topology.At(index);
+  return true;
+}
+
+// ===== TABLA DE LAYOUTS =====
+
+void WindowManager::OnDisplayChanged() {
+  topologyDirty = true;
+  layoutTableDirty = true;
+  {
+    std::lock_guard<std::mutex> lock(spatialMutex);
+    spatialSeeded = false; // Otros límites y otros rectángulos
+  }
+  if (autoTiling)
+    RebuildTiling();
+}
+
+void WindowManager::OnWindowEvent(HWND hwnd, WindowEvent event) {
+  registry.OnWindowEvent(hwnd, event);
+  TrackFocus(hwnd, event);
+  TrackGeometry(hwnd, event);
+  if (event == WE_DESTROYED) {
+    animator.Cancel(hwnd);
+    EvictRecord(hwnd);
+  }
+  else if (event == WE_FOREGROUND)
+    SelectKeymapProfile(hwnd);
+  if (autoTiling && event != WE_FOREGROUND && event != WE_TITLE_CHANGED &&
+      event != WE_MOVED)
+    SyncAutoTiling(hwnd);
+}
+
+void WindowManager::SelectKeymapProfile(HWND foreground) {
+  if (keymapProfiles.Empty())
+    return;
+
+  const KeymapProfile *profile;
+  {
+    std::lock_guard<std::mutex> lock(processCacheMutex);
+    const ProcessCache::Info *proc =
+        foreground ? processCache.Lookup(backend->GetWindowPid(foreground))
+                   : nullptr;
+    std::string className, title;
+    if (foreground && keymapProfiles.NeedsClass())
+      className = backend->GetClass(foreground);
+    if (foreground && keymapProfiles.NeedsTitle())
+      title = backend->GetTitle(foreground);
+    static const std::string noExe;
+    profile = keymapProfiles.Select(proc ? proc->lowerName : noExe,
+                                    &className, &title);
+  }
+  if (keymapProfiles.Activate(profile))
+    LOG_DEBUG("Perfil de teclado: " + profile->name);
+  // Los atajos que el perfil desactiva dejan de estar registrados: la
+  // combinación le llega a la app (sin cambios no toca el sistema)
+  if (profileHotkeys)
+    profileHotkeys->SetProfile(profile);
+}
+
+void WindowManager::SetProfileHotkeys(HotkeyManager *hotkeys) {
+  profileHotkeys = hotkeys;
+  if (profileHotkeys)
+    profileHotkeys->SetProfile(keymapProfiles.Active());
+}
+
+void WindowManager::SetMargin(int m) {
+  margin = m;
+  layoutTableDirty = true;
+  if (autoTiling)
+    RebuildTiling();
+}
+
+void WindowManager::EnsureLayoutTable() {
+  if (!layoutTableDirty.exchange(false))
+    return;
+  std::lock_guard<std::mutex> lock(topologyMutex);
+  EnsureTopology();
+  std::lock_guard<std::mutex> catalog(catalogMutex);
+  layoutTable.Rebuild(topology.Monitors(), layouts, positions25, margin);
+}
+
+bool WindowManager::ResolveRect(HWND hwnd, bool position25, int index,
+                                PixelRect &out) {
+  std::lock_guard<std::mutex> lock(layoutTableMutex);
+  EnsureLayoutTable();
+  MonitorDesc desc;
+  int mon = GetMonitorFor(hwnd, desc) ? layoutTable.FindMonitor(desc.handle)
+                                      : -1;
+  const PixelRect *cached = position25 ? layoutTable.PositionRect(mon, index)
+                                       : layoutTable.LayoutRect(mon, index);
+  if (cached) {
+    out = *cached;
+    return true;
+  }
 
-MONITORINFO WindowManager::GetMonInfo(HWND hwnd) {
-  HMONITOR monitor = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
-  MONITORINFO mi = {sizeof(mi)};
-  ::GetMonitorInfo(monitor, &mi);
-  return mi;
+  // Monitor desconocido (evento aún no recibido): cálculo directo
+  WindowLayout layout;
+  {
+    std::lock_guard<std::mutex> catalog(catalogMutex);
+    const std::vector<WindowLayout> &source =
+        position25 ? positions25 : layouts;
+    if (index < 0 || index >= (int)source.size())
+      return false;
+    layout = source[index];
+  }
+  out = LayoutTable::Compute(GetWorkArea(hwnd), layout, margin);
+  layoutTableDirty = true;
+  return true;
 }
 
 void WindowManager::AddLayout(const WindowLayout &layout) {
+  std::lock_guard<std::mutex> lock(catalogMutex);
   layouts.push_back(layout);
+  layoutTableDirty = true;
   if (layout.hotkey != 0) {
     hotkeyToLayoutIndex[layout.hotkey] = layouts.size() - 1;
   }
 }
 
 void WindowManager::AddAppShortcut(const AppShortcut &app) {
-  appShortcuts.push_back(app);
-  if (app.hotkey != 0) {
-    hotkeyToAppIndex[app.hotkey] = appShortcuts.size() - 1;
+  {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    appShortcuts.push_back(app);
+    if (app.hotkey != 0) {
+      hotkeyToAppIndex[app.hotkey] = appShortcuts.size() - 1;
+    }
   }
   SaveConfig();
 }
 
 void WindowManager::ExecuteAppShortcut(int hotkey) {
-  auto it = hotkeyToAppIndex.find(hotkey);
-  if (it != hotkeyToAppIndex.end()) {
-    ExecuteAppShortcutByIndex(it->second);
+  int index = -1;
+  {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    auto it = hotkeyToAppIndex.find(hotkey);
+    if (it != hotkeyToAppIndex.end())
+      index = it->second;
+  }
+  if (index >= 0) {
+    ExecuteAppShortcutByIndex(index);
   }
 }
 
 void WindowManager::ExecuteAppShortcutByIndex(int index) {
-  if (index >= 0 && index < (int)appShortcuts.size()) {
-    const AppShortcut &app = appShortcuts[index];
-    ShellExecuteA(NULL, "open", app.path.c_str(), NULL, NULL, SW_SHOWNORMAL);
-    PlaySoundEffect(600, 100);
-    std::cout << "[INFO] Ejecutando app: " << app.name << " (" << app.path
-              << ")" << std::endl;
+  // Copia: el lanzamiento puede tardar y la GUI puede borrar el acceso
+  AppShortcut app;
+  {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    if (index < 0 || index >= (int)appShortcuts.size())
+      return;
+    app = appShortcuts[index];
   }
+  backend->LaunchPath(app.path);
+  PlaySoundEffect(600, 100);
+  std::cout << "[INFO] Ejecutando app: " << app.name << " (" << app.path
+            << ")" << std::endl;
 }
 
 void WindowManager::RemoveAppShortcut(int index) {
-  if (index >= 0 && index < (int)appShortcuts.size()) {
-    int hotkey = appShortcuts[index].hotkey;
-    if (hotkey != 0) {
-      hotkeyToAppIndex.erase(hotkey);
-    }
-    appShortcuts.erase(appShortcuts.begin() + index);
-  }
-  SaveConfig();
-}
-
-std::string ResolveShortcut(const std::string &shortcutPath) {
-  HRESULT hres;
-  IShellLinkA *psl;
-  char szPath[MAX_PATH];
-  szPath[0] = '\0';
-
-  hres = CoCreateInstance(CLSID_ShellLink, NULL, CLSCTX_INPROC_SERVER,
-                          IID_IShellLinkA, (LPVOID *)&psl);
-  if (SUCCEEDED(hres)) {
-    IPersistFile *ppf;
-    hres = psl->QueryInterface(IID_IPersistFile, (LPVOID *)&ppf);
-    if (SUCCEEDED(hres)) {
-      WCHAR wsz[MAX_PATH];
-      MultiByteToWideChar(CP_ACP, 0, shortcutPath.c_str(), -1, wsz, MAX_PATH);
-      hres = ppf->Load(wsz, STGM_READ);
-      if (SUCCEEDED(hres)) {
-        psl->GetPath(szPath, MAX_PATH, NULL, SLGP_RAWPATH);
+  {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    if (index >= 0 && index < (int)appShortcuts.size()) {
+      int hotkey = appShortcuts[index].hotkey;
+      if (hotkey != 0) {
+        hotkeyToAppIndex.erase(hotkey);
       }
-      ppf->Release();
+      appShortcuts.erase(appShortcuts.begin() + index);
     }
-    psl->Release();
-  }
-  return std::string(szPath);
-}
-
-void ScanLnkFiles(const std::string &directory,
-                  std::vector<DiscoveryApp> &apps) {
-  std::string searchPath = directory + "\\*";
-  WIN32_FIND_DATAA fd;
-  HANDLE hFind = FindFirstFileA(searchPath.c_str(), &fd);
-
-  if (hFind != INVALID_HANDLE_VALUE) {
-    do {
-      if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
-        if (strcmp(fd.cFileName, ".") != 0 && strcmp(fd.cFileName, "..") != 0) {
-          ScanLnkFiles(directory + "\\" + fd.cFileName, apps);
-        }
-      } else {
-        std::string filename = fd.cFileName;
-        if (filename.length() > 4 &&
-            filename.substr(filename.length() - 4) == ".lnk") {
-          std::string fullPath = directory + "\\" + filename;
-          std::string target = ResolveShortcut(fullPath);
-          if (!target.empty() && target.substr(target.length() - 4) == ".exe") {
-            DiscoveryApp app;
-            app.name = filename.substr(0, filename.length() - 4);
-            app.path = target;
-            apps.push_back(app);
-          }
-        }
-      }
-    } while (FindNextFileA(hFind, &fd));
-    FindClose(hFind);
   }
+  SaveConfig();
 }
 
 std::vector<DiscoveryApp> WindowManager::DiscoverSystemApps() {
-  std::vector<DiscoveryApp> apps;
-  char path[MAX_PATH];
-
-  // Menu de inicio (Usuario)
-  if (SHGetSpecialFolderPathA(NULL, path, CSIDL_PROGRAMS, FALSE)) {
-    ScanLnkFiles(path, apps);
-  }
-
-  // Menu de inicio (Global)
-  if (SHGetSpecialFolderPathA(NULL, path, CSIDL_COMMON_PROGRAMS, FALSE)) {
-    ScanLnkFiles(path, apps);
-  }
-
-  // Desktop (Global)
-  if (SHGetSpecialFolderPathA(NULL, path, CSIDL_COMMON_DESKTOPDIRECTORY,
-                              FALSE)) {
-    ScanLnkFiles(path, apps);
-  }
-
-  return apps;
+  return backend->DiscoverApps();
 }
 
 void WindowManager::RemoveLayout(int index) {
+  std::lock_guard<std::mutex> lock(catalogMutex);
   if (index >= 0 && index < (int)layouts.size()) {
     int hotkey = layouts[index].hotkey;
     if (hotkey != 0) {
       hotkeyToLayoutIndex.erase(hotkey);
     }
     layouts.erase(layouts.begin() + index);
+    layoutTableDirty = true;
   }
 }
 
-WindowLayout &WindowManager::GetLayout(int index) { return layouts[index]; }
+WindowLayout WindowManager::GetLayout(int index) const {
+  std::lock_guard<std::mutex> lock(catalogMutex);
+  if (index < 0 || index >= (int)layouts.size())
+    return WindowLayout();
+  return layouts[index];
+}
 
 void WindowManager::ApplyLayout(HWND hwnd, int layoutIndex) {
   // ✅ Validación de HWND para prevenir crashes
-  if (!hwnd || !IsWindow(hwnd)) {
+  if (!hwnd || !backend->IsAlive(hwnd)) {
     return;
   }
 
-  if (layoutIndex < 0 || layoutIndex >= (int)layouts.size()) {
+  // ResolveRect comprueba el índice con la tabla de layouts
+  PixelRect rect;
+  if (!ResolveRect(hwnd, false, layoutIndex, rect))
     return;
-  }
 
-  WindowLayout &layout = layouts[layoutIndex];
-  MONITORINFO mi = GetMonInfo(hwnd);
-  RECT workArea = mi.rcWork;
-
-  int screenW = workArea.right - workArea.left;
-  int screenH = workArea.bottom - workArea.top;
-
-  int baseX = workArea.left + (int)(screenW * layout.x);
-  int baseY = workArea.top + (int)(screenH * layout.y);
-  int baseW = (int)(screenW * layout.width);
-  int baseH = (int)(screenH * layout.height);
-
-  int posX = baseX + margin;
-  int posY = baseY + margin;
-  int width = baseW - (margin * 2);
-  int height = baseH - (margin * 2);
-
-  if (width < 100)
-    width = 100;
-  if (height < 100)
-    height = 100;
-
-  ShowWindow(hwnd, SW_RESTORE);
-  SmoothMoveWindow(hwnd, posX, posY, width, height);
+  SaveCurrentState(hwnd);
+  backend->RestoreWindow(hwnd);
+  SmoothMoveWindow(hwnd, rect.x, rect.y, rect.w, rect.h);
 }
 
 void WindowManager::CyclePosition25(HWND hwnd) {
   // ✅ Validación de HWND
-  if (!hwnd || !IsWindow(hwnd) || positions25.empty())
+  if (!hwnd || !backend->IsAlive(hwnd) || positions25.empty())
     return;
 
   SaveCurrentState(hwnd);
 
-  if (windowCycleIndex.find(hwnd) == windowCycleIndex.end()) {
-    windowCycleIndex[hwnd] = 0;
+  // Las acciones de una misma ventana van en serie; el mutex protege los
+  // registros de las que corren a la vez sobre otras ventanas
+  int cycleIdx;
+  {
+    std::lock_guard<std::mutex> lock(windowStateMutex);
+    cycleIdx = RecordFor(hwnd).cycleIndex; // 0 si es nueva
   }
+  PixelRect rect;
+  if (!ResolveRect(hwnd, true, cycleIdx, rect))
+    return;
 
-  int &cycleIdx = windowCycleIndex[hwnd];
-  WindowLayout &layout = positions25[cycleIdx];
-
-  MONITORINFO mi = GetMonInfo(hwnd);
-  RECT workArea = mi.rcWork;
-  int screenW = workArea.right - workArea.left;
-  int screenH = workArea.bottom - workArea.top;
-
-  int baseX = workArea.left + (int)(screenW * layout.x);
-  int baseY = workArea.top + (int)(screenH * layout.y);
-  int baseW = (int)(screenW * layout.width);
-  int baseH = (int)(screenH * layout.height);
-
-  int posX = baseX + margin;
-  int posY = baseY + margin;
-  int width = baseW - (margin * 2);
-  int height = baseH - (margin * 2);
-
-  if (width < 100)
-    width = 100;
-  if (height < 100)
-    height = 100;
-
-  ShowWindow(hwnd, SW_RESTORE);
-  SmoothMoveWindow(hwnd, posX, posY, width, height);
+  backend->RestoreWindow(hwnd);
+  SmoothMoveWindow(hwnd, rect.x, rect.y, rect.w, rect.h);
 
   PlaySoundEffect(400 + (cycleIdx * 30), 30);
 
-  cycleIdx = (cycleIdx + 1) % positions25.size();
+  std::lock_guard<std::mutex> lock(windowStateMutex);
+  RecordFor(hwnd).cycleIndex = (cycleIdx + 1) % positions25.size();
 }
 
 void WindowManager::RestorePreviousPosition(HWND hwnd) {
   // ✅ Validación de HWND
-  if (!hwnd || !IsWindow(hwnd) || positions25.empty())
+  if (!hwnd || !backend->IsAlive(hwnd))
     return;
 
-  if (windowCycleIndex.find(hwnd) == windowCycleIndex.end()) {
-    windowCycleIndex[hwnd] = 0;
+  if (!ReplayJournal(hwnd, false)) {
+    RECT r;
+    if (!SettledRect(hwnd, r))
+      return;
+    GeometryHistory::Entry entry;
+    {
+      std::lock_guard<std::mutex> lock(windowStateMutex);
+      if (!RecordFor(hwnd).history.Undo(ToPixelRect(r), entry))
+        return;
+    }
+    backend->RestoreWindow(hwnd);
+    SmoothMoveWindow(hwnd, entry.rect.x, entry.rect.y, entry.rect.w,
+                     entry.rect.h);
   }
+  PlaySoundEffect(300, 100);
+}
 
-  int &cycleIdx = windowCycleIndex[hwnd];
-  cycleIdx = (cycleIdx - 2 + (int)positions25.size()) % positions25.size();
-
-  WindowLayout &layout = positions25[cycleIdx];
-
-  MONITORINFO mi = GetMonInfo(hwnd);
-  RECT workArea = mi.rcWork;
-  int screenW = workArea.right - workArea.left;
-  int screenH = workArea.bottom - workArea.top;
-
-  int baseX = workArea.left + (int)(screenW * layout.x);
-  int baseY = workArea.top + (int)(screenH * layout.y);
-  int baseW = (int)(screenW * layout.width);
-  int baseH = (int)(screenH * layout.height);
-
-  int posX = baseX + margin;
-  int posY = baseY + margin;
-  int width = baseW - (margin * 2);
-  int height = baseH - (margin * 2);
+void WindowManager::RedoPosition(HWND hwnd) {
+  // ✅ Validación de HWND
+  if (!hwnd || !backend->IsAlive(hwnd))
+    return;
 
-  if (width < 100)
-    width = 100;
-  if (height < 100)
-    height = 100;
+  if (!ReplayJournal(hwnd, true)) {
+    RECT r;
+    if (!SettledRect(hwnd, r))
+      return;
+    GeometryHistory::Entry entry;
+    {
+      std::lock_guard<std::mutex> lock(windowStateMutex);
+      if (!RecordFor(hwnd).history.Redo(ToPixelRect(r), entry))
+        return;
+    }
+    backend->RestoreWindow(hwnd);
+    SmoothMoveWindow(hwnd, entry.rect.x, entry.rect.y, entry.rect.w,
+                     entry.rect.h);
+  }
+  PlaySoundEffect(350, 100);
+}
 
-  ShowWindow(hwnd, SW_RESTORE);
-  SmoothMoveWindow(hwnd, posX, posY, width, height);
+bool WindowManager::SettledRect(HWND hwnd, RECT &r) {
+  return animator.TargetOf(hwnd, r) || backend->GetRect(hwnd, r);
+}
 
-  PlaySoundEffect(300, 100);
+bool WindowManager::ReplayJournal(HWND hwnd, bool redo) {
+  // La transacción de la cima solo gana si incluye hwnd y es más reciente
+  // que la última acción propia de la ventana (al rehacer, la que se
+  // deshizo la última, o sea la de menor secuencia)
+  uint64_t seq;
+  std::vector<GeometryJournal::Entry> targets;
+  {
+    std::lock_guard<std::mutex> lock(windowStateMutex);
+    const GeometryJournal::Transaction *t =
+        redo ? geometryJournal.PeekRedo() : geometryJournal.PeekUndo();
+    if (!t || !t->Touches(hwnd))
+      return false;
+    const GeometryHistory &history = RecordFor(hwnd).history;
+    const GeometryHistory::Entry *own =
+        redo ? history.PeekRedo() : history.PeekUndo();
+    if (own && (redo ? own->seq < t->seq : own->seq > t->seq))
+      return false;
+    seq = t->seq;
+    // Saltar las ventanas cerradas aunque su HWND ya sea de otra
+    for (const GeometryJournal::Entry &entry : t->entries) {
+      auto it = recordOf.find(entry.hwnd);
+      if (it != recordOf.end() && it->second == entry.tag)
+        targets.push_back(entry);
+    }
+  }
 
-  cycleIdx = (cycleIdx + 1) % positions25.size();
+  // Los rectángulos actuales son los que restaura el paso contrario
+  std::vector<GeometryJournal::Entry> current;
+  current.reserve(targets.size());
+  GeometryTransaction tx(backend);
+  for (const GeometryJournal::Entry &entry : targets) {
+    RECT r;
+    if (!backend->IsAlive(entry.hwnd) || !SettledRect(entry.hwnd, r))
+      continue;
+    current.push_back({entry.hwnd, entry.tag, ToPixelRect(r)});
+    tx.Set(entry.hwnd, entry.rect.x, entry.rect.y, entry.rect.w,
+           entry.rect.h);
+  }
+  {
+    std::lock_guard<std::mutex> lock(windowStateMutex);
+    bool moved = redo ? geometryJournal.Redo(seq, std::move(current))
+                      : geometryJournal.Undo(seq, std::move(current));
+    if (!moved)
+      return true; // Otra ventana de la transacción se adelantó
+  }
+  CommitGeometry(tx);
+  return true;
 }
 
 void WindowManager::CycleLayout(HWND hwnd, bool forward) {
-  if (layouts.empty())
+  int count = GetLayoutCount();
+  if (count == 0)
     return;
   if (forward)
-    currentCycleIndex = (currentCycleIndex + 1) % layouts.size();
+    currentCycleIndex = (currentCycleIndex + 1) % count;
   else
-    currentCycleIndex =
-        (currentCycleIndex - 1 + (int)layouts.size()) % layouts.size();
+    currentCycleIndex = (currentCycleIndex - 1 + count) % count;
   ApplyLayout(hwnd, currentCycleIndex);
 }
 
 void WindowManager::TileAllWindows() {
-  std::vector<HWND> windows = GetAllWindows();
+  WindowRegistry::Snapshot snapshot = GetAllWindows();
+  const std::vector<HWND> &windows = *snapshot;
   if (windows.empty())
     return;
   int count = (int)windows.size();
   int cols = (int)ceil(sqrt(count));
   int rows = (int)ceil((double)count / cols);
-  HWND active = GetForegroundWindow();
-  MONITORINFO mi = GetMonInfo(active ? active : GetDesktopWindow());
-  RECT workArea = mi.rcWork;
+  HWND active = backend->GetForeground();
+  RECT workArea = GetWorkArea(active);
   int screenW = workArea.right - workArea.left;
   int screenH = workArea.bottom - workArea.top;
   int cellW = screenW / cols;
   int cellH = screenH / rows;
+  int gap = margin; // Una sola lectura: SetMargin llega desde la GUI
+  std::vector<PixelRect> cells;
+  cells.reserve(count);
   for (int i = 0; i < count; ++i) {
     int r = i / cols;
     int c = i % cols;
-    int x = workArea.left + (c * cellW) + margin;
-    int y = workArea.top + (r * cellH) + margin;
-    int w = cellW - (margin * 2);
-    int h = cellH - (margin * 2);
-    ShowWindow(windows[i], SW_RESTORE);
-    SmoothMoveWindow(windows[i], x, y, w, h);
+    int x = workArea.left + (c * cellW) + gap;
+    int y = workArea.top + (r * cellH) + gap;
+    int w = cellW - (gap * 2);
+    int h = cellH - (gap * 2);
+    cells.push_back({x, y, w, h});
   }
+  GeometryTransaction tx(backend);
+  AssignToCells(windows, cells, tx);
+  CommitGeometry(tx, true);
 }
 
-void WindowManager::ArrangeAllWindowsNoOverlap() {
-  std::vector<HWND> windows = GetAllWindows();
-  if (windows.empty())
+void WindowManager::AssignToCells(const std::vector<HWND> &windows,
+                                  const std::vector<PixelRect> &cells,
+                                  GeometryTransaction &tx) {
+  // Cada ventana a la celda que menos la desplaza, no en orden Z
+  std::vector<PixelRect> current(windows.size());
+  for (size_t i = 0; i < windows.size(); ++i) {
+    RECT rc = {0, 0, 0, 0};
+    backend->GetRect(windows[i], rc);
+    current[i] = {(int)rc.left, (int)rc.top, (int)(rc.right - rc.left),
+                  (int)(rc.bottom - rc.top)};
+  }
+  std::vector<int> cellOf =
+      CellAssignment::Solve(current, cells, assignmentExactLimit);
+  for (size_t i = 0; i < windows.size(); ++i) {
+    const PixelRect &cell = cellOf.empty() ? cells[i] : cells[cellOf[i]];
+    tx.Set(windows[i], cell.x, cell.y, cell.w, cell.h);
+  }
+}
+
+void WindowManager::CommitGeometry(GeometryTransaction &tx, bool journal) {
+  // El historial se lee antes de restaurar: una ventana maximizada o
+  // minimizada se deshace a donde estaba, no a su rectángulo normal
+  std::unordered_map<HWND, RECT> settled;
+  if (journal) {
+    for (const WindowPos &pos : tx.Targets()) {
+      RECT r;
+      if (SettledRect(pos.hwnd, r))
+        settled[pos.hwnd] = r;
+    }
+  }
+  // ShowWindow también espera a la app: no tocar las que ya no respondieron
+  for (const WindowPos &pos : tx.Targets()) {
+    if (!moveDispatcher.IsUnresponsive(pos.hwnd))
+      backend->RestoreWindow(pos.hwnd);
+  }
+  tx.DropUnchanged(); // Tras restaurar, que cambia el rectángulo
+  if (tx.Empty())
     return;
+  for (const WindowPos &pos : tx.Targets())
+    NoteRect(pos.hwnd, pos.x, pos.y, pos.w, pos.h);
+
+  if (journal) {
+    std::vector<GeometryJournal::Entry> before;
+    before.reserve(tx.Size());
+    for (const WindowPos &pos : tx.Targets()) {
+      auto it = settled.find(pos.hwnd);
+      if (it != settled.end())
+        before.push_back({pos.hwnd, 0, ToPixelRect(it->second)});
+    }
+    std::lock_guard<std::mutex> lock(windowStateMutex);
+    for (GeometryJournal::Entry &entry : before) {
+      RecordFor(entry.hwnd).history.ClearRedo();
+      entry.tag = recordOf[entry.hwnd];
+    }
+    geometryJournal.Record(geometryJournal.NextSeq(), std::move(before));
+  }
 
-  for (HWND hwnd : windows) {
-    ShowWindow(hwnd, SW_RESTORE);
+  if (animationsEnabled) {
+    animator.AnimateBatch(tx.Targets());
+    return;
   }
+  for (const WindowPos &pos : tx.Targets())
+    animator.Cancel(pos.hwnd);
+  moveDispatcher.ApplyBatch(tx.Targets());
+}
 
-  int count = (int)windows.size();
-  if (count == 0)
+void WindowManager::ArrangeAllWindowsNoOverlap() {
+  WindowRegistry::Snapshot snapshot = GetAllWindows();
+  const std::vector<HWND> &windows = *snapshot;
+  if (windows.empty())
     return;
 
-  POINT pt;
-  GetCursorPos(&pt);
-  HMONITOR hMon = MonitorFromPoint(pt, MONITOR_DEFAULTTONEAREST);
-  MONITORINFO mi = {sizeof(mi)};
-  ::GetMonitorInfo(hMon, &mi);
-  RECT workArea = mi.rcWork;
+  int count = (int)windows.size();
+
+  POINT pt = {0, 0};
+  backend->GetCursorPoint(pt);
+  MonitorDesc mon;
+  if (!GetMonitorAt(pt, mon))
+    return;
+  RECT workArea = mon.rcWork;
 
   int areaW = workArea.right - workArea.left;
   int areaH = workArea.bottom - workArea.top;
@@ -381,42 +609,48 @@ void WindowManager::ArrangeAllWindowsNoOverlap() {
 
   int cellW = areaW / cols;
   int cellH = areaH / rows;
+  int gap = margin;
 
+  std::vector<PixelRect> cells;
+  cells.reserve(count);
   for (int i = 0; i < count; ++i) {
     int r = i / cols;
     int c = i % cols;
 
-    int x = workArea.left + (c * cellW) + margin;
-    int y = workArea.top + (r * cellH) + margin;
-    int w = cellW - (margin * 2);
-    int h = cellH - (margin * 2);
+    int x = workArea.left + (c * cellW) + gap;
+    int y = workArea.top + (r * cellH) + gap;
+    int w = cellW - (gap * 2);
+    int h = cellH - (gap * 2);
 
-    SmoothMoveWindow(windows[i], x, y, w, h);
-
-    FLASHWINFO fi;
-    fi.cbSize = sizeof(FLASHWINFO);
-    fi.hwnd = windows[i];
-    fi.dwFlags = FLASHW_CAPTION;
-    fi.uCount = 1;
-    fi.dwTimeout = 0;
-    FlashWindowEx(&fi);
+    cells.push_back({x, y, w, h});
   }
+  GeometryTransaction tx(backend);
+  AssignToCells(windows, cells, tx);
+  CommitGeometry(tx, true);
+  for (HWND hwnd : windows)
+    backend->FlashCaption(hwnd, 0);
 
   PlaySoundEffect(700, 100);
 }
 
 void WindowManager::SafeCloseWindow(HWND hwnd) {
   // ✅ Validación de HWND
-  if (!hwnd || !IsWindow(hwnd))
+  if (!hwnd || !backend->IsAlive(hwnd))
     return;
-  PostMessage(hwnd, WM_CLOSE, 0, 0);
+  backend->PostClose(hwnd);
   PlaySoundEffect(500, 50);
 }
 
 void WindowManager::ApplyLayoutByHotkey(HWND hwnd, int hotkey) {
-  auto it = hotkeyToLayoutIndex.find(hotkey);
-  if (it != hotkeyToLayoutIndex.end())
-    ApplyLayout(hwnd, it->second);
+  int index = -1;
+  {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    auto it = hotkeyToLayoutIndex.find(hotkey);
+    if (it != hotkeyToLayoutIndex.end())
+      index = it->second;
+  }
+  if (index >= 0)
+    ApplyLayout(hwnd, index);
 }
 
 void WindowManager::PlaySoundEffect(int frequency, int duration) {
@@ -430,10 +664,11 @@ bool WindowManager::SaveConfig() {
 
   file << "S|" << (soundsEnabled ? "1" : "0") << "|"
        << (animationsEnabled ? "1" : "0") << "|"
-       << (trayIconEnabled ? "1" : "0") << "|" << margin << "|"
+       << (trayIconEnabled ? "1" : "0") << "|" << margin.load() << "|"
        << transparencyLevel << "|" << (loggingEnabled ? "1" : "0") << "|"
        << (autoStartEnabled ? "1" : "0") << "\n";
 
+  std::lock_guard<std::mutex> lock(catalogMutex);
   for (const auto &layout : layouts) {
     file << "L|" << layout.name << "|" << layout.x << "|" << layout.y << "|"
          << layout.width << "|" << layout.height << "|" << layout.hotkey
@@ -446,6 +681,9 @@ bool WindowManager::SaveConfig() {
   for (const auto &ex : excludedApps) {
     file << "E|" << ex << "\n";
   }
+  for (const auto &rule : exclusionRules) {
+    file << "X|" << rule << "\n";
+  }
   file.close();
   return true;
 }
@@ -454,11 +692,12 @@ bool WindowManager::LoadConfig() {
   std::ifstream file(configFile);
   if (!file.is_open())
     return false;
-  layouts.clear();
-  appShortcuts.clear();
+  // Se lee entero y se publica de una vez bajo catalogMutex
+  std::vector<WindowLayout> newLayouts;
+  std::vector<AppShortcut> newApps;
+  std::map<int, int> newLayoutIndex, newAppIndex;
   excludedApps.clear();
-  hotkeyToLayoutIndex.clear();
-  hotkeyToAppIndex.clear();
+  exclusionRules.clear();
   std::string line;
   while (std::getline(file, line)) {
     if (line.empty())
@@ -498,9 +737,9 @@ bool WindowManager::LoadConfig() {
       height = std::stof(token);
       std::getline(ss, token, '|');
       hotkey = std::stoi(token);
-      layouts.push_back(WindowLayout(name, x, y, width, height, hotkey));
+      newLayouts.push_back(WindowLayout(name, x, y, width, height, hotkey));
       if (hotkey != 0)
-        hotkeyToLayoutIndex[hotkey] = (int)layouts.size() - 1;
+        newLayoutIndex[hotkey] = (int)newLayouts.size() - 1;
     } else if (type == "A") {
       std::string name, path, token;
       int hotkey, modifier;
@@ -514,70 +753,56 @@ bool WindowManager::LoadConfig() {
         hotkey = modifier;
         modifier = MOD_CONTROL | MOD_ALT;
       }
-      appShortcuts.push_back(AppShortcut(name, path, hotkey, modifier));
+      newApps.push_back(AppShortcut(name, path, hotkey, modifier));
       if (hotkey != 0)
-        hotkeyToAppIndex[hotkey] = (int)appShortcuts.size() - 1;
+        newAppIndex[hotkey] = (int)newApps.size() - 1;
     } else if (type == "E") {
       std::string name;
       std::getline(ss, name);
       excludedApps.push_back(name);
+    } else if (type == "X") {
+      std::string rule;
+      std::getline(ss, rule);
+      exclusionRules.push_back(rule);
     }
   }
   file.close();
+  {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    layouts.swap(newLayouts);
+    appShortcuts.swap(newApps);
+    hotkeyToLayoutIndex.swap(newLayoutIndex);
+    hotkeyToAppIndex.swap(newAppIndex);
+  }
+  layoutTableDirty = true;
+  CompileExclusions();
   return true;
 }
 
 void WindowManager::UnregisterAllHotkeys(HWND messageWindow) {
+  std::lock_guard<std::mutex> lock(catalogMutex);
   for (size_t i = 0; i < layouts.size(); ++i)
-    UnregisterHotKey(messageWindow, 200 + i);
+    backend->UnregisterSystemHotkey(messageWindow, 200 + i);
   for (size_t i = 0; i < appShortcuts.size(); ++i)
-    UnregisterHotKey(messageWindow, 300 + i);
-}
-
-BOOL CALLBACK EnumWindowsProc(HWND hwnd, LPARAM lParam) {
-  std::vector<HWND> *windows = reinterpret_cast<std::vector<HWND> *>(lParam);
-  if (IsWindowVisible(hwnd)) {
-    LONG style = GetWindowLong(hwnd, GWL_STYLE);
-    if (!((style & WS_CAPTION) && !(style & WS_CHILD)))
-      return TRUE;
-    char title[256];
-    if (GetWindowTextA(hwnd, title, sizeof(title)) <= 0)
-      return TRUE;
-    int cloaked;
-    if (SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked,
-                                        sizeof(cloaked))) &&
-        cloaked)
-      return TRUE;
-    if (hwnd == GetConsoleWindow())
-      return TRUE;
-    windows->push_back(hwnd);
-  }
-  return TRUE;
-}
-
-std::vector<HWND> WindowManager::GetAllWindows() {
-  std::vector<HWND> windows;
-  EnumWindows(EnumWindowsProc, reinterpret_cast<LPARAM>(&windows));
-  std::vector<HWND> filtered;
-  for (HWND hwnd : windows) {
-    if (!IsExcluded(hwnd))
-      filtered.push_back(hwnd);
-  }
-  return filtered;
+    backend->UnregisterSystemHotkey(messageWindow, 300 + i);
+}
+
+WindowRegistry::Snapshot WindowManager::GetAllWindows() {
+  // Foto inmutable: activar o mover ventanas dispara eventos que cambian el
+  // registro, no la lista que se está recorriendo
+  return registry.Windows();
 }
 
 std::string WindowManager::GetWindowTitle(HWND hwnd) {
-  char title[256];
-  GetWindowTextA(hwnd, title, sizeof(title));
-  return std::string(title);
+  return backend->GetTitle(hwnd);
 }
 
 void WindowManager::MoveActiveWindow(HWND hwnd, int direction) {
   // ✅ Validación de HWND
-  if (!hwnd || !IsWindow(hwnd))
+  if (!hwnd || !backend->IsAlive(hwnd))
     return;
   RECT r;
-  GetWindowRect(hwnd, &r);
+  backend->GetRect(hwnd, r);
   int x = r.left, y = r.top, w = r.right - r.left, h = r.bottom - r.top;
   const int step = 60;
   switch (direction) {
@@ -594,16 +819,18 @@ void WindowManager::MoveActiveWindow(HWND hwnd, int direction) {
     x += step;
     break;
   }
-  SetWindowPos(hwnd, NULL, x, y, w, h,
-               SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
+  SaveCurrentState(hwnd);
+  animator.Cancel(hwnd);
+  backend->SetPos(hwnd, x, y, w, h, SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
+  NoteRect(hwnd, x, y, w, h);
 }
 
 void WindowManager::ResizeActiveWindow(HWND hwnd, int direction) {
   // ✅ Validación de HWND
-  if (!hwnd || !IsWindow(hwnd))
+  if (!hwnd || !backend->IsAlive(hwnd))
     return;
   RECT r;
-  GetWindowRect(hwnd, &r);
+  backend->GetRect(hwnd, r);
   int x = r.left, y = r.top, w = r.right - r.left, h = r.bottom - r.top;
   const int step = 60;
   switch (direction) {
@@ -624,17 +851,21 @@ void WindowManager::ResizeActiveWindow(HWND hwnd, int direction) {
     w = 100;
   if (h < 100)
     h = 100;
-  SetWindowPos(hwnd, NULL, x, y, w, h, SWP_NOZORDER | SWP_NOACTIVATE);
+  SaveCurrentState(hwnd);
+  animator.Cancel(hwnd);
+  backend->SetPos(hwnd, x, y, w, h, SWP_NOZORDER | SWP_NOACTIVATE);
+  NoteRect(hwnd, x, y, w, h);
 }
 
 void WindowManager::SaveSession() {
   std::ofstream file("session.cfg");
   if (!file.is_open())
     return;
-  std::vector<HWND> windows = GetAllWindows();
+  WindowRegistry::Snapshot snapshot = GetAllWindows();
+  const std::vector<HWND> &windows = *snapshot;
   for (HWND hwnd : windows) {
     RECT r;
-    GetWindowRect(hwnd, &r);
+    backend->GetRect(hwnd, r);
     file << GetWindowTitle(hwnd) << "|" << r.left << "|" << r.top << "|"
          << (r.right - r.left) << "|" << (r.bottom - r.top) << "\n";
   }
@@ -643,23 +874,54 @@ void WindowManager::SaveSession() {
 
 void WindowManager::SaveCurrentState(HWND hwnd) {
   // ✅ Validación de HWND
-  if (!hwnd || !IsWindow(hwnd))
+  if (!hwnd || !backend->IsAlive(hwnd))
     return;
   RECT r;
-  if (GetWindowRect(hwnd, &r)) {
-    WindowState state;
-    state.startTime = GetTickCount(); // Unused but initialized
-    state.rect = r;
-    previousStates[hwnd] = state;
+  if (SettledRect(hwnd, r)) {
+    std::lock_guard<std::mutex> lock(windowStateMutex);
+    RecordFor(hwnd).history.Push(ToPixelRect(r), geometryJournal.NextSeq());
+    // Una acción nueva invalida lo que se podía rehacer
+    geometryJournal.ClearRedo();
   }
 }
 
+WindowRecord &WindowManager::RecordFor(HWND hwnd) {
+  auto it = recordOf.find(hwnd);
+  if (it != recordOf.end()) {
+    if (WindowRecord *record = windowRecords.Get(it->second))
+      return *record;
+  }
+  SlotMap<WindowRecord>::Id id = windowRecords.Insert(WindowRecord());
+  recordOf[hwnd] = id;
+  return *windowRecords.Get(id);
+}
+
+void WindowManager::EvictRecord(HWND hwnd) {
+  std::lock_guard<std::mutex> lock(windowStateMutex);
+  auto it = recordOf.find(hwnd);
+  if (it == recordOf.end())
+    return;
+  windowRecords.Remove(it->second);
+  recordOf.erase(it);
+}
+
+size_t WindowManager::TrackedWindowCount() {
+  std::lock_guard<std::mutex> lock(windowStateMutex);
+  return windowRecords.Size();
+}
+
+size_t WindowManager::TrackedWindowCapacity() {
+  std::lock_guard<std::mutex> lock(windowStateMutex);
+  return windowRecords.Capacity();
+}
+
 void WindowManager::RestoreSession() {
   std::ifstream file("session.cfg");
   if (!file.is_open())
     return;
   std::string line;
-  std::vector<HWND> openWindows = GetAllWindows();
+  WindowRegistry::Snapshot snapshot = GetAllWindows();
+  const std::vector<HWND> &openWindows = *snapshot;
   while (std::getline(file, line)) {
     if (line.empty())
       continue;
@@ -684,193 +946,273 @@ void WindowManager::RestoreSession() {
   }
 }
 
+void WindowManager::TrackFocus(HWND hwnd, WindowEvent event) {
+  // Solo eventos: mantener el orden nunca enumera ventanas
+  std::lock_guard<std::mutex> lock(focusMutex);
+  if (event == WE_DESTROYED || !registry.Contains(hwnd))
+    focusOrder.Remove(hwnd);
+  else if (event == WE_FOREGROUND)
+    focusOrder.Touch(hwnd);
+  else
+    focusOrder.Append(hwnd);
+}
+
+void WindowManager::SeedFocusOrder() {
+  // Las que ya estaban abiertas, en orden Z, detrás de las ya enfocadas
+  WindowRegistry::Snapshot snapshot = registry.Windows();
+  const std::vector<HWND> &windows = *snapshot;
+  if (!registry.IsLive())
+    focusOrder.Clear();
+  for (HWND hwnd : windows)
+    focusOrder.Append(hwnd);
+  focusSeeded = registry.IsLive();
+}
+
 void WindowManager::SwitchWindowFocus(bool forward) {
-  std::vector<HWND> windows = GetAllWindows();
-  if (windows.empty())
+  // Adelante: la usada justo antes que la actual (pulsar otra vez vuelve,
+  // como un Alt+Tab rápido). Atrás: la que lleva más tiempo sin usarse
+  HWND current = backend->GetForeground();
+  HWND target = NULL;
+  {
+    std::lock_guard<std::mutex> lock(focusMutex);
+    if (!focusSeeded)
+      SeedFocusOrder();
+    while (focusOrder.Size() > 0) {
+      if (focusOrder.Contains(current))
+        target = forward ? focusOrder.Next(current) : focusOrder.Prev(current);
+      else
+        target = forward ? focusOrder.Front() : focusOrder.Back();
+      if (registry.Contains(target) && backend->IsAlive(target))
+        break;
+      focusOrder.Remove(target); // Se perdió su evento
+      target = NULL;
+    }
+    // Sin esperar al WE_FOREGROUND: una segunda pulsación rápida ya la ve
+    if (target)
+      focusOrder.Touch(target);
+  }
+  if (!target)
     return;
+  backend->ActivateWindow(target);
+  backend->FlashCaption(target, 100);
+}
 
-  if (windows.size() == 1) {
-    SetForegroundWindow(windows[0]);
+// ===== NAVEGACIÓN ESPACIAL =====
+
+void WindowManager::TrackGeometry(HWND hwnd, WindowEvent event) {
+  std::lock_guard<std::mutex> lock(spatialMutex);
+  if (!spatialSeeded)
+    return; // La primera consulta lo llena entero
+  if (event == WE_DESTROYED || !registry.Contains(hwnd)) {
+    if (spatialIndex.Remove(hwnd))
+      snapDirty = true;
     return;
   }
+  if (event == WE_TITLE_CHANGED && spatialIndex.Contains(hwnd))
+    return;
+  RECT r;
+  if (backend->GetRect(hwnd, r)) {
+    spatialIndex.Update(hwnd, ToPixelRect(r));
+    snapDirty |= hwnd != snapSubject;
+  }
+}
 
-  HWND current = GetForegroundWindow();
-  int currentIndex = -1;
-
-  for (int i = 0; i < (int)windows.size(); ++i) {
-    if (windows[i] == current) {
-      currentIndex = i;
-      break;
-    }
+void WindowManager::SeedSpatialIndex() {
+  // La rejilla cubre la unión de todos los monitores
+  RECT all;
+  {
+    std::lock_guard<std::mutex> lock(topologyMutex);
+    EnsureTopology();
+    all = topology.Bounds();
   }
+  spatialIndex.Clear();
+  spatialIndex.SetBounds(ToPixelRect(all));
+  WindowRegistry::Snapshot windows = registry.Windows();
+  for (HWND hwnd : *windows) {
+    RECT r;
+    if (backend->GetRect(hwnd, r))
+      spatialIndex.Update(hwnd, ToPixelRect(r));
+  }
+  spatialSeeded = registry.IsLive();
+  snapDirty = true;
+}
 
-  if (currentIndex == -1) {
-    currentIndex = 0;
+void WindowManager::NoteRect(HWND hwnd, int x, int y, int w, int h) {
+  std::lock_guard<std::mutex> lock(spatialMutex);
+  if (spatialSeeded && spatialIndex.Contains(hwnd)) {
+    spatialIndex.Update(hwnd, {x, y, w, h});
+    // La ventana que se está moviendo con el teclado no invalida sus imanes
+    snapDirty |= hwnd != snapSubject;
   }
+}
 
-  int nextIndex =
-      forward ? (currentIndex + 1) % windows.size()
-              : (currentIndex - 1 + (int)windows.size()) % windows.size();
+void WindowManager::RebuildEdges(HWND subject) {
+  edgeSnapper.Clear();
+  std::vector<HWND> windows;
+  spatialIndex.Windows(windows);
+  for (HWND hwnd : windows) {
+    PixelRect r;
+    if (hwnd != subject && spatialIndex.RectOf(hwnd, r))
+      edgeSnapper.AddWindow(r);
+  }
+  {
+    std::lock_guard<std::mutex> lock(topologyMutex);
+    EnsureTopology();
+    for (const MonitorDesc &mon : topology.Monitors())
+      edgeSnapper.AddGuides(ToPixelRect(mon.rcWork));
+  }
+  edgeSnapper.Finish();
+  snapSubject = subject;
+  snapDirty = false;
+  snapRebuilds++;
+}
 
-  HWND nextWindow = windows[nextIndex];
-  DWORD currentThreadId = GetCurrentThreadId();
-  DWORD targetThreadId = GetWindowThreadProcessId(nextWindow, NULL);
+bool WindowManager::SnapStep(HWND hwnd, const PixelRect &from,
+                             PixelRect &to) {
+  int threshold = snapThreshold;
+  if (!hwnd || threshold <= 0)
+    return false;
+  std::lock_guard<std::mutex> lock(spatialMutex);
+  if (!spatialSeeded)
+    SeedSpatialIndex();
+  if (snapDirty || hwnd != snapSubject)
+    RebuildEdges(hwnd);
+  return edgeSnapper.Snap(from, to, threshold);
+}
 
-  bool attached = false;
-  if (currentThreadId != targetThreadId) {
-    attached = AttachThreadInput(currentThreadId, targetThreadId, TRUE);
-  }
+size_t WindowManager::SnapRebuildCount() {
+  std::lock_guard<std::mutex> lock(spatialMutex);
+  return snapRebuilds;
+}
 
-  AllowSetForegroundWindow(ASFW_ANY);
+void WindowManager::NoteWindowMoved(HWND hwnd) {
+  RECT r;
+  if (hwnd && backend->GetRect(hwnd, r))
+    NoteRect(hwnd, (int)r.left, (int)r.top, (int)(r.right - r.left),
+             (int)(r.bottom - r.top));
+}
 
-  if (IsIconic(nextWindow)) {
-    ShowWindow(nextWindow, SW_RESTORE);
+HWND WindowManager::NeighborInDirection(HWND hwnd,
+                                        SpatialIndex::Direction dir) {
+  RECT r;
+  if (!hwnd || !backend->GetRect(hwnd, r))
+    return NULL;
+  PixelRect from = ToPixelRect(r);
+  std::lock_guard<std::mutex> lock(spatialMutex);
+  if (!spatialSeeded)
+    SeedSpatialIndex();
+  if (spatialIndex.Contains(hwnd))
+    spatialIndex.Update(hwnd, from);
+
+  // Una app que se mueve sola no avisa: la ganadora se compara con su
+  // rectángulo real y, si estaba desfasada, se corrige y se repite
+  HWND best = NULL;
+  for (int attempt = 0; attempt < 8; ++attempt) {
+    best = spatialIndex.Nearest(from, dir, hwnd);
+    if (!best)
+      return NULL;
+    RECT br;
+    if (!registry.Contains(best) || !backend->GetRect(best, br)) {
+      spatialIndex.Remove(best);
+      continue;
+    }
+    PixelRect known, actual = ToPixelRect(br);
+    spatialIndex.RectOf(best, known);
+    if (known.x == actual.x && known.y == actual.y && known.w == actual.w &&
+        known.h == actual.h)
+      return best;
+    spatialIndex.Update(best, actual);
   }
+  return best;
+}
 
-  SetWindowPos(nextWindow, HWND_TOP, 0, 0, 0, 0,
-               SWP_NOMOVE | SWP_NOSIZE | SWP_SHOWWINDOW);
+void WindowManager::FocusInDirection(SpatialIndex::Direction dir) {
+  HWND target = NeighborInDirection(backend->GetForeground(), dir);
+  if (!target)
+    return;
+  backend->ActivateWindow(target);
+  backend->FlashCaption(target, 100);
+}
 
-  SetForegroundWindow(nextWindow);
-  SetActiveWindow(nextWindow);
-  BringWindowToTop(nextWindow);
-  SetFocus(nextWindow);
+void WindowManager::SwapInDirection(HWND hwnd, SpatialIndex::Direction dir) {
+  if (!hwnd || !backend->IsAlive(hwnd))
+    return;
+  HWND other = NeighborInDirection(hwnd, dir);
+  if (!other)
+    return;
 
-  if (attached) {
-    AttachThreadInput(currentThreadId, targetThreadId, FALSE);
+  // Con auto-tiling, si están en el mismo árbol se intercambian las hojas
+  // para que el mosaico lo recuerde
+  if (autoTiling) {
+    bool swapped = false;
+    {
+      std::lock_guard<std::mutex> lock(tilingMutex);
+      for (auto &entry : tilingTrees) {
+        if (entry.second.Swap(hwnd, other)) {
+          swapped = true;
+          break;
+        }
+      }
+    }
+    if (swapped) {
+      CommitTilingChanges();
+      return;
+    }
   }
 
-  FLASHWINFO fi;
-  fi.cbSize = sizeof(FLASHWINFO);
-  fi.hwnd = nextWindow;
-  fi.dwFlags = FLASHW_CAPTION;
-  fi.uCount = 1;
-  fi.dwTimeout = 100;
-  FlashWindowEx(&fi);
+  RECT a, b;
+  if (!backend->GetRect(hwnd, a) || !backend->GetRect(other, b))
+    return;
+  GeometryTransaction tx(backend);
+  tx.Set(hwnd, b.left, b.top, b.right - b.left, b.bottom - b.top);
+  tx.Set(other, a.left, a.top, a.right - a.left, a.bottom - a.top);
+  CommitGeometry(tx, true);
 }
 
-void WindowManager::ShowMissionControl() {
-  INPUT inputs[8] = {0};
-  int n = 0;
-  inputs[n].type = INPUT_KEYBOARD;
-  inputs[n].ki.wVk = VK_CONTROL;
-  inputs[n].ki.dwFlags = KEYEVENTF_KEYUP;
-  n++;
-  inputs[n].type = INPUT_KEYBOARD;
-  inputs[n].ki.wVk = VK_MENU;
-  inputs[n].ki.dwFlags = KEYEVENTF_KEYUP;
-  n++;
-  inputs[n].type = INPUT_KEYBOARD;
-  inputs[n].ki.wVk = VK_LWIN;
-  n++;
-  inputs[n].type = INPUT_KEYBOARD;
-  inputs[n].ki.wVk = VK_TAB;
-  n++;
-  inputs[n].type = INPUT_KEYBOARD;
-  inputs[n].ki.wVk = VK_TAB;
-  inputs[n].ki.dwFlags = KEYEVENTF_KEYUP;
-  n++;
-  inputs[n].type = INPUT_KEYBOARD;
-  inputs[n].ki.wVk = VK_LWIN;
-  inputs[n].ki.dwFlags = KEYEVENTF_KEYUP;
-  n++;
-  SendInput(n, inputs, sizeof(INPUT));
-}
+void WindowManager::ShowMissionControl() { backend->SendTaskView(); }
 
 void WindowManager::CenterWindow(HWND hwnd) {
-  MONITORINFO mi = GetMonInfo(hwnd);
-  RECT wa = mi.rcWork;
+  RECT wa = GetWorkArea(hwnd);
   int w = (int)((wa.right - wa.left) * 0.8f),
       h = (int)((wa.bottom - wa.top) * 0.8f);
   int x = wa.left + (wa.right - wa.left - w) / 2,
       y = wa.top + (wa.bottom - wa.top - h) / 2;
-  SetWindowPos(hwnd, HWND_TOP, x, y, w, h, SWP_NOZORDER | SWP_SHOWWINDOW);
+  SaveCurrentState(hwnd);
+  animator.Cancel(hwnd);
+  backend->SetPos(hwnd, x, y, w, h, SWP_NOZORDER | SWP_SHOWWINDOW);
+  NoteRect(hwnd, x, y, w, h);
 }
 
 void WindowManager::ToggleTransparency(HWND hwnd) {
   // ✅ Validación de HWND
-  if (!hwnd || !IsWindow(hwnd))
+  if (!hwnd || !backend->IsAlive(hwnd))
     return;
-  LONG style = GetWindowLong(hwnd, GWL_EXSTYLE);
+  LONG style = backend->GetExStyle(hwnd);
   if (!(style & WS_EX_LAYERED)) {
-    SetWindowLong(hwnd, GWL_EXSTYLE, style | WS_EX_LAYERED);
-    SetLayeredWindowAttributes(hwnd, 0, (BYTE)transparencyLevel, LWA_ALPHA);
+    backend->SetOpacity(hwnd, transparencyLevel);
     PlaySoundEffect(800, 50);
   } else {
-    SetLayeredWindowAttributes(hwnd, 0, 255, LWA_ALPHA);
-    SetWindowLong(hwnd, GWL_EXSTYLE, style & ~WS_EX_LAYERED);
+    backend->SetOpacity(hwnd, 255);
     PlaySoundEffect(600, 50);
   }
 }
 
 void WindowManager::ToggleAlwaysOnTop(HWND hwnd) {
   // ✅ Validación de HWND
-  if (!hwnd || !IsWindow(hwnd))
+  if (!hwnd || !backend->IsAlive(hwnd))
     return;
-  LONG style = GetWindowLong(hwnd, GWL_EXSTYLE);
+  LONG style = backend->GetExStyle(hwnd);
   if (style & WS_EX_TOPMOST) {
-    SetWindowPos(hwnd, HWND_NOTOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
+    backend->SetTopmost(hwnd, false);
     PlaySoundEffect(500, 50);
   } else {
-    SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
+    backend->SetTopmost(hwnd, true);
     PlaySoundEffect(900, 50);
   }
 }
 
 // ===== GAME MODE IMPLEMENTATION =====
 
-LRESULT CALLBACK GameModeWndProc(HWND hwnd, UINT msg, WPARAM wParam,
-                                 LPARAM lParam) {
-  if (msg == WM_PAINT) {
-    PAINTSTRUCT ps;
-    HDC hdc = BeginPaint(hwnd, &ps);
-    RECT r;
-    GetClientRect(hwnd, &r);
-
-    // Transparent background text
-    SetBkMode(hdc, TRANSPARENT);
-    SetTextColor(hdc, RGB(0, 255, 0)); // Green text for visibility
-
-    HFONT hFont =
-        CreateFontA(16, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE, ANSI_CHARSET,
-                    OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY,
-                    DEFAULT_PITCH | FF_SWISS, "Arial");
-    HFONT hOldFont = (HFONT)SelectObject(hdc, hFont);
-
-    TextOutA(hdc, 2, 0, "JUEGO", 5);
-
-    SelectObject(hdc, hOldFont);
-    DeleteObject(hFont);
-    EndPaint(hwnd, &ps);
-    return 0;
-  }
-  // Handle destruction to avoid zombie window classes if needed, though we use
-  // a static class
-  return DefWindowProc(hwnd, msg, wParam, lParam);
-}
-
-void KillProcessByName(const char *filename) {
-  HANDLE hSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-  if (hSnap == INVALID_HANDLE_VALUE)
-    return;
-
-  PROCESSENTRY32 pe32;
-  pe32.dwSize = sizeof(PROCESSENTRY32);
-
-  if (Process32First(hSnap, &pe32)) {
-    do {
-      if (_stricmp(pe32.szExeFile, filename) == 0) {
-        HANDLE hProcess =
-            OpenProcess(PROCESS_TERMINATE, FALSE, pe32.th32ProcessID);
-        if (hProcess) {
-          TerminateProcess(hProcess, 0);
-          CloseHandle(hProcess);
-        }
-      }
-    } while (Process32Next(hSnap, &pe32));
-  }
-  CloseHandle(hSnap);
-}
-
 void WindowManager::ToggleGameMode() {
   isGameMode = !isGameMode;
   if (isGameMode) {
@@ -883,61 +1225,19 @@ void WindowManager::ToggleGameMode() {
   }
 }
 
-void WindowManager::ShowGameModeIndicator() {
-  if (gameModeIndicatorHwnd && IsWindow(gameModeIndicatorHwnd))
-    return;
-
-  static bool classRegistered = false;
-  const char *className = "GameModeIndClass";
+void WindowManager::ShowGameModeIndicator() { backend->ShowGameIndicator(); }
 
-  if (!classRegistered) {
-    WNDCLASSEXA wc = {0};
-    wc.cbSize = sizeof(WNDCLASSEXA);
-    wc.lpfnWndProc = GameModeWndProc;
-    wc.hInstance = GetModuleHandle(NULL);
-    wc.lpszClassName = className;
-    wc.hbrBackground = (HBRUSH)GetStockObject(NULL_BRUSH);
-    wc.hCursor = LoadCursor(NULL, IDC_ARROW);
-    RegisterClassExA(&wc);
-    classRegistered = true;
-  }
-
-  // Create a layered window at top-left
-  gameModeIndicatorHwnd = CreateWindowExA(
-      WS_EX_TOPMOST | WS_EX_TOOLWINDOW | WS_EX_LAYERED | WS_EX_TRANSPARENT,
-      className, "GameMode", WS_POPUP | WS_VISIBLE, 5, 5, 60, 20, // x, y, w, h
-      NULL, NULL, GetModuleHandle(NULL), NULL);
-
-  // Set transparency key (though we might just want full opacity for text and 0
-  // for bg) Using LWA_COLORKEY to make a specific background color transparent
-  // is common, but here we used NULL_BRUSH. Let's use 255 alpha (opaque) but
-  // relying on WM_PAINT for valid pixels. Actually, for simple text overlay,
-  // SetLayeredWindowAttributes with LWA_COLORKEY is easiest if we paint a bg
-  // color. Re-adjusting: Paint black bg, set black as colorkey.
-
-  // Set window opacity
-  SetLayeredWindowAttributes(gameModeIndicatorHwnd, 0, 255, LWA_ALPHA);
-
-  SetWindowPos(gameModeIndicatorHwnd, HWND_TOPMOST, 0, 0, 0, 0,
-               SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
-}
-
-void WindowManager::HideGameModeIndicator() {
-  if (gameModeIndicatorHwnd) {
-    if (IsWindow(gameModeIndicatorHwnd))
-      DestroyWindow(gameModeIndicatorHwnd);
-    gameModeIndicatorHwnd = NULL;
-  }
-}
+void WindowManager::HideGameModeIndicator() { backend->HideGameIndicator(); }
 
 void WindowManager::CloseNonEssentialApps() {
-  std::vector<HWND> windows = GetAllWindows();
-  HWND foreground = GetForegroundWindow();
-  HWND console = GetConsoleWindow();
-  DWORD currentPid = GetCurrentProcessId();
+  WindowRegistry::Snapshot snapshot = GetAllWindows();
+  const std::vector<HWND> &windows = *snapshot;
+  HWND foreground = backend->GetForeground();
+  HWND console = backend->GetConsole();
+  DWORD currentPid = backend->CurrentPid();
   DWORD foregroundPid = 0;
   if (foreground) {
-    GetWindowThreadProcessId(foreground, &foregroundPid);
+    foregroundPid = backend->GetWindowPid(foreground);
   }
 
   // 1. Cerrar Ventanas Visibles (Modo Cortés)
@@ -945,203 +1245,212 @@ void WindowManager::CloseNonEssentialApps() {
   for (HWND hwnd : windows) {
     if (hwnd == foreground)
       continue; // Don't close the active game/app
-    if (hwnd == gameModeIndicatorHwnd)
-      continue; // Don't close our indicator
     if (hwnd == console)
       continue; // Don't close ourself if visible
 
-    DWORD wndPid = 0;
-    GetWindowThreadProcessId(hwnd, &wndPid);
+    DWORD wndPid = backend->GetWindowPid(hwnd);
     if (wndPid == currentPid)
-      continue; // Don't close windows owned by this process
-
-    char className[256];
-    if (GetClassNameA(hwnd, className, sizeof(className))) {
-      // Protect Shell/System windows
-      if (strcmp(className, "Shell_TrayWnd") == 0 ||
-          strcmp(className, "Progman") == 0 ||
-          strcmp(className, "WorkerW") == 0) {
-        continue;
-      }
+      continue; // Don't close windows owned by this process (incl. indicator)
+
+    std::string className = backend->GetClass(hwnd);
+    // Protect Shell/System windows
+    if (className == "Shell_TrayWnd" || className == "Progman" ||
+        className == "WorkerW") {
+      continue;
     }
 
-    PostMessage(hwnd, WM_CLOSE, 0, 0);
+    backend->PostClose(hwnd);
     closedCount++;
   }
 
   // 2. Terminar Procesos en Segundo Plano (Modo Agresivo)
-  HANDLE hSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-  if (hSnap != INVALID_HANDLE_VALUE) {
-    PROCESSENTRY32 pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32);
-
-    // Whitelist de procesos del sistema y esenciales
-    std::set<std::string> whitelist = {"explorer.exe",
-                                       "svchost.exe",
-                                       "csrss.exe",
-                                       "wininit.exe",
-                                       "services.exe",
-                                       "lsass.exe",
-                                       "winlogon.exe",
-                                       "dwm.exe",
-                                       "smss.exe",
-                                       "taskhostw.exe",
-                                       "RuntimeBroker.exe",
-                                       "sihost.exe",
-                                       "ctfmon.exe",
-                                       "smartscreen.exe",
-                                       "conhost.exe",
-                                       "System",
-                                       "registry",
-                                       "audiodg.exe",
-                                       "spoolsv.exe",
-                                       "dasHost.exe",
-                                       "SearchUI.exe",
-                                       "ShellExperienceHost.exe",
-                                       "StandardCollector.Service.exe",
-                                       "WmiPrvSE.exe",
-                                       "Memory Compression",
-                                       "ntoskrnl.exe",
-                                       "gestor_ven.exe",
-                                       "ConfiguracionWinVen.exe",
-                                       "cmd.exe"};
-
-    if (Process32First(hSnap, &pe32)) {
-      do {
-        // Ignorar el proceso actual y el juego activo
-        if (pe32.th32ProcessID == currentPid ||
-            pe32.th32ProcessID == foregroundPid || pe32.th32ProcessID == 0) {
-          continue;
-        }
+  std::vector<ProcessDesc> processes;
+  backend->ListProcesses(processes);
 
-        std::string exeName = pe32.szExeFile;
-        // Case-insensitive check (simple tolower)
-        std::string exeNameLower = exeName;
-        std::transform(exeNameLower.begin(), exeNameLower.end(),
-                       exeNameLower.begin(), ::tolower);
-
-        bool isSafe = false;
-        for (const auto &safe : whitelist) {
-          std::string safeLower = safe;
-          std::transform(safeLower.begin(), safeLower.end(), safeLower.begin(),
-                         ::tolower);
-          if (exeNameLower == safeLower) {
-            isSafe = true;
-            break;
-          }
-        }
+  for (const ProcessDesc &proc : processes) {
+    // Ignorar el proceso actual y el juego activo
+    if (proc.pid == currentPid || proc.pid == foregroundPid || proc.pid == 0) {
+      continue;
+    }
 
-        if (isSafe)
-          continue;
-
-        // Intentar terminar el proceso
-        HANDLE hProcess =
-            OpenProcess(PROCESS_TERMINATE, FALSE, pe32.th32ProcessID);
-        if (hProcess) {
-          TerminateProcess(hProcess, 0);
-          CloseHandle(hProcess);
-          std::cout << "[GAME MODE] Proceso terminado: " << exeName
-                    << std::endl;
-        }
+    const std::string &exeName = proc.exeName;
+    if (essentialApps.MatchesExe(AppMatcher::ToLower(exeName)))
+      continue;
 
-      } while (Process32Next(hSnap, &pe32));
+    // Intentar terminar el proceso
+    if (backend->TerminatePid(proc.pid)) {
+      std::cout << "[GAME MODE] Proceso terminado: " << exeName << std::endl;
     }
-    CloseHandle(hSnap);
   }
 
   std::cout << "[GAME MODE] Cerradas " << closedCount
             << " ventanas no esenciales y procesos de fondo." << std::endl;
 }
 
+void WindowManager::SetAnimationSpeed(int frames) {
+  animationSpeed = frames < 0 ? 0 : frames;
+  animator.Configure(animationSpeed * Animator::FRAME_MS, animationEasing);
+}
+
+void WindowManager::SetAnimationEasing(const std::string &name) {
+  animationEasing = Animator::ParseEasing(name);
+  animator.Configure(animationSpeed * Animator::FRAME_MS, animationEasing);
+}
+
+void WindowManager::SetAssignmentExactLimit(int windows) {
+  assignmentExactLimit = windows < 0 ? 0 : windows;
+}
+
+void WindowManager::SetMoveTimeouts(int timeoutMs, int cooldownMs) {
+  moveDispatcher.Configure(timeoutMs, cooldownMs);
+}
+
 void WindowManager::SmoothMoveWindow(HWND hwnd, int tx, int ty, int tw,
                                      int th) {
   if (!hwnd)
     return;
+  NoteRect(hwnd, tx, ty, tw, th); // El destino, aunque aún se esté animando
 
   if (!animationsEnabled) {
-    SetWindowPos(hwnd, NULL, tx, ty, tw, th, SWP_NOZORDER | SWP_NOACTIVATE);
+    animator.Cancel(hwnd);
+    moveDispatcher.Apply(
+        {{hwnd, tx, ty, tw, th, SWP_NOZORDER | SWP_NOACTIVATE}});
     return;
   }
 
-  RECT sr;
-  GetWindowRect(hwnd, &sr);
-  int sx = sr.left, sy = sr.top, sw = sr.right - sr.left,
-      sh = sr.bottom - sr.top;
-  if (sx == tx && sy == ty && sw == tw && sh == th)
-    return;
-  for (int i = 1; i <= 12; ++i) {
-    float f = sin(((float)i / 12) * (3.14159f / 2.0f));
-    SetWindowPos(hwnd, NULL, sx + (int)((tx - sx) * f),
-                 sy + (int)((ty - sy) * f), sw + (int)((tw - sw) * f),
-                 sh + (int)((th - sh) * f),
-                 SWP_NOZORDER | SWP_NOACTIVATE | SWP_ASYNCWINDOWPOS);
-    Sleep(10);
-  }
-  SetWindowPos(hwnd, NULL, tx, ty, tw, th, SWP_NOZORDER | SWP_NOACTIVATE);
+  // El hilo del animador aplica los frames; el llamador vuelve ya
+  animator.Animate(hwnd, tx, ty, tw, th);
 }
 
 void WindowManager::TileMasterStack() {
-  std::vector<HWND> windows = GetAllWindows();
+  WindowRegistry::Snapshot snapshot = GetAllWindows();
+  const std::vector<HWND> &windows = *snapshot;
   if (windows.empty())
     return;
-  HWND active = GetForegroundWindow();
-  MONITORINFO mi = GetMonInfo(active ? active : GetDesktopWindow());
-  RECT wa = mi.rcWork;
+  HWND active = backend->GetForeground();
+  RECT wa = GetWorkArea(active);
   int sw = wa.right - wa.left, sh = wa.bottom - wa.top;
   if (windows.size() == 1) {
     ApplyLayout(windows[0], 21);
     return;
   }
   int mw = (int)(sw * 0.6), stw = sw - mw;
-  ShowWindow(windows[0], SW_RESTORE);
-  SmoothMoveWindow(windows[0], wa.left + margin, wa.top + margin,
-                   mw - (margin * 2), sh - (margin * 2));
+  int gap = margin;
+  GeometryTransaction tx(backend);
+  tx.Set(windows[0], wa.left + gap, wa.top + gap, mw - (gap * 2),
+         sh - (gap * 2));
   int sth = sh / (windows.size() - 1);
   for (int i = 1; i < (int)windows.size(); ++i) {
-    ShowWindow(windows[i], SW_RESTORE);
-    SmoothMoveWindow(windows[i], wa.left + mw + margin,
-                     wa.top + ((i - 1) * sth) + margin, stw - (margin * 2),
-                     sth - (margin * 2));
+    tx.Set(windows[i], wa.left + mw + gap, wa.top + ((i - 1) * sth) + gap,
+           stw - (gap * 2), sth - (gap * 2));
   }
+  CommitGeometry(tx, true);
 }
 
-struct MData {
-  std::vector<RECT> m;
-};
-BOOL CALLBACK EMonProc(HMONITOR hm, HDC hdc, LPRECT lr, LPARAM d) {
-  MONITORINFO mi = {sizeof(mi)};
-  GetMonitorInfo(hm, &mi); // API Windows
-  reinterpret_cast<MData *>(d)->m.push_back(mi.rcWork);
-  return TRUE;
+// ===== AUTO-TILING =====
+
+void WindowManager::SetAutoTiling(bool enabled) {
+  autoTiling = enabled;
+  if (enabled) {
+    RebuildTiling();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(tilingMutex);
+  tilingTrees.clear();
+}
+
+TilingTree &WindowManager::TilingTreeFor(const MonitorDesc &mon) {
+  auto found = tilingTrees.find(mon.handle);
+  if (found == tilingTrees.end()) {
+    found = tilingTrees.emplace(mon.handle, TilingTree()).first;
+    const RECT &wa = mon.rcWork;
+    found->second.SetArea({(int)wa.left, (int)wa.top,
+                           (int)(wa.right - wa.left),
+                           (int)(wa.bottom - wa.top)},
+                          margin);
+  }
+  return found->second;
+}
+
+void WindowManager::RebuildTiling() {
+  // Desde cero: al activar, al cambiar monitores o el margen
+  WindowRegistry::Snapshot snapshot = GetAllWindows();
+  const std::vector<HWND> &windows = *snapshot;
+  {
+    std::lock_guard<std::mutex> lock(tilingMutex);
+    tilingTrees.clear();
+    for (auto it = windows.rbegin(); it != windows.rend(); ++it) {
+      MonitorDesc mon;
+      if (!GetMonitorFor(*it, mon))
+        continue;
+      TilingTreeFor(mon).Insert(*it);
+    }
+  }
+  CommitTilingChanges();
+}
+
+void WindowManager::SyncAutoTiling(HWND hwnd) {
+  // Una inserción o un borrado: solo se recoloca el subárbol afectado
+  bool manage = registry.Contains(hwnd);
+  {
+    std::lock_guard<std::mutex> lock(tilingMutex);
+    TilingTree *owner = nullptr;
+    for (auto &entry : tilingTrees) {
+      if (entry.second.Contains(hwnd)) {
+        owner = &entry.second;
+        break;
+      }
+    }
+    if (owner && !manage) {
+      owner->Remove(hwnd);
+    } else if (!owner && manage) {
+      MonitorDesc mon;
+      if (!GetMonitorFor(hwnd, mon))
+        return;
+      TilingTreeFor(mon).Insert(hwnd);
+    } else {
+      return;
+    }
+  }
+  CommitTilingChanges();
+}
+
+void WindowManager::CommitTilingChanges() {
+  std::vector<WindowPos> changes;
+  {
+    std::lock_guard<std::mutex> lock(tilingMutex);
+    for (auto &entry : tilingTrees)
+      entry.second.TakeChanges(changes);
+  }
+  if (changes.empty())
+    return;
+  GeometryTransaction tx(backend);
+  for (const WindowPos &pos : changes)
+    tx.Set(pos.hwnd, pos.x, pos.y, pos.w, pos.h);
+  CommitGeometry(tx);
 }
 
 void WindowManager::MoveWindowToMonitor(HWND hwnd, bool next) {
   if (!hwnd)
     return;
-  MData d;
-  EnumDisplayMonitors(NULL, NULL, EMonProc, (LPARAM)&d);
-  if (d.m.size() < 2)
-    return;
-  HMONITOR hm = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
-  MONITORINFO mi = {sizeof(mi)};
-  GetMonitorInfo(hm, &mi); // API Windows
-  int ci = -1;
-  for (int i = 0; i < (int)d.m.size(); ++i) {
-    if (d.m[i].left == mi.rcWork.left && d.m[i].top == mi.rcWork.top) {
-      ci = i;
-      break;
-    }
+  // Siguiente en el orden de la topología (de izquierda a derecha)
+  MonitorDesc current, target;
+  {
+    std::lock_guard<std::mutex> lock(topologyMutex);
+    int ci = TopologyIndexFor(hwnd);
+    if (ci < 0 || topology.Size() < 2)
+      return;
+    current = topology.At(ci);
+    target = topology.At(next ? topology.Next(ci) : topology.Prev(ci));
   }
-  if (ci == -1)
-    return;
-  int ni = next ? (ci + 1) % d.m.size() : (ci - 1 + d.m.size()) % d.m.size();
-  RECT nw = d.m[ni], cw = mi.rcWork, wr;
-  GetWindowRect(hwnd, &wr);
+  RECT nw = target.rcWork, cw = current.rcWork, wr;
+  backend->GetRect(hwnd, wr);
   float rx = (float)(wr.left - cw.left) / (cw.right - cw.left),
         ry = (float)(wr.top - cw.top) / (cw.bottom - cw.top);
   float rw = (float)(wr.right - wr.left) / (cw.right - cw.left),
         rh = (float)(wr.bottom - wr.top) / (cw.bottom - cw.top);
-  ShowWindow(hwnd, SW_RESTORE);
+  SaveCurrentState(hwnd);
+  backend->RestoreWindow(hwnd);
   SmoothMoveWindow(hwnd, nw.left + (int)(rx * (nw.right - nw.left)),
                    nw.top + (int)(ry * (nw.bottom - nw.top)),
                    (int)(rw * (nw.right - nw.left)),
@@ -1150,20 +1459,21 @@ void WindowManager::MoveWindowToMonitor(HWND hwnd, bool next) {
 
 void WindowManager::BringToFront(HWND hwnd) {
   if (hwnd) {
-    SetWindowPos(hwnd, HWND_TOP, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
-    SetForegroundWindow(hwnd);
+    backend->RaiseWindow(hwnd, true);
+    registry.Raise(hwnd);
   }
 }
 
 void WindowManager::SendToBack(HWND hwnd) {
   if (hwnd) {
-    SetWindowPos(hwnd, HWND_BOTTOM, 0, 0, 0, 0,
-                 SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+    backend->LowerWindow(hwnd);
+    registry.Lower(hwnd);
   }
 }
 
 void WindowManager::InitializePositions25() {
   positions25.clear();
+  layoutTableDirty = true;
   // FILA 1
   positions25.push_back(WindowLayout("1.1", 0.0f, 0.0f, 0.5f, 1.0f));
   positions25.push_back(WindowLayout("1.2", 0.0f, 0.0f, 0.33f, 1.0f));
@@ -1199,40 +1509,66 @@ void WindowManager::InitializePositions25() {
 
 void WindowManager::AddToExclusionList(const std::string &processName) {
   excludedApps.push_back(processName);
+  CompileExclusions();
   SaveConfig();
 }
 
+void WindowManager::CompileExclusions() {
+  // Una subcadena vacía excluiría todas las ventanas: se ignora
+  std::vector<std::string> substrings;
+  for (const std::string &name : excludedApps) {
+    if (!name.empty())
+      substrings.push_back(name);
+  }
+  // Bajo el mismo mutex que IsExcluded; el registro vuelve a filtrar
+  // llamando a IsExcluded, así que se le avisa ya sin él
+  bool needsTitle;
+  {
+    std::lock_guard<std::mutex> lock(processCacheMutex);
+    legacyExclusions.Build(substrings);
+    exclusionMatcher.Compile(exclusionRules);
+    needsTitle = exclusionMatcher.NeedsTitle();
+  }
+  registry.SetTitleDependent(needsTitle);
+  registry.Invalidate();
+  // Las que entran ahora en la lista no tienen evento que las añada: el
+  // orden de foco y el índice espacial se vuelven a llenar
+  {
+    std::lock_guard<std::mutex> lock(focusMutex);
+    focusSeeded = false;
+  }
+  std::lock_guard<std::mutex> lock(spatialMutex);
+  spatialSeeded = false;
+}
+
 bool WindowManager::IsExcluded(HWND hwnd) {
   if (!hwnd)
     return false;
-  DWORD pid;
-  GetWindowThreadProcessId(hwnd, &pid);
-  HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-  if (hSnapshot == INVALID_HANDLE_VALUE)
+  std::lock_guard<std::mutex> lock(processCacheMutex);
+  if (legacyExclusions.Empty() && exclusionMatcher.Empty())
     return false;
-
-  PROCESSENTRY32 pe32;
-  pe32.dwSize = sizeof(PROCESSENTRY32);
-  if (Process32First(hSnapshot, &pe32)) {
-    do {
-      if (pe32.th32ProcessID == pid) {
-        std::string exeName = pe32.szExeFile;
-        for (const auto &excluded : excludedApps) {
-          if (exeName.find(excluded) != std::string::npos) {
-            CloseHandle(hSnapshot);
-            return true;
-          }
-        }
-        break;
-      }
-    } while (Process32Next(hSnapshot, &pe32));
-  }
-  CloseHandle(hSnapshot);
-  return false;
+  const ProcessCache::Info *proc =
+      processCache.Lookup(backend->GetWindowPid(hwnd));
+  if (proc && legacyExclusions.Any(proc->exeName))
+    return true;
+  if (exclusionMatcher.Empty())
+    return false;
+  std::string className, title;
+  if (exclusionMatcher.NeedsClass())
+    className = backend->GetClass(hwnd);
+  if (exclusionMatcher.NeedsTitle())
+    title = backend->GetTitle(hwnd);
+  static const std::string noExe;
+  return exclusionMatcher.Matches(proc ? proc->lowerName : noExe, &className,
+                                  &title);
 }
 
 void WindowManager::CreateDefaultLayouts() {
-  layouts.clear();
+  {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    layouts.clear();
+    hotkeyToLayoutIndex.clear();
+  }
   AddLayout(WindowLayout("Mitad Izquierda", 0.0f, 0.0f, 0.5f, 1.0f));
   AddLayout(WindowLayout("Mitad Derecha", 0.5f, 0.0f, 0.5f, 1.0f));
   AddLayout(WindowLayout("Mitad Superior", 0.0f, 0.0f, 1.0f, 0.5f));
@@ -1258,10 +1594,13 @@ void WindowManager::CreateDefaultLayouts() {
   AddLayout(WindowLayout("Maximizado Pro", 0.0f, 0.0f, 1.0f, 1.0f));
 }
 
-void WindowManager::CreateDefaultAppShortcuts() { appShortcuts.clear(); }
+void WindowManager::CreateDefaultAppShortcuts() {
+  std::lock_guard<std::mutex> lock(catalogMutex);
+  appShortcuts.clear();
+  hotkeyToAppIndex.clear();
+}
 
 // --- Nuevas funciones de configuración ---
-#include "Logger.h"
 void WindowManager::SetLoggingEnabled(bool enabled) {
   loggingEnabled = enabled;
   WinVenLogger::SetEnabled(enabled);
@@ -1269,18 +1608,5 @@ void WindowManager::SetLoggingEnabled(bool enabled) {
 
 void WindowManager::SetAutoStartEnabled(bool enabled) {
   autoStartEnabled = enabled;
-  HKEY hKey;
-  if (RegOpenKeyExA(HKEY_CURRENT_USER,
-                    "Software\\Microsoft\\Windows\\CurrentVersion\\Run", 0,
-                    KEY_SET_VALUE, &hKey) == ERROR_SUCCESS) {
-    if (enabled) {
-      char path[MAX_PATH];
-      GetModuleFileNameA(NULL, path, MAX_PATH);
-      RegSetValueExA(hKey, "WinVen", 0, REG_SZ, (BYTE *)path,
-                     (DWORD)(strlen(path) + 1));
-    } else {
-      RegDeleteValueA(hKey, "WinVen");
-    }
-    RegCloseKey(hKey);
-  }
+  backend->SetAutoStart(enabled);
 }
@@ -1,15 +1,33 @@
 #ifndef WINDOW_MANAGER_H
 #define WINDOW_MANAGER_H
 
-#include <dwmapi.h>
+#include "Animator.h"
+#include "AppMatcher.h"
+#include "CellAssignment.h"
+#include "DesktopBackend.h"
+#include "EdgeSnapper.h"
+#include "FocusOrder.h"
+#include "GeometryJournal.h"
+#include "GeometryTransaction.h"
+#include "KeymapProfiles.h"
+#include "LayoutTable.h"
+#include "MonitorTopology.h"
+#include "MoveDispatcher.h"
+#include "ProcessCache.h"
+#include "SlotMap.h"
+#include "SpatialIndex.h"
+#include "TilingTree.h"
+#include "WindowRegistry.h"
+#include <atomic>
 #include <fstream>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include <windows.h>
 
-#pragma comment(lib, "dwmapi.lib")
+class HotkeyManager;
 
 // Estructura para definir una posición de ventana personalizada
 struct WindowLayout {
@@ -37,58 +55,179 @@ struct AppShortcut {
       : name(n), path(p), hotkey(hk), modifier(mod) {}
 };
 
-// Estructura para apps encontradas en el sistema
-struct DiscoveryApp {
-  std::string name;
-  std::string path;
-};
-
-// Estructura para guardar la posición anterior de una ventana
-struct WindowState {
-  RECT rect;
-  bool isMaximized;
-  bool isMinimized;
-  DWORD startTime;
+// Estado por ventana; vive mientras viva la ventana (se borra en
+// WE_DESTROYED), así que una HWND reutilizada empieza de cero
+struct WindowRecord {
+  GeometryHistory history; // Rectángulos previos a cada acción
+  int cycleIndex = 0; // Siguiente de las 25 posiciones
 };
 
-class WindowManager {
+class WindowManager : public DesktopEventSink {
 private:
+  DesktopBackend *backend; // Acceso al escritorio (Win32 o simulado)
   std::vector<WindowLayout> layouts;
   std::vector<AppShortcut> appShortcuts;
+  // Exclusiones: "E|" del config son subcadenas literales del ejecutable,
+  // con mayúsculas, como siempre; "X|" son reglas de AppMatcher (=exacto,
+  // globs, class:, title:)
   std::vector<std::string> excludedApps;
+  std::vector<std::string> exclusionRules;
   std::map<int, int> hotkeyToLayoutIndex;
   std::map<int, int> hotkeyToAppIndex;
-  std::map<HWND, WindowState> previousStates; // Guardar estados anteriores
-  std::map<HWND, int> windowCycleIndex;       // Índice de ciclo por ventana
+  // layouts, appShortcuts y sus índices por hotkey: la GUI los reescribe
+  // mientras los hilos de acciones los leen
+  mutable std::mutex catalogMutex;
+  // Registros por ventana con Id generacional; recordOf es el índice por
+  // HWND. Ambos bajo windowStateMutex (hilos de acciones)
+  SlotMap<WindowRecord> windowRecords;
+  std::unordered_map<HWND, SlotMap<WindowRecord>::Id> recordOf;
+  std::mutex windowStateMutex;
+  WindowRecord &RecordFor(HWND hwnd); // Con windowStateMutex; lo crea
+  void EvictRecord(HWND hwnd);
+  // Transacciones de varias ventanas para deshacerlas de una vez; también
+  // bajo windowStateMutex
+  GeometryJournal geometryJournal;
+  bool ReplayJournal(HWND hwnd, bool redo);
+  // Rectángulo que guarda el historial: el destino si se está animando,
+  // no el frame intermedio
+  bool SettledRect(HWND hwnd, RECT &r);
   std::string configFile;
-  int margin = 6;            // Margen entre ventanas
+  std::atomic<int> margin{6}; // Margen entre ventanas; llega desde la GUI
   int currentCycleIndex = 0; // Índice para navegación circular
 
   // Configuración General
   bool soundsEnabled = true;
-  bool animationsEnabled = true;
+  std::atomic<bool> animationsEnabled{true};
   bool trayIconEnabled = true;
-  int animationSpeed = 12;
+  int animationSpeed = 12; // Duración en frames de 10 ms (12 = 120 ms)
+  Animator::Easing animationEasing = Animator::EASE_SINE;
   int transparencyLevel = 180; // Default 180
   volatile bool isGameMode = false;
   bool loggingEnabled = false; // Desactivado por defecto por petición
   bool autoStartEnabled = false;
-  HWND gameModeIndicatorHwnd = NULL;
 
-  MONITORINFO GetMonInfo(HWND hwnd);
+  RECT GetWorkArea(HWND hwnd);
+
+  // Monitores (áreas, DPI, orden, vecinos) leídos una sola vez; se rehacen
+  // solo tras OnDisplayChanged (cambio de pantallas o de área de trabajo)
+  MonitorTopology topology;
+  std::mutex topologyMutex;
+  std::atomic<bool> topologyDirty{true};
+  void EnsureTopology(); // Con topologyMutex
+  int TopologyIndexFor(HWND hwnd); // Con topologyMutex
 
   // Las 25 posiciones predefinidas (se inicializan en el constructor)
   std::vector<WindowLayout> positions25;
 
+  // Rectángulos precalculados por monitor (layouts + 25 posiciones)
+  LayoutTable layoutTable;
+  std::mutex layoutTableMutex;
+  std::atomic<bool> layoutTableDirty{true}; // SetMargin llega desde la GUI
+  void EnsureLayoutTable();
+  bool ResolveRect(HWND hwnd, bool position25, int index, PixelRect &out);
+
+  // Ventanas gestionables, mantenidas por eventos del backend
+  WindowRegistry registry;
+  ProcessCache processCache; // PID -> ejecutable para IsExcluded
+  std::mutex processCacheMutex;
+
+  // Orden de uso reciente para Ctrl + Alt + Izquierda/Derecha, mantenido
+  // con los eventos de foco; las ventanas ya abiertas al arrancar entran en
+  // el primer cambio de foco (o en cada uno si no hay eventos)
+  FocusOrder focusOrder;
+  std::mutex focusMutex;
+  bool focusSeeded = false;
+  void TrackFocus(HWND hwnd, WindowEvent event);
+  void SeedFocusOrder(); // Con focusMutex
+
+  // Rectángulos de las ventanas gestionables para navegar por dirección.
+  // Se llena en la primera consulta y se mantiene con los eventos y con
+  // cada rectángulo que aplica el propio gestor (NoteRect)
+  SpatialIndex spatialIndex;
+  std::mutex spatialMutex;
+  bool spatialSeeded = false;
+  void TrackGeometry(HWND hwnd, WindowEvent event);
+  void SeedSpatialIndex(); // Con spatialMutex
+  void NoteRect(HWND hwnd, int x, int y, int w, int h);
+  HWND NeighborInDirection(HWND hwnd, SpatialIndex::Direction dir);
+
+  // Bordes de las demás ventanas para el imán de SnapStep; también bajo
+  // spatialMutex. Se rehacen al cambiar de ventana o al moverse otra
+  EdgeSnapper edgeSnapper;
+  HWND snapSubject = NULL;
+  bool snapDirty = true;
+  size_t snapRebuilds = 0;
+  std::atomic<int> snapThreshold{EdgeSnapper::DEFAULT_THRESHOLD};
+  void RebuildEdges(HWND subject); // Con spatialMutex
+
+  // Reglas compiladas: exclusiones (con processCacheMutex, como
+  // IsExcluded) y la lista blanca del Game Mode
+  PatternAutomaton legacyExclusions; // excludedApps
+  AppMatcher exclusionMatcher;       // exclusionRules
+  AppMatcher essentialApps;
+  void CompileExclusions();
+
+  // SetPos en paralelo por proceso, con plazo para apps colgadas
+  MoveDispatcher moveDispatcher;
+
+  // Animaciones de SmoothMoveWindow (hilo propio)
+  Animator animator;
+
+  // Restaura y aplica un lote (tiling, ordenar) de una vez: un
+  // SetPosBatch por proceso, o una animación conjunta con un lote por
+  // frame. Con journal, anota antes los rectángulos previos para poder
+  // deshacerlo
+  void CommitGeometry(GeometryTransaction &tx, bool journal = false);
+  // Anota en tx cada ventana en la celda de menor desplazamiento
+  void AssignToCells(const std::vector<HWND> &windows,
+                     const std::vector<PixelRect> &cells,
+                     GeometryTransaction &tx);
+  int assignmentExactLimit = CellAssignment::DEFAULT_EXACT_LIMIT;
+
+  // Perfil de teclado según la app en primer plano (WE_FOREGROUND)
+  KeymapProfiles keymapProfiles;
+  HotkeyManager *profileHotkeys = nullptr;
+
+  // Auto-tiling (opcional): un árbol BSP por monitor que se edita con cada
+  // ventana que aparece o desaparece
+  std::mutex tilingMutex;
+  std::map<HMONITOR, TilingTree> tilingTrees;
+  std::atomic<bool> autoTiling{false};
+  TilingTree &TilingTreeFor(const MonitorDesc &mon); // Con tilingMutex
+  void RebuildTiling();
+  void SyncAutoTiling(HWND hwnd);
+  void CommitTilingChanges();
+
 public:
-  WindowManager(const std::string &configPath = "window_layouts.cfg");
+  WindowManager(const std::string &configPath = "window_layouts.cfg",
+                DesktopBackend *desktop = nullptr);
   ~WindowManager();
 
+  // DesktopEventSink
+  void OnDisplayChanged() override;
+  void OnWindowEvent(HWND hwnd, WindowEvent event) override;
+
+  // Monitor de una ventana (el de su centro) o de un punto, desde la
+  // topología en caché: sin consultar monitores al sistema
+  bool GetMonitorFor(HWND hwnd, MonitorDesc &out);
+  bool GetMonitorAt(POINT pt, MonitorDesc &out);
+
+  // Perfiles de teclado por app
+  KeymapProfiles &GetKeymapProfiles() { return keymapProfiles; }
+  void SelectKeymapProfile(HWND foreground);
+  // Hotkeys a los que se aplica cada cambio de perfil (mismo hilo que los
+  // eventos de ventana); nullptr para desengancharlos
+  void SetProfileHotkeys(HotkeyManager *hotkeys);
+
   // Gestión de layouts
   void AddLayout(const WindowLayout &layout);
   void RemoveLayout(int index);
-  WindowLayout &GetLayout(int index);
-  int GetLayoutCount() const { return layouts.size(); }
+  // Copia bajo catalogMutex; vacío si el índice no existe
+  WindowLayout GetLayout(int index) const;
+  int GetLayoutCount() const {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    return layouts.size();
+  }
 
   // Gestión de apps
   void AddAppShortcut(const AppShortcut &app);
@@ -108,6 +247,16 @@ public:
   void TileAllWindows();
   void MoveActiveWindow(HWND hwnd, int direction);
   void SwitchWindowFocus(bool forward);
+  // Ctrl + Alt + Shift / Win + Flechas: la ventana más cercana en pantalla
+  void FocusInDirection(SpatialIndex::Direction dir);
+  void SwapInDirection(HWND hwnd, SpatialIndex::Direction dir);
+  // Movimientos que el gestor no ve (control continuo de gestor_ven)
+  void NoteWindowMoved(HWND hwnd);
+  // Imán para un paso de teclado de hwnd: ajusta 'to' a los bordes de otras
+  // ventanas o del monitor a menos de snap_threshold píxeles
+  bool SnapStep(HWND hwnd, const PixelRect &from, PixelRect &to);
+  void SetSnapThreshold(int pixels) { snapThreshold = pixels; }
+  size_t SnapRebuildCount(); // Veces que se rehicieron los bordes del imán
   void ShowMissionControl();
 
   // ===== NUEVAS FUNCIONES SOLICITADAS =====
@@ -122,9 +271,14 @@ public:
   void CyclePosition25(HWND hwnd);
   void InitializePositions25(); // Inicializa las 25 posiciones
 
-  // Ctrl + Alt + 2: Restaurar posición anterior
-  void SaveCurrentState(HWND hwnd);
+  // Ctrl + Alt + 2: Deshacer (Ctrl + Alt + Shift + 2: rehacer). Deshace la
+  // última acción sobre la ventana o, si es más reciente, la última
+  // operación de varias ventanas en la que entró
+  void SaveCurrentState(HWND hwnd); // Punto de deshacer antes de una acción
   void RestorePreviousPosition(HWND hwnd);
+  void RedoPosition(HWND hwnd);
+  size_t TrackedWindowCount(); // Registros por ventana vivos
+  size_t TrackedWindowCapacity(); // Huecos reservados para registros
 
   // Ctrl + Alt + 3: Ordenar ventanas sin superposición
   void ArrangeAllWindowsNoOverlap();
@@ -138,6 +292,8 @@ public:
   void SmoothMoveWindow(HWND hwnd, int targetX, int targetY, int targetW,
                         int targetH);
   void TileMasterStack();
+  void SetAutoTiling(bool enabled);
+  bool IsAutoTiling() const { return autoTiling; }
   void MoveWindowToMonitor(HWND hwnd, bool next);
   void ResizeActiveWindow(HWND hwnd, int direction);
   void BringToFront(HWND hwnd);
@@ -150,17 +306,23 @@ public:
   bool IsExcluded(HWND hwnd);
 
   // Configuración
-  void SetMargin(int m) { margin = m; }
+  void SetMargin(int m);
   int GetMargin() const { return margin; }
   void SetTransparencyLevel(int t) { transparencyLevel = t; }
   void SetSoundsEnabled(bool enabled) { soundsEnabled = enabled; }
   void SetAnimationsEnabled(bool enabled) { animationsEnabled = enabled; }
+  void SetAnimationSpeed(int frames);
+  void SetAnimationEasing(const std::string &name);
+  void SetMoveTimeouts(int timeoutMs, int cooldownMs);
+  // Hasta cuántas ventanas el reparto en celdas es óptimo (húngaro)
+  void SetAssignmentExactLimit(int windows);
   void SetTrayIconEnabled(bool enabled) { trayIconEnabled = enabled; }
   void SetLoggingEnabled(bool enabled);
   void SetAutoStartEnabled(bool enabled);
 
   bool IsSoundsEnabled() const { return soundsEnabled; }
   bool IsAnimationsEnabled() const { return animationsEnabled; }
+  int GetAnimationSpeed() const { return animationSpeed; }
   bool IsTrayIconEnabled() const { return trayIconEnabled; }
   bool IsLoggingEnabled() const { return loggingEnabled; }
   bool IsAutoStartEnabled() const { return autoStartEnabled; }
@@ -175,14 +337,19 @@ public:
   bool RegisterAllHotkeys(HWND messageWindow = NULL);
   void UnregisterAllHotkeys(HWND messageWindow = NULL);
 
-  // Getters para UI
-  const std::vector<WindowLayout> &GetLayouts() const { return layouts; }
-  const std::vector<AppShortcut> &GetAppShortcuts() const {
+  // Getters para UI: copias, la GUI puede estar editándolos
+  std::vector<WindowLayout> GetLayouts() const {
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    return layouts;
+  }
+  std::vector<AppShortcut> GetAppShortcuts() const {
+    std::lock_guard<std::mutex> lock(catalogMutex);
     return appShortcuts;
   }
 
   // Utilidades
-  std::vector<HWND> GetAllWindows();
+  DesktopBackend *GetBackend() const { return backend; }
+  WindowRegistry::Snapshot GetAllWindows();
   std::string GetWindowTitle(HWND hwnd);
   void CenterWindow(HWND hwnd);
   void CreateDefaultLayouts();
@@ -0,0 +1,165 @@
+#include "WindowRegistry.h"
+#include <algorithm>
+
+WindowRegistry::WindowRegistry(DesktopBackend *backend,
+                               ExclusionCheck isExcluded)
+    : backend(backend), isExcluded(isExcluded) {}
+
+void WindowRegistry::Invalidate() {
+  std::lock_guard<std::mutex> lock(mtx);
+  entries.clear();
+  dirty = true;
+}
+
+void WindowRegistry::SetTitleDependent(bool dependent) {
+  std::lock_guard<std::mutex> lock(mtx);
+  titleDependent = dependent;
+}
+
+bool WindowRegistry::IsManageable(HWND hwnd, Entry &entry) {
+  // Mismo filtro que aplicaba GetAllWindows en cada llamada
+  if (!backend->IsVisible(hwnd))
+    return false;
+  LONG style = backend->GetStyle(hwnd);
+  if (!((style & WS_CAPTION) && !(style & WS_CHILD)))
+    return false;
+  if (backend->GetTitle(hwnd).empty())
+    return false;
+  if (backend->IsCloaked(hwnd))
+    return false;
+  if (hwnd == backend->GetConsole())
+    return false;
+  if (entry.excluded < 0)
+    entry.excluded = isExcluded(hwnd) ? 1 : 0;
+  return entry.excluded == 0;
+}
+
+void WindowRegistry::Rescan() {
+  std::vector<HWND> all;
+  backend->ListTopLevelWindows(all);
+
+  // Conservar la exclusión ya evaluada de las ventanas conocidas
+  std::unordered_map<HWND, Entry> previous;
+  previous.swap(entries);
+  entries.reserve(all.size());
+  order.clear();
+
+  for (HWND hwnd : all) {
+    auto it = previous.find(hwnd);
+    bool cached = it != previous.end() && !titleDependent;
+    Entry entry = {false, cached ? it->second.excluded : (signed char)-1};
+    entry.listed = IsManageable(hwnd, entry);
+    if (entry.listed)
+      order.push_back(hwnd);
+    entries[hwnd] = entry;
+  }
+  dirty = false;
+  generation++;
+}
+
+void WindowRegistry::Unlist(HWND hwnd) {
+  auto it = std::find(order.begin(), order.end(), hwnd);
+  if (it != order.end()) {
+    order.erase(it);
+    generation++;
+  }
+}
+
+void WindowRegistry::Refresh(HWND hwnd, bool toFront) {
+  auto it = entries.find(hwnd);
+  if (it == entries.end())
+    it = entries.insert({hwnd, Entry{false, -1}}).first;
+  Entry &entry = it->second;
+
+  bool manageable = IsManageable(hwnd, entry);
+  if (manageable && !entry.listed) {
+    order.insert(order.begin(), hwnd);
+    generation++;
+  } else if (!manageable && entry.listed) {
+    Unlist(hwnd);
+  } else if (manageable && toFront && order.front() != hwnd) {
+    Unlist(hwnd);
+    order.insert(order.begin(), hwnd);
+  }
+  entry.listed = manageable;
+}
+
+void WindowRegistry::OnWindowEvent(HWND hwnd, WindowEvent event) {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (!live || dirty)
+    return; // La próxima lectura enumera desde cero
+
+  switch (event) {
+  case WE_DESTROYED: {
+    auto it = entries.find(hwnd);
+    if (it == entries.end())
+      return; // Ventanas hijas y desconocidas
+    if (it->second.listed)
+      Unlist(hwnd);
+    entries.erase(it);
+    break;
+  }
+  case WE_FOREGROUND:
+  case WE_SHOWN:
+  case WE_CREATED:
+    Refresh(hwnd, true);
+    break;
+  case WE_TITLE_CHANGED:
+    if (titleDependent) {
+      auto it = entries.find(hwnd);
+      if (it != entries.end())
+        it->second.excluded = -1;
+    }
+    Refresh(hwnd, false);
+    break;
+  case WE_HIDDEN:
+  case WE_CLOAKED:
+  case WE_UNCLOAKED:
+    Refresh(hwnd, false);
+    break;
+  case WE_MOVED:
+    break; // La geometría no cambia si es gestionable
+  }
+}
+
+void WindowRegistry::Raise(HWND hwnd) {
+  std::lock_guard<std::mutex> lock(mtx);
+  auto it = entries.find(hwnd);
+  if (it == entries.end() || !it->second.listed || order.front() == hwnd)
+    return;
+  Unlist(hwnd);
+  order.insert(order.begin(), hwnd);
+}
+
+void WindowRegistry::Lower(HWND hwnd) {
+  std::lock_guard<std::mutex> lock(mtx);
+  auto it = entries.find(hwnd);
+  if (it == entries.end() || !it->second.listed || order.back() == hwnd)
+    return;
+  Unlist(hwnd);
+  order.push_back(hwnd);
+}
+
+WindowRegistry::Snapshot WindowRegistry::Windows() {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (!live || dirty)
+    Rescan();
+  if (!published || publishedGeneration != generation) {
+    published = std::make_shared<const std::vector<HWND>>(order);
+    publishedGeneration = generation;
+  }
+  return published;
+}
+
+bool WindowRegistry::Contains(HWND hwnd) {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (dirty)
+    Rescan();
+  auto it = entries.find(hwnd);
+  return it != entries.end() && it->second.listed;
+}
+
+uint64_t WindowRegistry::Generation() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  return generation;
+}
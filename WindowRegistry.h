@@ -0,0 +1,86 @@
+#ifndef WINDOW_REGISTRY_H
+#define WINDOW_REGISTRY_H
+
+#include "DesktopBackend.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Registro vivo de las ventanas gestionables
+ *
+ * Se llena con una enumeración completa y después se mantiene al día con
+ * los eventos del backend (creación, destrucción, mostrar/ocultar, cloak,
+ * cambio de título y foco). Cada acción lee la lista ya filtrada sin volver
+ * a enumerar ni a consultar estilo, título, DWM o exclusiones.
+ *
+ * El orden aproxima el orden Z: las ventanas que aparecen o reciben el foco
+ * pasan al frente. Generation() cambia cada vez que cambia la lista.
+ *
+ * Si el backend no entrega eventos (SetLive(false)), cada lectura vuelve a
+ * enumerar, igual que antes de existir el registro.
+ *
+ * Los eventos llegan en el hilo de mensajes y las lecturas desde los hilos
+ * de acciones, así que todo el estado va bajo un mutex. Windows() devuelve
+ * una foto inmutable y compartida: se copia una vez por generación y las
+ * lecturas siguientes reciben la misma sin copiar; un evento posterior no
+ * la toca, crea otra.
+ */
+class WindowRegistry {
+public:
+  using ExclusionCheck = std::function<bool(HWND hwnd)>;
+  using Snapshot = std::shared_ptr<const std::vector<HWND>>;
+
+  WindowRegistry(DesktopBackend *backend, ExclusionCheck isExcluded);
+
+  void SetLive(bool live) { this->live = live; }
+  bool IsLive() const { return live; }
+  // La exclusión mira el título (reglas "title:"): se vuelve a evaluar en
+  // cada cambio de título en vez de guardarse una vez por ventana
+  void SetTitleDependent(bool dependent);
+
+  // Fuerza una enumeración completa en la próxima lectura (p.ej. al cambiar
+  // la lista de exclusión)
+  void Invalidate();
+
+  void OnWindowEvent(HWND hwnd, WindowEvent event);
+
+  // Orden Z propio (BringToFront / SendToBack)
+  void Raise(HWND hwnd);
+  void Lower(HWND hwnd);
+
+  Snapshot Windows();
+  // Tras Invalidate() también enumera antes de responder: sin eso, una
+  // ventana gestionable daría false hasta la próxima lectura
+  bool Contains(HWND hwnd);
+  uint64_t Generation() const;
+
+private:
+  struct Entry {
+    bool listed;          // Está en 'order'
+    // -1 = sin evaluar; el PID no cambia, el título sí (titleDependent)
+    signed char excluded;
+  };
+
+  DesktopBackend *backend;
+  ExclusionCheck isExcluded;
+  mutable std::mutex mtx;
+  std::unordered_map<HWND, Entry> entries; // Ventanas de nivel superior vistas
+  std::vector<HWND> order;                 // Ventanas gestionables
+  uint64_t generation = 0;
+  Snapshot published;              // Foto de 'order' en publishedGeneration
+  uint64_t publishedGeneration = 0;
+  bool live = false;
+  bool dirty = true;
+  bool titleDependent = false;
+
+  void Rescan();
+  bool IsManageable(HWND hwnd, Entry &entry);
+  void Refresh(HWND hwnd, bool toFront);
+  void Unlist(HWND hwnd);
+};
+
+#endif // WINDOW_REGISTRY_H
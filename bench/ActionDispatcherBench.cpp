@@ -0,0 +1,120 @@
+#include "ActionDispatcher.h"
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Ráfaga de 50 hotkeys mezclados como llegan al bucle de mensajes: acciones
+// sobre 8 ventanas (5 ms, un SetWindowPos), lanzar apps (200 ms, un
+// ShellExecute lento) y dos "ordenar todas" exclusivas (80 ms). Compara la
+// latencia hasta que empieza cada acción ejecutándolas en el propio bucle
+// (una detrás de otra) y encolándolas en el pool de 3 hilos
+typedef std::chrono::steady_clock Clock;
+
+enum Kind { K_WINDOW, K_APP, K_ARRANGE };
+
+struct BurstAction {
+  Kind kind;
+  int window;
+  int costMs;
+};
+
+static double Ms(Clock::time_point from, Clock::time_point to) {
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+static std::vector<BurstAction> MakeBurst() {
+  std::vector<BurstAction> burst;
+  for (int i = 0; i < 50; ++i) {
+    if (i % 5 == 1)
+      burst.push_back({K_APP, 0, 200});
+    else if (i == 20 || i == 40)
+      burst.push_back({K_ARRANGE, 0, 80});
+    else
+      burst.push_back({K_WINDOW, i % 8, 5});
+  }
+  return burst;
+}
+
+static void Report(const char *name, std::vector<double> starts,
+                   const std::vector<BurstAction> &burst, double loopMs,
+                   double totalMs) {
+  double windowSum = 0;
+  int windows = 0;
+  for (size_t i = 0; i < burst.size(); ++i) {
+    if (burst[i].kind == K_WINDOW) {
+      windowSum += starts[i];
+      ++windows;
+    }
+  }
+  std::sort(starts.begin(), starts.end());
+  std::printf("%-10s %12.3f %10.1f %10.1f %12.1f %10.1f\n", name, loopMs,
+              starts[starts.size() / 2], starts.back(), windowSum / windows,
+              totalMs);
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  std::vector<BurstAction> burst = MakeBurst();
+  std::printf("%-10s %12s %10s %10s %12s %10s\n", "", "bucle (ms)",
+              "p50 (ms)", "max (ms)", "ventana (ms)", "total (ms)");
+
+  // En el bucle: cada acción empieza cuando acaban todas las anteriores y
+  // el bucle no atiende mensajes mientras tanto
+  std::vector<double> inlineStarts;
+  double elapsed = 0;
+  for (const BurstAction &action : burst) {
+    inlineStarts.push_back(elapsed);
+    elapsed += action.costMs;
+  }
+  Report("en bucle", inlineStarts, burst, elapsed, elapsed);
+
+  ActionDispatcher dispatcher(3);
+  std::vector<Clock::time_point> submitted(burst.size());
+  std::vector<double> starts(burst.size());
+  std::vector<std::vector<int>> perWindow(8);
+  std::mutex orderMutex;
+  std::atomic<int> running{0};
+  std::atomic<bool> exclusiveShared{false};
+
+  Clock::time_point begin = Clock::now();
+  for (size_t i = 0; i < burst.size(); ++i) {
+    const BurstAction action = burst[i];
+    submitted[i] = Clock::now();
+    auto body = [&, i, action]() {
+      starts[i] = Ms(submitted[i], Clock::now());
+      if (action.kind == K_ARRANGE && running.load() != 0)
+        exclusiveShared = true;
+      running++;
+      if (action.kind == K_WINDOW) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        perWindow[action.window].push_back((int)i);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(action.costMs));
+      running--;
+    };
+    if (action.kind == K_WINDOW)
+      dispatcher.Submit((ActionDispatcher::Lane)(uintptr_t)(0x100 +
+                                                           action.window),
+                        body);
+    else if (action.kind == K_APP)
+      dispatcher.Submit(ActionDispatcher::FREE, body);
+    else
+      dispatcher.SubmitExclusive(body);
+  }
+  double enqueueMs = Ms(begin, Clock::now());
+  dispatcher.WaitIdle();
+  Report("pool (3)", starts, burst, enqueueMs, Ms(begin, Clock::now()));
+
+  bool ordered = true;
+  for (const std::vector<int> &order : perWindow)
+    ordered = ordered && std::is_sorted(order.begin(), order.end());
+  std::printf("orden por ventana: %s, exclusivas solas: %s\n",
+              ordered ? "si" : "NO", exclusiveShared ? "NO" : "si");
+  return 0;
+}
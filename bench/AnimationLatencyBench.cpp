@@ -0,0 +1,167 @@
+#include "FakeDesktop.h"
+#include "Logger.h"
+#include "WindowManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Latencia de los hotkeys pulsados mientras se ordenan 20 ventanas con
+// animación. Un hilo hace de bucle de mensajes: saca los WM_HOTKEY de una
+// cola y ejecuta su manejador. El primero ordena las 20 ventanas; los
+// siguientes, uno cada 40 ms, solo anotan cuándo empezaron. Antes cada
+// ventana se animaba en el propio manejador (12 SetWindowPos con Sleep(10)
+// entre ellos, reproducido aquí); ahora el manejador entrega los destinos
+// al hilo del Animator y vuelve. Los tiempos son reales
+typedef std::chrono::steady_clock Clock;
+
+static const int WINDOWS = 20;
+static const int HOTKEYS = 30;
+static const int SPACING_MS = 40;
+
+// Bucle de mensajes: un manejador por hotkey, en orden de llegada
+class MessageLoop {
+public:
+  MessageLoop() : worker([this] { Run(); }) {}
+  ~MessageLoop() {
+    Post(nullptr);
+    worker.join();
+  }
+
+  void Post(std::function<void()> handler) {
+    std::lock_guard<std::mutex> lock(mtx);
+    queue.push_back(handler);
+    wake.notify_one();
+  }
+
+private:
+  std::deque<std::function<void()>> queue;
+  std::mutex mtx;
+  std::condition_variable wake;
+  std::thread worker;
+
+  void Run() {
+    for (;;) {
+      std::function<void()> handler;
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        wake.wait(lock, [this] { return !queue.empty(); });
+        handler = queue.front();
+        queue.pop_front();
+      }
+      if (!handler)
+        return;
+      handler();
+    }
+  }
+};
+
+// SmoothMoveWindow de antes: bloquea al llamador unos 120 ms por ventana
+static void OldSmoothMove(FakeDesktop &desk, HWND hwnd, int tx, int ty,
+                          int tw, int th) {
+  RECT sr;
+  desk.GetRect(hwnd, sr);
+  int sx = sr.left, sy = sr.top, sw = sr.right - sr.left,
+      sh = sr.bottom - sr.top;
+  if (sx == tx && sy == ty && sw == tw && sh == th)
+    return;
+  for (int i = 1; i <= 12; ++i) {
+    float f = std::sin(((float)i / 12) * (3.14159f / 2.0f));
+    desk.SetPos(hwnd, sx + (int)((tx - sx) * f), sy + (int)((ty - sy) * f),
+                sw + (int)((tw - sw) * f), sh + (int)((th - sh) * f),
+                SWP_NOZORDER | SWP_NOACTIVATE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  desk.SetPos(hwnd, tx, ty, tw, th, SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
+static double Ms(Clock::time_point from, Clock::time_point to) {
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// Pulsa el atajo de ordenar y después HOTKEYS atajos; devuelve lo que
+// esperó cada uno y cuánto ocupó el manejador de ordenar el bucle
+static std::vector<double> Press(const std::function<void()> &arrange,
+                                 double &arrangeMs) {
+  std::vector<Clock::time_point> posted(HOTKEYS), started(HOTKEYS);
+  {
+    MessageLoop loop;
+    loop.Post([&] {
+      Clock::time_point start = Clock::now();
+      arrange();
+      arrangeMs = Ms(start, Clock::now());
+    });
+    for (int i = 0; i < HOTKEYS; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(SPACING_MS));
+      posted[i] = Clock::now();
+      loop.Post([&started, i] { started[i] = Clock::now(); });
+    }
+  }
+  std::vector<double> waits;
+  for (int i = 0; i < HOTKEYS; ++i)
+    waits.push_back(Ms(posted[i], started[i]));
+  std::sort(waits.begin(), waits.end());
+  return waits;
+}
+
+static void Row(const char *name, const std::vector<double> &waits,
+                double arrangeMs) {
+  std::printf("%-24s %12.1f %12.3f %12.3f %12.3f\n", name, arrangeMs,
+              waits[waits.size() / 2], waits[waits.size() * 9 / 10],
+              waits.back());
+}
+
+static void Scatter(FakeDesktop &desk, const std::vector<HWND> &windows) {
+  unsigned seed = 5;
+  for (HWND hwnd : windows) {
+    seed = seed * 1103515245 + 12345;
+    int x = (int)((seed >> 8) % 1400), y = (int)((seed >> 4) % 600);
+    desk.SetPos(hwnd, x, y, 500, 400, SWP_NOZORDER | SWP_NOACTIVATE);
+  }
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  std::vector<HWND> windows;
+  for (int i = 0; i < WINDOWS; ++i)
+    windows.push_back(
+        desk.AddWindow("w" + std::to_string(i), 100, {0, 0, 500, 400}));
+  desk.SetCursor({960, 500});
+
+  std::printf("%d ventanas, %d hotkeys cada %d ms\n", WINDOWS, HOTKEYS,
+              SPACING_MS);
+  std::printf("%-24s %12s %12s %12s %12s\n", "", "ordenar (ms)",
+              "mediana (ms)", "p90 (ms)", "max (ms)");
+
+  // Antes: la rejilla de ArrangeAllWindowsNoOverlap animada en el bucle
+  Scatter(desk, windows);
+  double arrangeMs = 0;
+  std::vector<double> waits = Press(
+      [&] {
+        int cols = 5, rows = 4, cellW = 1920 / cols, cellH = 1040 / rows;
+        for (int i = 0; i < WINDOWS; ++i)
+          OldSmoothMove(desk, windows[i], (i % cols) * cellW + 6,
+                        (i / cols) * cellH + 6, cellW - 12, cellH - 12);
+      },
+      arrangeMs);
+  Row("animar en el manejador", waits, arrangeMs);
+
+  Scatter(desk, windows);
+  std::remove("AnimationLatencyBench.cfg");
+  WindowManager manager("AnimationLatencyBench.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(true);
+  waits = Press([&] { manager.ArrangeAllWindowsNoOverlap(); }, arrangeMs);
+  Row("hilo del Animator", waits, arrangeMs);
+  return 0;
+}
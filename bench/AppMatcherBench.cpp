@@ -0,0 +1,199 @@
+#include "AppMatcher.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Rendimiento del matcher compilado contra lo que hacía cada consulta antes,
+// con 20.000 nombres de ejecutable al azar (uno de cada ocho lleva dentro
+// alguna regla):
+//   - exclusiones: un find() por cada entrada de excludedApps, con 10 a
+//     1000 reglas, contra AppMatcher con las mismas subcadenas
+//   - lista blanca del Game Mode: pasar a minúsculas las 29 entradas por
+//     cada proceso y compararlas una a una, contra las reglas "=nombre"
+//   - reglas mezcladas (subcadenas, exactas, globs, clase y título), sin
+//     equivalente anterior, para ver cuánto crece el coste con las reglas
+// Los nombres ya llegan en minúsculas, como los da ProcessCache
+typedef std::chrono::steady_clock Clock;
+
+static const int NAMES = 20000;
+static const int ROUNDS = 20;
+
+static const char *WHITELIST[] = {
+    "explorer.exe", "svchost.exe", "csrss.exe", "wininit.exe",
+    "services.exe", "lsass.exe", "winlogon.exe", "dwm.exe", "smss.exe",
+    "taskhostw.exe", "RuntimeBroker.exe", "sihost.exe", "ctfmon.exe",
+    "smartscreen.exe", "conhost.exe", "System", "registry", "audiodg.exe",
+    "spoolsv.exe", "dasHost.exe", "SearchUI.exe", "ShellExperienceHost.exe",
+    "StandardCollector.Service.exe", "WmiPrvSE.exe", "Memory Compression",
+    "ntoskrnl.exe", "gestor_ven.exe", "ConfiguracionWinVen.exe", "cmd.exe"};
+
+static unsigned seed = 11;
+static int Rnd(int range) {
+  seed = seed * 1103515245 + 12345;
+  return (int)((seed >> 8) % range);
+}
+
+static std::string Word(int length) {
+  std::string s;
+  for (int i = 0; i < length; ++i)
+    s += (char)('a' + Rnd(26));
+  return s;
+}
+
+static double Ns(Clock::time_point from, long long count) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - from)
+             .count() /
+         count;
+}
+
+static void Row(const char *name, int rules, double oldNs, double newNs,
+                int oldHits, int newHits) {
+  std::printf("%-14s %7d %12.1f %12.1f %8d %8d\n", name, rules, oldNs, newNs,
+              oldHits, newHits);
+}
+
+// Nombres al azar; uno de cada ocho con una regla dentro
+static std::vector<std::string> Names(const std::vector<std::string> &rules) {
+  std::vector<std::string> names;
+  for (int i = 0; i < NAMES; ++i) {
+    std::string name = Word(4 + Rnd(12));
+    if (i % 8 == 0)
+      name += rules[Rnd((int)rules.size())];
+    names.push_back(name + ".exe");
+  }
+  return names;
+}
+
+static void Exclusions(int ruleCount) {
+  std::vector<std::string> rules;
+  for (int i = 0; i < ruleCount; ++i)
+    rules.push_back(Word(5 + Rnd(6)));
+  std::vector<std::string> names = Names(rules);
+  AppMatcher matcher;
+  matcher.Compile(rules);
+
+  int oldHits = 0, newHits = 0;
+  Clock::time_point start = Clock::now();
+  for (int round = 0; round < ROUNDS; ++round) {
+    oldHits = 0;
+    for (const std::string &name : names) {
+      for (const std::string &rule : rules) {
+        if (name.find(rule) != std::string::npos) {
+          oldHits++;
+          break;
+        }
+      }
+    }
+  }
+  double oldNs = Ns(start, (long long)ROUNDS * NAMES);
+
+  start = Clock::now();
+  for (int round = 0; round < ROUNDS; ++round) {
+    newHits = 0;
+    for (const std::string &name : names)
+      newHits += matcher.MatchesExe(name);
+  }
+  Row("exclusiones", ruleCount, oldNs, Ns(start, (long long)ROUNDS * NAMES),
+      oldHits, newHits);
+}
+
+static void Whitelist() {
+  std::vector<std::string> lower, rules;
+  for (const char *safe : WHITELIST) {
+    lower.push_back(AppMatcher::ToLower(safe));
+    rules.push_back("=" + std::string(safe));
+  }
+  std::vector<std::string> names;
+  for (int i = 0; i < NAMES; ++i)
+    names.push_back(i % 8 == 0 ? lower[Rnd((int)lower.size())]
+                               : Word(4 + Rnd(12)) + ".exe");
+  AppMatcher matcher;
+  matcher.Compile(rules);
+
+  int oldHits = 0, newHits = 0;
+  Clock::time_point start = Clock::now();
+  for (int round = 0; round < ROUNDS; ++round) {
+    oldHits = 0;
+    for (const std::string &name : names) {
+      for (const char *safe : WHITELIST) {
+        std::string safeLower = safe;
+        std::transform(safeLower.begin(), safeLower.end(), safeLower.begin(),
+                       ::tolower);
+        if (name == safeLower) {
+          oldHits++;
+          break;
+        }
+      }
+    }
+  }
+  double oldNs = Ns(start, (long long)ROUNDS * NAMES);
+
+  start = Clock::now();
+  for (int round = 0; round < ROUNDS; ++round) {
+    newHits = 0;
+    for (const std::string &name : names)
+      newHits += matcher.MatchesExe(name);
+  }
+  Row("lista blanca", (int)rules.size(), oldNs,
+      Ns(start, (long long)ROUNDS * NAMES), oldHits, newHits);
+}
+
+static void Mixed(int ruleCount) {
+  std::vector<std::string> rules, substrings;
+  for (int i = 0; i < ruleCount; ++i) {
+    std::string word = Word(5 + Rnd(6));
+    switch (i % 5) {
+    case 0:
+      rules.push_back(word);
+      substrings.push_back(word);
+      break;
+    case 1:
+      rules.push_back("=" + word + ".exe");
+      break;
+    case 2:
+      rules.push_back(word + "*.exe");
+      break;
+    case 3:
+      rules.push_back("class:" + word + "_*");
+      break;
+    default:
+      rules.push_back("title:*" + word + "*");
+      break;
+    }
+  }
+  std::vector<std::string> names = Names(substrings);
+  std::vector<std::string> classes, titles;
+  for (int i = 0; i < NAMES; ++i) {
+    classes.push_back(Word(8) + "_" + Word(4));
+    titles.push_back(Word(6) + " - " + Word(10));
+  }
+  AppMatcher matcher;
+  matcher.Compile(rules);
+
+  int hits = 0;
+  Clock::time_point start = Clock::now();
+  for (int round = 0; round < ROUNDS; ++round) {
+    hits = 0;
+    for (int i = 0; i < NAMES; ++i)
+      hits += matcher.Matches(names[i], &classes[i], &titles[i]);
+  }
+  std::printf("%-14s %7d %12s %12.1f %8s %8d\n", "mezcladas", ruleCount, "-",
+              Ns(start, (long long)ROUNDS * NAMES), "-", hits);
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  std::printf("%d nombres\n", NAMES);
+  std::printf("%-14s %7s %12s %12s %8s %8s\n", "", "reglas", "antes (ns)",
+              "matcher (ns)", "antes", "matcher");
+  for (int rules : {10, 100, 1000})
+    Exclusions(rules);
+  Whitelist();
+  for (int rules : {10, 100, 1000})
+    Mixed(rules);
+  return 0;
+}
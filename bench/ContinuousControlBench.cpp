@@ -0,0 +1,192 @@
+#include "KeyStateMachine.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// El hilo de control continuo sobre diez minutos simulados de teclado: un
+// gesto de Ctrl/Alt + WASD cada pocos segundos (toques y pulsaciones
+// largas) y, en la segunda pasada, escritura normal entre gestos. Compara
+// el bucle de sondeo original (GetAsyncKeyState y Sleep de 100 ms, o de
+// 16 ms con teclas pulsadas) con KeyStateMachine despertado por el hook,
+// que recibe todas las teclas del sistema pero duerme sin timeout mientras
+// no haya un paso pendiente. Da los despertares por segundo en reposo y la
+// latencia de la pulsación al primer movimiento
+typedef std::chrono::steady_clock Clock;
+typedef KeyStateMachine K;
+
+static const double SESSION_MS = 600000;
+static const double OLD_IDLE_MS = 100;
+static const double OLD_ACTIVE_MS = 16;
+static const int COST_ROUNDS = 200;
+
+struct Event {
+  double at;
+  int key; // -1: una tecla que no es del control continuo
+  bool down;
+};
+
+struct Result {
+  long long idleWakeups = 0;
+  double idleMs = 0;
+  std::vector<double> latencies;
+  long long steps = 0;
+};
+
+static unsigned seed = 7;
+static int Rnd(int range) {
+  seed = seed * 1103515245 + 12345;
+  return (int)((seed >> 8) % range);
+}
+
+static std::vector<Event> Session(bool typing) {
+  std::vector<Event> events;
+  double t = 1000;
+  while (t < SESSION_MS - 5000) {
+    double gap = 3000 + Rnd(9000);
+    // Escritura entre gestos: unas seis teclas por segundo
+    for (double k = t + 200; typing && k < t + gap - 500;
+         k += 120 + Rnd(100)) {
+      events.push_back({k, -1, true});
+      events.push_back({k + 40 + Rnd(40), -1, false});
+    }
+    t += gap;
+    int modifier = Rnd(3) == 0 ? K::K_ALT : K::K_CTRL;
+    int dir = Rnd(3) == 0 ? K::K_W : Rnd(2) ? K::K_A : K::K_D;
+    double press = t + 20 + Rnd(60) + Rnd(1000) / 1000.0;
+    double hold = Rnd(2) ? 40 + Rnd(60) : 200 + Rnd(1500);
+    events.push_back({t, modifier, true});
+    events.push_back({press, dir, true});
+    events.push_back({press + hold, dir, false});
+    events.push_back({press + hold + 30, modifier, false});
+    t = press + hold + 30;
+  }
+  std::sort(events.begin(), events.end(),
+            [](const Event &a, const Event &b) { return a.at < b.at; });
+  return events;
+}
+
+static bool Active(const K &keys) { return keys.NextDeadline() >= 0; }
+
+// Bucle original: cada vuelta lee las teclas y duerme 16 o 100 ms
+static Result Polling(const std::vector<Event> &events) {
+  Result result;
+  K keys;
+  size_t next = 0;
+  double activeSince = -1;
+  bool moved = false;
+  for (double now = 0; now < SESSION_MS;) {
+    while (next < events.size() && events[next].at <= now) {
+      const Event &e = events[next++];
+      bool was = Active(keys);
+      keys.OnKey(e.key, e.down, e.at);
+      if (!was && Active(keys)) {
+        activeSince = e.at;
+        moved = false;
+      }
+    }
+    bool activity = (keys.IsDown(K::K_W) || keys.IsDown(K::K_A) ||
+                     keys.IsDown(K::K_S) || keys.IsDown(K::K_D)) &&
+                    (keys.IsDown(K::K_CTRL) || keys.IsDown(K::K_ALT));
+    if (Active(keys)) {
+      if (!moved)
+        result.latencies.push_back(now - activeSince);
+      moved = true;
+      result.steps++;
+    } else {
+      result.idleWakeups++;
+    }
+    double sleep = activity ? OLD_ACTIVE_MS : OLD_IDLE_MS;
+    if (!Active(keys))
+      result.idleMs += sleep;
+    now += sleep;
+  }
+  return result;
+}
+
+// Hook + KeyStateMachine: despierta con cada tecla del sistema (el hook
+// corre en el bucle de mensajes del hilo) o al vencer un paso
+static Result EventDriven(const std::vector<Event> &events) {
+  Result result;
+  K keys;
+  K::Step step;
+  size_t next = 0;
+  double activeSince = -1, idleFrom = 0;
+  while (true) {
+    double deadline = keys.NextDeadline();
+    double eventAt = next < events.size() ? events[next].at : SESSION_MS;
+    bool byEvent = deadline < 0 || eventAt <= deadline;
+    double now = byEvent ? eventAt : deadline;
+    if (now >= SESSION_MS)
+      break;
+    bool wasActive = Active(keys);
+    if (byEvent) {
+      const Event &e = events[next++];
+      keys.OnKey(e.key, e.down, now);
+      if (!wasActive) {
+        result.idleWakeups++;
+        if (Active(keys)) {
+          activeSince = now;
+          result.idleMs += now - idleFrom;
+        }
+      }
+    }
+    while (keys.Poll(now, step)) {
+      if (!step.repeat)
+        result.latencies.push_back(now - activeSince);
+      result.steps++;
+    }
+    if (wasActive && !Active(keys))
+      idleFrom = now;
+  }
+  if (!Active(keys))
+    result.idleMs += SESSION_MS - idleFrom;
+  return result;
+}
+
+static void Row(const char *name, const Result &r) {
+  double sum = 0, worst = 0;
+  for (double l : r.latencies) {
+    sum += l;
+    worst = std::max(worst, l);
+  }
+  double mean = r.latencies.empty() ? 0 : sum / r.latencies.size();
+  std::printf("%-24s %16.2f %14.2f %14.2f %10lld\n", name,
+              r.idleWakeups * 1000.0 / r.idleMs, mean, worst, r.steps);
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  std::printf("%.0f s simulados\n", SESSION_MS / 1000);
+  std::printf("%-24s %16s %14s %14s %10s\n", "", "despert./s rep.",
+              "1er mov. (ms)", "peor (ms)", "pasos");
+  for (bool typing : {false, true}) {
+    std::vector<Event> events = Session(typing);
+    std::printf("%s (%zu eventos de tecla)\n",
+                typing ? "escribiendo entre gestos" : "sin escribir",
+                events.size());
+    Row("  sondeo 100/16 ms", Polling(events));
+    Row("  hook + maquina", EventDriven(events));
+  }
+
+  // Coste de la máquina por evento de tecla, con un Poll tras cada uno
+  // como hace el hilo
+  std::vector<Event> events = Session(true);
+  K keys;
+  K::Step step;
+  long long steps = 0;
+  Clock::time_point start = Clock::now();
+  for (int round = 0; round < COST_ROUNDS; ++round) {
+    keys.Reset();
+    for (const Event &e : events) {
+      keys.OnKey(e.key, e.down, e.at);
+      steps += keys.Poll(e.at, step);
+    }
+  }
+  double ns = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                  .count() /
+              ((double)COST_ROUNDS * events.size());
+  std::printf("OnKey + Poll: %.1f ns por evento (%lld pasos)\n", ns, steps);
+  return 0;
+}
@@ -0,0 +1,138 @@
+#include "EdgeSnapper.h"
+#include "FakeDesktop.h"
+#include "Logger.h"
+#include "WindowManager.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// El imán del control continuo con 100 a 1.000 ventanas al azar sobre dos
+// monitores: diez segundos de pasos a 60 Hz (600 pasos) de una ventana
+// que cruza la pantalla. Compara la consulta a los arrays ordenados con
+// rehacerlos en cada paso, y mide SnapStep del WindowManager cuando solo
+// se mueve la propia ventana (no se rehacen) y cuando en cada frame se
+// mueve otra (se rehacen). La última columna es la parte del frame de
+// 16,7 ms que se lleva el imán
+typedef std::chrono::steady_clock Clock;
+
+static const int STEPS = 600;
+static const double FRAME_US = 1000000.0 / 60;
+
+static unsigned seed = 9;
+static int Rnd(int range) {
+  seed = seed * 1103515245 + 12345;
+  return (int)((seed >> 8) % range);
+}
+
+// Pasos de 15 px en diagonal que rebotan en los bordes de los monitores
+static std::vector<PixelRect> Path() {
+  std::vector<PixelRect> path;
+  PixelRect r = {10, 10, 500, 350};
+  int dx = 15, dy = 9;
+  for (int i = 0; i <= STEPS; ++i) {
+    path.push_back(r);
+    if (r.x + dx < 0 || r.x + r.w + dx > 3840)
+      dx = -dx;
+    if (r.y + dy < 0 || r.y + r.h + dy > 1040)
+      dy = -dy;
+    r.x += dx;
+    r.y += dy;
+  }
+  return path;
+}
+
+static void Row(const char *name, int windows, double totalUs) {
+  double us = totalUs / STEPS;
+  std::printf("%-26s %8d %12.2f %10.3f%%\n", name, windows, us,
+              100.0 * us / FRAME_US);
+}
+
+static double Us(Clock::time_point from) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - from)
+      .count();
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  const PixelRect areas[] = {{0, 0, 1920, 1040}, {1920, 0, 1920, 1040}};
+  std::vector<PixelRect> path = Path();
+  std::printf("%-26s %8s %12s %11s\n", "", "ventanas", "us/paso",
+              "del frame");
+  for (int count : {100, 300, 1000}) {
+    std::vector<PixelRect> rects;
+    for (int i = 0; i < count; ++i)
+      rects.push_back({Rnd(3400), Rnd(700), 200 + Rnd(600), 150 + Rnd(400)});
+
+    EdgeSnapper snapper;
+    for (const PixelRect &r : rects)
+      snapper.AddWindow(r);
+    for (const PixelRect &area : areas)
+      snapper.AddGuides(area);
+    snapper.Finish();
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < STEPS; ++i) {
+      PixelRect to = path[i + 1];
+      snapper.Snap(path[i], to, EdgeSnapper::DEFAULT_THRESHOLD);
+    }
+    Row("arrays ordenados", count, Us(start));
+
+    start = Clock::now();
+    for (int i = 0; i < STEPS; ++i) {
+      EdgeSnapper fresh;
+      for (const PixelRect &r : rects)
+        fresh.AddWindow(r);
+      for (const PixelRect &area : areas)
+        fresh.AddGuides(area);
+      fresh.Finish();
+      PixelRect to = path[i + 1];
+      fresh.Snap(path[i], to, EdgeSnapper::DEFAULT_THRESHOLD);
+    }
+    Row("rehacer en cada paso", count, Us(start));
+
+    // Lo mismo a través del WindowManager sobre el escritorio simulado
+    FakeDesktop desk;
+    desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+    desk.AddMonitor({1920, 0, 3840, 1080}, {1920, 0, 3840, 1040});
+    desk.AddProcess(100, "app.exe");
+    std::vector<HWND> windows;
+    for (int i = 0; i < count; ++i) {
+      const PixelRect &r = rects[i];
+      windows.push_back(desk.AddWindow("w" + std::to_string(i), 100,
+                                       {r.x, r.y, r.x + r.w, r.y + r.h}));
+    }
+    HWND subject = desk.AddWindow("movida", 100, {10, 10, 510, 360});
+    std::remove("EdgeSnapperBench.cfg");
+    WindowManager manager("EdgeSnapperBench.cfg", &desk);
+    manager.SetSoundsEnabled(false);
+    manager.SetAnimationsEnabled(false);
+    PixelRect first = path[1];
+    manager.SnapStep(subject, path[0], first); // Llena índice y bordes
+
+    size_t rebuilds = manager.SnapRebuildCount();
+    start = Clock::now();
+    for (int i = 0; i < STEPS; ++i) {
+      PixelRect to = path[i + 1];
+      manager.SnapStep(subject, path[i], to);
+      desk.SetPos(subject, to.x, to.y, to.w, to.h, 0);
+      manager.NoteWindowMoved(subject);
+    }
+    Row("SnapStep, solo la propia", count, Us(start));
+    size_t quiet = manager.SnapRebuildCount() - rebuilds;
+
+    rebuilds = manager.SnapRebuildCount();
+    start = Clock::now();
+    for (int i = 0; i < STEPS; ++i) {
+      const PixelRect &r = rects[i % count];
+      int shift = (i & 1) ? 1 : 0;
+      desk.DragWindow(windows[i % count], {r.x + shift, r.y,
+                                           r.x + shift + r.w, r.y + r.h});
+      PixelRect to = path[i + 1];
+      manager.SnapStep(subject, path[i], to);
+    }
+    Row("SnapStep, otra se mueve", count, Us(start));
+    std::printf("%-26s %8s %12zu %12zu\n", "  (bordes rehechos)", "", quiet,
+                manager.SnapRebuildCount() - rebuilds);
+  }
+  return 0;
+}
@@ -0,0 +1,127 @@
+#include "FakeDesktop.h"
+#include "Logger.h"
+#include "ProcessCache.h"
+#include "WindowManager.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Filtro de exclusiones con 300 procesos y 100 ventanas: lo que costaba
+// antes (un snapshot de procesos por ventana y recorrerlo buscando su PID)
+// contra ProcessCache, que refresca todo con un snapshot por acción (aquí
+// la caché se deja caducar antes de cada pasada, el peor caso). La última
+// fila es el registro del WindowManager volviendo a filtrar tras un cambio
+// de exclusiones. En Windows cada snapshot es una llamada al kernel de
+// cientos de microsegundos; aquí se cuentan aparte
+typedef std::chrono::steady_clock Clock;
+
+static const int PROCESSES = 300;
+static const int WINDOWS = 100;
+static const int PASSES = 200;
+
+static const char *EXCLUDED[] = {"steam", "discord", "obs64", "nvidia",
+                                 "app17.exe", "app250.exe"};
+
+static bool Matches(const std::string &lowerName) {
+  for (const char *excluded : EXCLUDED) {
+    if (lowerName.find(excluded) != std::string::npos)
+      return true;
+  }
+  return false;
+}
+
+// IsExcluded de antes: un snapshot por ventana
+static bool ExcludedBySnapshot(FakeDesktop &desk, HWND hwnd) {
+  DWORD pid = desk.GetWindowPid(hwnd);
+  std::vector<ProcessDesc> processes;
+  desk.ListProcesses(processes);
+  for (const ProcessDesc &proc : processes) {
+    if (proc.pid == pid) {
+      std::string lower = proc.exeName;
+      std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+      return Matches(lower);
+    }
+  }
+  return false;
+}
+
+static bool ExcludedByCache(FakeDesktop &desk, ProcessCache &cache,
+                            HWND hwnd) {
+  const ProcessCache::Info *info = cache.Lookup(desk.GetWindowPid(hwnd));
+  return info && Matches(info->lowerName);
+}
+
+static void Row(const char *name, double us, long long snapshots,
+                int excluded) {
+  std::printf("%-28s %12.2f %14.2f %10d\n", name, us / PASSES,
+              (double)snapshots / PASSES, excluded);
+}
+
+static double Us(Clock::time_point from) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - from)
+      .count();
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  for (DWORD pid = 1; pid <= PROCESSES; ++pid)
+    desk.AddProcess(pid, "app" + std::to_string(pid) + ".exe");
+  std::vector<HWND> windows;
+  for (int i = 0; i < WINDOWS; ++i)
+    windows.push_back(desk.AddWindow("w" + std::to_string(i),
+                                     1 + (i * 7) % PROCESSES,
+                                     {0, 0, 300, 300}));
+
+  std::printf("%d procesos, %d ventanas\n", PROCESSES, WINDOWS);
+  std::printf("%-28s %12s %14s %10s\n", "", "us/pasada", "snapshots/pas.",
+              "excluidas");
+
+  int excluded = 0;
+  desk.ResetCounters();
+  Clock::time_point start = Clock::now();
+  for (int pass = 0; pass < PASSES; ++pass) {
+    excluded = 0;
+    for (HWND hwnd : windows)
+      excluded += ExcludedBySnapshot(desk, hwnd);
+  }
+  Row("snapshot por ventana (antes)", Us(start),
+      desk.Counters().listProcesses, excluded);
+
+  ProcessCache cache(&desk);
+  desk.ResetCounters();
+  double us = 0;
+  for (int pass = 0; pass < PASSES; ++pass) {
+    desk.SleepMs(10000); // Caducada: un snapshot en la pasada
+    start = Clock::now();
+    excluded = 0;
+    for (HWND hwnd : windows)
+      excluded += ExcludedByCache(desk, cache, hwnd);
+    us += Us(start);
+  }
+  Row("ProcessCache", us, desk.Counters().listProcesses, excluded);
+
+  std::remove("ExclusionFilterBench.cfg");
+  WindowManager manager("ExclusionFilterBench.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  for (const char *name : EXCLUDED)
+    manager.AddToExclusionList(name);
+  desk.ResetCounters();
+  us = 0;
+  for (int pass = 0; pass < PASSES; ++pass) {
+    desk.SleepMs(10000);
+    // Invalida el registro; solo se mide el filtrado que sigue
+    manager.AddToExclusionList("ninguna" + std::to_string(pass) + ".exe");
+    start = Clock::now();
+    excluded = WINDOWS - (int)manager.GetAllWindows()->size();
+    us += Us(start);
+  }
+  Row("WindowManager, tras invalidar", us, desk.Counters().listProcesses,
+      excluded);
+  return 0;
+}
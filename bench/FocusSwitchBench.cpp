@@ -0,0 +1,138 @@
+#include "FakeDesktop.h"
+#include "Logger.h"
+#include "WindowManager.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Ctrl + Alt + Izquierda/Derecha con 200 ventanas abiertas. Antes cada
+// pulsación enumeraba todas las ventanas (con un snapshot de procesos por
+// ventana en IsExcluded), buscaba la de primer plano recorriendo la lista y
+// saltaba a la vecina en orden Z; se reproduce aquí. Ahora
+// SwitchWindowFocus lee la lista MRU que mantienen los eventos de foco. Se
+// mide pulsando solo adelante, solo atrás y con el usuario enfocando otra
+// ventana al azar entre pulsación y pulsación (el evento no se mide). En
+// Windows cada enumeración y cada snapshot son llamadas al sistema; aquí
+// se cuentan aparte
+typedef std::chrono::steady_clock Clock;
+
+static const int WINDOWS = 200;
+static const int PROCESSES = 40;
+static const int SWITCHES = 100000;
+static const int OLD_SWITCHES = 200;
+
+static unsigned seed = 3;
+static int Rnd(int range) {
+  seed = seed * 1103515245 + 12345;
+  return (int)((seed >> 8) % range);
+}
+
+// GetAllWindows + IsExcluded de antes (sin exclusiones que acierten)
+static std::vector<HWND> OldGetAllWindows(FakeDesktop &desk) {
+  std::vector<HWND> all, filtered;
+  desk.ListTopLevelWindows(all);
+  for (HWND hwnd : all) {
+    if (!desk.IsVisible(hwnd))
+      continue;
+    LONG style = desk.GetStyle(hwnd);
+    if (!((style & WS_CAPTION) && !(style & WS_CHILD)))
+      continue;
+    if (desk.GetTitle(hwnd).empty() || desk.IsCloaked(hwnd))
+      continue;
+    DWORD pid = desk.GetWindowPid(hwnd);
+    std::vector<ProcessDesc> processes;
+    desk.ListProcesses(processes);
+    for (const ProcessDesc &proc : processes) {
+      if (proc.pid == pid) {
+        std::string lower = proc.exeName;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        break;
+      }
+    }
+    filtered.push_back(hwnd);
+  }
+  return filtered;
+}
+
+static void OldSwitch(FakeDesktop &desk, bool forward) {
+  std::vector<HWND> windows = OldGetAllWindows(desk);
+  if (windows.empty())
+    return;
+  HWND current = desk.GetForeground();
+  int currentIndex = 0;
+  for (int i = 0; i < (int)windows.size(); ++i) {
+    if (windows[i] == current) {
+      currentIndex = i;
+      break;
+    }
+  }
+  int n = (int)windows.size();
+  desk.ActivateWindow(windows[forward ? (currentIndex + 1) % n
+                                      : (currentIndex - 1 + n) % n]);
+}
+
+static double Us(Clock::time_point from) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - from)
+      .count();
+}
+
+static void Row(const char *name, double us, int switches, FakeDesktop &desk) {
+  std::printf("%-30s %12.3f %12.2f %12.2f\n", name, us / switches,
+              (double)desk.Counters().listWindows / switches,
+              (double)desk.Counters().listProcesses / switches);
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  for (DWORD pid = 1; pid <= PROCESSES; ++pid)
+    desk.AddProcess(pid, "app" + std::to_string(pid) + ".exe");
+  std::vector<HWND> windows;
+  for (int i = 0; i < WINDOWS; ++i)
+    windows.push_back(desk.AddWindow("w" + std::to_string(i),
+                                     1 + i % PROCESSES, {0, 0, 300, 300}));
+  desk.SetForeground(windows[0]);
+
+  std::printf("%d ventanas, %d procesos\n", WINDOWS, PROCESSES);
+  std::printf("%-30s %12s %12s %12s\n", "", "us/cambio", "enum./camb.",
+              "snapsh./cam.");
+
+  desk.ResetCounters();
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < OLD_SWITCHES; ++i)
+    OldSwitch(desk, true);
+  Row("enumerar por pulsacion", Us(start), OLD_SWITCHES, desk);
+
+  std::remove("FocusSwitchBench.cfg");
+  WindowManager manager("FocusSwitchBench.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  manager.SwitchWindowFocus(true); // Siembra el orden MRU
+
+  desk.ResetCounters();
+  start = Clock::now();
+  for (int i = 0; i < SWITCHES; ++i)
+    manager.SwitchWindowFocus(true);
+  Row("MRU, adelante", Us(start), SWITCHES, desk);
+
+  desk.ResetCounters();
+  start = Clock::now();
+  for (int i = 0; i < SWITCHES; ++i)
+    manager.SwitchWindowFocus(false);
+  Row("MRU, atras", Us(start), SWITCHES, desk);
+
+  desk.ResetCounters();
+  double us = 0;
+  for (int i = 0; i < SWITCHES; ++i) {
+    desk.SetForeground(windows[Rnd(WINDOWS)]);
+    start = Clock::now();
+    manager.SwitchWindowFocus(i % 2 == 0);
+    us += Us(start);
+  }
+  Row("MRU, con clics entre medias", us, SWITCHES, desk);
+  return 0;
+}
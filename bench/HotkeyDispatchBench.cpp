@@ -0,0 +1,195 @@
+#include "FakeDesktop.h"
+#include "HotkeyManager.h"
+#include "Logger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+// Despacho de WM_HOTKEY y altas con 500 atajos: la tabla plana de
+// HotkeyManager (vector por id con InlineCallback e índice de conflictos
+// por combinación) contra la estructura anterior (std::map por id,
+// std::function y HasConflict lineal), reproducida aquí. La tabla cubre
+// los ids [MIN_ID, MAX_ID), 400: las 500 altas son 400 ids nuevos más 100
+// que se desregistran y se vuelven a dar de alta con otra combinación, en
+// las dos estructuras igual. Se cuentan las reservas de memoria de cada
+// despacho y de cada alta
+typedef std::chrono::steady_clock Clock;
+
+static const int BINDINGS = 500;
+static const int EVENTS = 2000000;
+static const int ROUNDS = 50;
+
+static long long allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+// La estructura de antes, con las mismas llamadas al sistema y registros
+class MapHotkeys {
+public:
+  explicit MapHotkeys(DesktopBackend *backend) : backend(backend) {}
+
+  bool Register(int id, UINT modifiers, UINT vk,
+                std::function<void(int)> callback) {
+    if (hotkeys.count(id) || HasConflict(modifiers, vk))
+      return false;
+    if (!backend->RegisterSystemHotkey(NULL, id, modifiers, vk))
+      return false;
+    hotkeys[id] = {modifiers, vk, callback};
+    LOG_INFO(std::string("Hotkey registrado: ID=") + std::to_string(id) +
+             " " + HotkeyManager::ModifiersToString(modifiers) + "+" +
+             HotkeyManager::VkToString(vk));
+    return true;
+  }
+
+  bool Unregister(int id) {
+    auto it = hotkeys.find(id);
+    if (it == hotkeys.end())
+      return false;
+    backend->UnregisterSystemHotkey(NULL, id);
+    LOG_INFO(std::string("Hotkey desregistrado: ID=") + std::to_string(id));
+    hotkeys.erase(it);
+    return true;
+  }
+
+  void Process(int id) {
+    auto it = hotkeys.find(id);
+    if (it != hotkeys.end() && it->second.callback)
+      it->second.callback(id);
+  }
+
+  bool HasConflict(UINT modifiers, UINT vk) const {
+    for (const auto &pair : hotkeys) {
+      if (pair.second.modifiers == modifiers && pair.second.vk == vk)
+        return true;
+    }
+    return false;
+  }
+
+  void Clear() {
+    for (const auto &pair : hotkeys)
+      backend->UnregisterSystemHotkey(NULL, pair.first);
+    hotkeys.clear();
+  }
+
+private:
+  struct Info {
+    UINT modifiers;
+    UINT vk;
+    std::function<void(int)> callback;
+  };
+  DesktopBackend *backend;
+  std::map<int, Info> hotkeys;
+};
+
+// Combinación única de cada atajo: modificadores 1-15 x teclas desde '0'
+static UINT Mods(int i) { return 1 + i % 15; }
+static UINT Vk(int i) { return '0' + i / 15; }
+static int IdOf(int i) {
+  int table = HotkeyManager::MAX_ID - HotkeyManager::MIN_ID;
+  return HotkeyManager::MIN_ID + (i < table ? i : i - table);
+}
+
+static double Us(Clock::time_point from) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - from)
+      .count();
+}
+
+static void Row(const char *name, double nsEvent, double allocEvent,
+                double usBind, double allocBind, double nsConflict) {
+  std::printf("%-16s %12.2f %12.2f %14.2f %13.1f %14.2f\n", name, nsEvent,
+              allocEvent, usBind, allocBind, nsConflict);
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  const int table = HotkeyManager::MAX_ID - HotkeyManager::MIN_ID;
+  std::vector<int> ids(EVENTS);
+  unsigned seed = 1;
+  for (int &id : ids) {
+    seed = seed * 1103515245 + 12345;
+    id = HotkeyManager::MIN_ID + (int)((seed >> 8) % table);
+  }
+  FakeDesktop desk;
+  long long fired = 0;
+
+  // Tabla plana
+  double bindUs = 0;
+  long long bindAllocs = 0;
+  HotkeyManager *flat = nullptr;
+  for (int round = 0; round < ROUNDS; ++round) {
+    delete flat;
+    flat = new HotkeyManager(&desk);
+    long long before = allocations;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < BINDINGS; ++i) {
+      if (i >= table)
+        flat->UnregisterHotkey(IdOf(i));
+      flat->RegisterHotkey(IdOf(i), Mods(i), Vk(i),
+                           [&fired](int id) { fired += id; });
+    }
+    bindUs += Us(start);
+    bindAllocs += allocations - before;
+  }
+  long long before = allocations;
+  Clock::time_point start = Clock::now();
+  for (int id : ids)
+    flat->ProcessHotkey(id);
+  double flatNs = Us(start) * 1000.0 / EVENTS;
+  double flatAllocs = (double)(allocations - before) / EVENTS;
+  int conflicts = 0;
+  start = Clock::now();
+  for (int i = 0; i < EVENTS; ++i)
+    conflicts += flat->HasConflict(Mods(i % 600), Vk(i % 600));
+  double flatConflict = Us(start) * 1000.0 / EVENTS;
+  std::printf("%d atajos (%d vivos), %d eventos\n", BINDINGS, table, EVENTS);
+  std::printf("%-16s %12s %12s %14s %13s %14s\n", "", "ns/evento",
+              "reservas/ev.", "us/500 altas", "reservas/alta",
+              "ns/conflicto");
+  Row("tabla plana", flatNs, flatAllocs, bindUs / ROUNDS,
+      (double)bindAllocs / ROUNDS / BINDINGS, flatConflict);
+  delete flat;
+
+  // std::map + std::function, con el mismo callback
+  bindUs = 0;
+  bindAllocs = 0;
+  MapHotkeys old(&desk);
+  for (int round = 0; round < ROUNDS; ++round) {
+    old.Clear();
+    before = allocations;
+    start = Clock::now();
+    for (int i = 0; i < BINDINGS; ++i) {
+      if (i >= table)
+        old.Unregister(IdOf(i));
+      old.Register(IdOf(i), Mods(i), Vk(i),
+                   [&fired](int id) { fired += id; });
+    }
+    bindUs += Us(start);
+    bindAllocs += allocations - before;
+  }
+  before = allocations;
+  start = Clock::now();
+  for (int id : ids)
+    old.Process(id);
+  double mapNs = Us(start) * 1000.0 / EVENTS;
+  double mapAllocs = (double)(allocations - before) / EVENTS;
+  start = Clock::now();
+  for (int i = 0; i < EVENTS / 100; ++i)
+    conflicts += old.HasConflict(Mods(i % 600), Vk(i % 600));
+  double mapConflict = Us(start) * 1000.0 / (EVENTS / 100);
+  Row("map + function", mapNs, mapAllocs, bindUs / ROUNDS,
+      (double)bindAllocs / ROUNDS / BINDINGS, mapConflict);
+  std::printf("(%lld, %d)\n", fired, conflicts); // Que no se descarten
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "FakeDesktop.h"
+#include "Logger.h"
+#include "WindowManager.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Cómo escalan las operaciones de varias ventanas con 10 a 10.000 ventanas
+// sintéticas sobre dos monitores, sin animaciones. Cada operación se mide
+// varias veces sobre el mismo escritorio y se da la media
+static double TimeMs(int repeats, const std::function<void()> &action) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; ++i)
+    action();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repeats;
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  std::printf("%8s %12s %12s %12s %12s\n", "ventanas", "Tile (ms)",
+              "Arrange (ms)", "Master (ms)", "Cycle25 (us)");
+  for (int count : {10, 100, 1000, 10000}) {
+    FakeDesktop desk;
+    desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+    desk.AddMonitor({1920, 0, 3840, 1080}, {1920, 0, 3840, 1040});
+    for (DWORD pid = 100; pid < 116; ++pid)
+      desk.AddProcess(pid, "app" + std::to_string(pid) + ".exe");
+    std::vector<HWND> windows;
+    unsigned seed = 1;
+    for (int i = 0; i < count; ++i) {
+      seed = seed * 1103515245 + 12345;
+      int x = (int)((seed >> 8) % 3400), y = (int)((seed >> 4) % 700);
+      windows.push_back(desk.AddWindow("w" + std::to_string(i),
+                                       100 + i % 16,
+                                       {x, y, x + 400, y + 300}));
+    }
+    WindowManager manager("LayoutBench.cfg", &desk);
+    manager.SetSoundsEnabled(false);
+    manager.SetAnimationsEnabled(false);
+    desk.SetForeground(windows[0]);
+    manager.GetAllWindows(); // Llena el registro fuera de la medida
+
+    int repeats = count >= 10000 ? 1 : count >= 1000 ? 3 : 20;
+    double tile = TimeMs(repeats, [&] { manager.TileAllWindows(); });
+    double arrange =
+        TimeMs(repeats, [&] { manager.ArrangeAllWindowsNoOverlap(); });
+    double master = TimeMs(repeats, [&] { manager.TileMasterStack(); });
+    size_t next = 0;
+    double cycle = TimeMs(1000, [&] {
+      manager.CyclePosition25(windows[next]);
+      next = (next + 1) % windows.size();
+    });
+    std::printf("%8d %12.3f %12.3f %12.3f %12.2f\n", count, tile, arrange,
+                master, cycle * 1000.0);
+  }
+  return 0;
+}
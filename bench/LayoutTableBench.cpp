@@ -0,0 +1,127 @@
+#include "FakeDesktop.h"
+#include "LayoutTable.h"
+#include "Logger.h"
+#include "WindowManager.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Un atajo de layout con 200 ventanas sobre tres monitores: la tabla
+// precompilada contra lo que se hacía en cada pulsación (GetMonitorInfo de
+// la ventana y la cuenta en float de WindowLayout con el margen). Se mide
+// el rectángulo por los dos caminos, la pulsación entera con la tabla como
+// referencia y lo que cuesta reconstruir la tabla al cambiar monitores o
+// margen. En Windows cada GetMonitorInfo es una llamada al sistema; aquí
+// se cuentan aparte
+typedef std::chrono::steady_clock Clock;
+
+static const int WINDOWS = 200;
+static const int LOOKUPS = 1000000;
+static const int PRESSES = 20000;
+static const int REBUILDS = 10000;
+static const int MARGIN = 6;
+
+// La cuenta de antes, tal cual
+static PixelRect OldRect(const RECT &workArea, const WindowLayout &layout,
+                         int margin) {
+  int screenW = workArea.right - workArea.left;
+  int screenH = workArea.bottom - workArea.top;
+  int baseX = workArea.left + (int)(screenW * layout.x);
+  int baseY = workArea.top + (int)(screenH * layout.y);
+  int baseW = (int)(screenW * layout.width);
+  int baseH = (int)(screenH * layout.height);
+  int width = baseW - (margin * 2);
+  int height = baseH - (margin * 2);
+  if (width < 100)
+    width = 100;
+  if (height < 100)
+    height = 100;
+  return {baseX + margin, baseY + margin, width, height};
+}
+
+static double Ns(Clock::time_point from, int count) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - from)
+             .count() /
+         count;
+}
+
+static void Row(const char *name, double ns, double queries) {
+  std::printf("%-30s %12.1f %16.2f\n", name, ns, queries);
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddMonitor({1920, 0, 4480, 1440}, {1920, 0, 4480, 1400});
+  desk.AddMonitor({-1280, 0, 0, 1024}, {-1280, 0, 0, 984});
+  desk.AddProcess(100, "app.exe");
+  std::vector<HWND> windows;
+  unsigned seed = 17;
+  for (int i = 0; i < WINDOWS; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int x = (int)((seed >> 8) % 5400) - 1280, y = (int)((seed >> 4) % 600);
+    windows.push_back(desk.AddWindow("w" + std::to_string(i), 100,
+                                     {x, y, x + 300, y + 300}));
+  }
+  std::remove("LayoutTableBench.cfg");
+  WindowManager manager("LayoutTableBench.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  manager.SetMargin(MARGIN);
+  std::vector<WindowLayout> layouts = manager.GetLayouts();
+  int layoutCount = (int)layouts.size();
+
+  std::vector<MonitorDesc> monitors;
+  desk.ListMonitors(monitors);
+  LayoutTable table;
+  table.Rebuild(monitors, layouts, {}, MARGIN);
+  std::vector<HMONITOR> handles;
+  for (HWND hwnd : windows)
+    handles.push_back(desk.MonitorHandleForWindow(hwnd));
+
+  std::printf("%d ventanas, 3 monitores, %d layouts\n", WINDOWS, layoutCount);
+  std::printf("%-30s %12s %16s\n", "", "ns", "GetMonitorInfo");
+
+  // Solo el rectángulo
+  long long sum = 0;
+  desk.ResetCounters();
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < LOOKUPS; ++i) {
+    MonitorDesc mon;
+    if (desk.GetMonitorForWindow(windows[i % WINDOWS], mon))
+      sum += OldRect(mon.rcWork, layouts[i % layoutCount], MARGIN).x;
+  }
+  Row("rect: GetMonitorInfo + cuenta", Ns(start, LOOKUPS),
+      (double)desk.Counters().monitorQueries / LOOKUPS);
+
+  desk.ResetCounters();
+  start = Clock::now();
+  for (int i = 0; i < LOOKUPS; ++i) {
+    const PixelRect *r = table.LayoutRect(
+        table.FindMonitor(handles[i % WINDOWS]), i % layoutCount);
+    if (r)
+      sum += r->x;
+  }
+  Row("rect: tabla", Ns(start, LOOKUPS),
+      (double)desk.Counters().monitorQueries / LOOKUPS);
+
+  // La pulsación entera con la tabla: también el punto de deshacer y el
+  // paso del movimiento al hilo de MoveDispatcher, que no dependen de ella
+  manager.ApplyLayout(windows[0], 0); // Construye la tabla
+  desk.ResetCounters();
+  start = Clock::now();
+  for (int i = 0; i < PRESSES; ++i)
+    manager.ApplyLayout(windows[i % WINDOWS], i % layoutCount);
+  Row("ApplyLayout entero (tabla)", Ns(start, PRESSES),
+      (double)desk.Counters().monitorQueries / PRESSES);
+
+  // Reconstrucción (cambio de monitores, área de trabajo o margen)
+  start = Clock::now();
+  for (int i = 0; i < REBUILDS; ++i)
+    table.Rebuild(monitors, layouts, {}, MARGIN + (i & 1));
+  Row("reconstruir la tabla", Ns(start, REBUILDS), 0);
+  std::printf("(%lld)\n", sum); // Que no se descarte
+  return 0;
+}
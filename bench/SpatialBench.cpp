@@ -0,0 +1,143 @@
+#include "FakeDesktop.h"
+#include "Logger.h"
+#include "WindowManager.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Navegación por dirección con 1.000 ventanas al azar sobre cuatro
+// monitores en 2x2. Compara la consulta al índice espacial con barrer
+// todas las ventanas pidiendo su rectángulo (lo que haría falta sin
+// índice) y mide la primera consulta tras invalidar el registro (cambio de
+// exclusiones), que vuelve a llenar el índice. Los tiempos descuentan el
+// cambio de foco simulado
+typedef std::chrono::steady_clock Clock;
+
+static const int WINDOWS = 1000;
+static const int QUERIES = 20000;
+static const int INVALIDATIONS = 20;
+
+static double Us(Clock::time_point from) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - from)
+      .count();
+}
+
+// La más cercana en la dirección pedida mirando el rectángulo de todas
+static HWND Sweep(FakeDesktop &desk, const std::vector<HWND> &windows,
+                  HWND from, SpatialIndex::Direction dir) {
+  RECT a;
+  if (!desk.GetRect(from, a))
+    return NULL;
+  long long ax = (a.left + a.right) / 2, ay = (a.top + a.bottom) / 2;
+  HWND best = NULL;
+  long long bestDist = 0;
+  for (HWND hwnd : windows) {
+    RECT b;
+    if (hwnd == from || !desk.GetRect(hwnd, b))
+      continue;
+    long long dx = (b.left + b.right) / 2 - ax;
+    long long dy = (b.top + b.bottom) / 2 - ay;
+    bool ahead = dir == SpatialIndex::DIR_LEFT    ? dx < 0
+                 : dir == SpatialIndex::DIR_RIGHT ? dx > 0
+                 : dir == SpatialIndex::DIR_UP    ? dy < 0
+                                                  : dy > 0;
+    long long dist = dx * dx + dy * dy;
+    if (ahead && (!best || dist < bestDist)) {
+      best = hwnd;
+      bestDist = dist;
+    }
+  }
+  return best;
+}
+
+static void Row(const char *name, double us, double getRect, double lists) {
+  std::printf("%-22s %12.2f %14.1f %14.2f\n", name, us, getRect, lists);
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddMonitor({1920, 0, 3840, 1080}, {1920, 0, 3840, 1040});
+  desk.AddMonitor({0, 1080, 1920, 2160}, {0, 1080, 1920, 2120});
+  desk.AddMonitor({1920, 1080, 3840, 2160}, {1920, 1080, 3840, 2120});
+  for (DWORD pid = 100; pid < 116; ++pid)
+    desk.AddProcess(pid, "app" + std::to_string(pid) + ".exe");
+  std::vector<HWND> windows;
+  unsigned seed = 3;
+  auto rnd = [&seed](int range) {
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 8) % range);
+  };
+  for (int i = 0; i < WINDOWS; ++i) {
+    int x = rnd(3600), y = rnd(2000);
+    windows.push_back(desk.AddWindow("w" + std::to_string(i), 100 + i % 16,
+                                     {x, y, x + 200 + rnd(400),
+                                      y + 150 + rnd(300)}));
+  }
+
+  std::remove("SpatialBench.cfg"); // Sin las exclusiones de otra pasada
+  WindowManager manager("SpatialBench.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  desk.SetForeground(windows[0]);
+  manager.FocusInDirection(SpatialIndex::DIR_LEFT); // Llena el índice
+
+  // Coste del cambio de foco simulado, que se descuenta de cada consulta
+  std::vector<HWND> picks(QUERIES);
+  for (HWND &hwnd : picks)
+    hwnd = windows[rnd(WINDOWS)];
+  Clock::time_point start = Clock::now();
+  for (HWND hwnd : picks)
+    desk.SetForeground(hwnd);
+  double base = Us(start) / QUERIES;
+
+  std::printf("%d ventanas, 4 monitores\n", WINDOWS);
+  std::printf("%-22s %12s %14s %14s\n", "", "us/consulta",
+              "GetRect/cons.", "enumer./cons.");
+
+  desk.ResetCounters();
+  start = Clock::now();
+  for (int i = 0; i < QUERIES; ++i) {
+    desk.SetForeground(picks[i]);
+    manager.FocusInDirection((SpatialIndex::Direction)(i & 3));
+  }
+  double indexed = Us(start) / QUERIES - base;
+  Row("indice espacial", indexed,
+      (double)desk.Counters().getRect / QUERIES,
+      (double)desk.Counters().listWindows / QUERIES);
+
+  WindowRegistry::Snapshot snapshot = manager.GetAllWindows();
+  desk.ResetCounters();
+  start = Clock::now();
+  for (int i = 0; i < QUERIES; ++i) {
+    desk.SetForeground(picks[i]);
+    HWND target = Sweep(desk, *snapshot, picks[i],
+                        (SpatialIndex::Direction)(i & 3));
+    if (target)
+      desk.ActivateWindow(target);
+  }
+  double swept = Us(start) / QUERIES - base;
+  Row("barrido (sin indice)", swept,
+      (double)desk.Counters().getRect / QUERIES,
+      (double)desk.Counters().listWindows / QUERIES);
+
+  // Cada cambio de exclusiones vuelve a enumerar y a llenar el índice en la
+  // primera consulta; solo se mide esa consulta
+  double reseed = 0;
+  long long getRect = 0, lists = 0;
+  for (int i = 0; i < INVALIDATIONS; ++i) {
+    desk.SetForeground(picks[i]);
+    manager.AddToExclusionList("ninguna" + std::to_string(i) + ".exe");
+    desk.ResetCounters();
+    start = Clock::now();
+    manager.FocusInDirection((SpatialIndex::Direction)(i & 3));
+    reseed += Us(start);
+    getRect += desk.Counters().getRect;
+    lists += desk.Counters().listWindows;
+  }
+  Row("tras invalidar", reseed / INVALIDATIONS,
+      (double)getRect / INVALIDATIONS, (double)lists / INVALIDATIONS);
+  return 0;
+}
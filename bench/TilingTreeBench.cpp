@@ -0,0 +1,64 @@
+#include "TilingTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 10.000 ediciones al azar (mitad altas, mitad bajas) sobre árboles de
+// alrededor de 16 a 1024 ventanas, cada una seguida de TakeChanges como en
+// el auto-tiling. Compara las ventanas que se mueven por edición con las
+// que movería rehacer el mosaico entero (todas las vivas)
+int main() {
+  const int OPS = 10000;
+  std::printf("%8s %12s %12s %14s %14s %10s\n", "ventanas", "total (ms)",
+              "ns/edicion", "movidas/edic.", "mosaico/edic.", "profund.");
+  for (int target : {16, 64, 256, 1024}) {
+    std::mt19937 rng(3);
+    TilingTree tree;
+    tree.SetArea({0, 0, 1920, 1040}, 6);
+    std::vector<HWND> live;
+    std::vector<WindowPos> changes;
+    uintptr_t next = 1;
+    for (int i = 0; i < target; ++i) {
+      HWND hwnd = (HWND)next++;
+      tree.Insert(hwnd);
+      live.push_back(hwnd);
+    }
+    tree.TakeChanges(changes);
+
+    long long moved = 0, alive = 0;
+    int maxDepth = 0;
+    double ns = 0;
+    for (int op = 0; op < OPS; ++op) {
+      bool insert = live.size() < 2 ||
+                    (rng() % 2 && (int)live.size() < target * 2);
+      size_t victim = insert ? 0 : rng() % live.size();
+      auto start = std::chrono::steady_clock::now();
+      if (insert) {
+        HWND hwnd = (HWND)next++;
+        tree.Insert(hwnd);
+        live.push_back(hwnd);
+      } else {
+        tree.Remove(live[victim]);
+      }
+      changes.clear();
+      tree.TakeChanges(changes);
+      ns += std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start)
+                .count();
+      if (!insert) {
+        live[victim] = live.back();
+        live.pop_back();
+      }
+      moved += (long long)changes.size();
+      alive += (long long)live.size();
+      maxDepth = std::max(maxDepth, tree.Depth());
+    }
+    std::printf("%8d %12.2f %12.0f %14.2f %14.1f %10d\n", target, ns / 1e6,
+                ns / OPS, (double)moved / OPS, (double)alive / OPS,
+                maxDepth);
+  }
+  return 0;
+}
@@ -0,0 +1,129 @@
+#include "FakeDesktop.h"
+#include "Logger.h"
+#include "WindowManager.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Lo que lee cada acción (cambiar de ventana, ordenar, guardar la sesión)
+// con cientos de ventanas abiertas: el GetAllWindows de antes, que
+// enumeraba todas las ventanas y pasaba cada una por el filtro y por
+// IsExcluded (un snapshot de procesos por ventana), contra el registro vivo
+// del WindowManager. El registro se mide sin cambios entre acciones y con
+// una ventana que se oculta o se muestra antes de cada una (generación
+// nueva: una copia de la lista). Una de cada diez ventanas es de un
+// proceso excluido y otras tantas no son gestionables (ocultas, con cloak o
+// sin título). En Windows cada enumeración y cada snapshot son llamadas al
+// sistema; aquí se cuentan aparte
+typedef std::chrono::steady_clock Clock;
+
+static const int SIZES[] = {100, 300, 600};
+static const int PROCESSES = 50;
+static const char *EXCLUDED = "excluida.exe";
+
+// GetAllWindows + IsExcluded de antes, sobre el backend
+static std::vector<HWND> OldGetAllWindows(FakeDesktop &desk) {
+  std::vector<HWND> all, filtered;
+  desk.ListTopLevelWindows(all);
+  for (HWND hwnd : all) {
+    if (!desk.IsVisible(hwnd))
+      continue;
+    LONG style = desk.GetStyle(hwnd);
+    if (!((style & WS_CAPTION) && !(style & WS_CHILD)))
+      continue;
+    if (desk.GetTitle(hwnd).empty() || desk.IsCloaked(hwnd))
+      continue;
+    DWORD pid = desk.GetWindowPid(hwnd);
+    std::vector<ProcessDesc> processes;
+    desk.ListProcesses(processes);
+    bool excluded = false;
+    for (const ProcessDesc &proc : processes) {
+      if (proc.pid == pid) {
+        std::string lower = proc.exeName;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        excluded = lower.find(EXCLUDED) != std::string::npos;
+        break;
+      }
+    }
+    if (!excluded)
+      filtered.push_back(hwnd);
+  }
+  return filtered;
+}
+
+static void Row(const char *name, double us, int actions, FakeDesktop &desk,
+                size_t listed) {
+  std::printf("%-28s %12.2f %12.2f %12.2f %9zu\n", name, us / actions,
+              (double)desk.Counters().listWindows / actions,
+              (double)desk.Counters().listProcesses / actions, listed);
+}
+
+static double Us(Clock::time_point from) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - from)
+      .count();
+}
+
+static void Run(int windows) {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  for (DWORD pid = 1; pid < PROCESSES; ++pid)
+    desk.AddProcess(pid, "app" + std::to_string(pid) + ".exe");
+  desk.AddProcess(PROCESSES, EXCLUDED);
+  std::vector<HWND> all;
+  for (int i = 0; i < windows; ++i) {
+    DWORD pid = i % 10 == 0 ? PROCESSES : 1 + i % (PROCESSES - 1);
+    HWND hwnd = desk.AddWindow(i % 10 == 5 ? "" : "w" + std::to_string(i),
+                               pid, {0, 0, 300, 300});
+    if (i % 10 == 3)
+      desk.SetVisible(hwnd, false);
+    if (i % 10 == 7)
+      desk.SetCloaked(hwnd, true);
+    all.push_back(hwnd);
+  }
+  // Menos acciones cuanto más cara es cada una
+  const int oldActions = 20000 / windows, actions = 200000;
+
+  std::printf("\n%d ventanas\n", windows);
+  std::printf("%-28s %12s %12s %12s %9s\n", "", "us/accion", "enum./acc.",
+              "snapsh./acc.", "listadas");
+  size_t listed = 0;
+  desk.ResetCounters();
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < oldActions; ++i)
+    listed = OldGetAllWindows(desk).size();
+  Row("EnumWindows por accion", Us(start), oldActions, desk, listed);
+
+  std::remove("WindowRegistryBench.cfg");
+  WindowManager manager("WindowRegistryBench.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  manager.AddToExclusionList(EXCLUDED);
+  manager.GetAllWindows(); // Primera enumeración
+  desk.ResetCounters();
+  start = Clock::now();
+  for (int i = 0; i < actions; ++i)
+    listed = manager.GetAllWindows()->size();
+  Row("registro, sin cambios", Us(start), actions, desk, listed);
+
+  // Una ventana gestionable que se oculta y vuelve: el evento no se mide
+  HWND toggled = all[1];
+  desk.ResetCounters();
+  double us = 0;
+  for (int i = 0; i < actions / 10; ++i) {
+    desk.SetVisible(toggled, i % 2 != 0);
+    start = Clock::now();
+    listed = manager.GetAllWindows()->size();
+    us += Us(start);
+  }
+  Row("registro, tras un evento", us, actions / 10, desk, listed);
+}
+
+int main() {
+  WinVenLogger::SetEnabled(false);
+  for (int windows : SIZES)
+    Run(windows);
+  return 0;
+}
@@ -17,7 +17,7 @@ if %ERRORLEVEL% NEQ 0 (
 )
 
 echo [2/2] Compilando gestor_ven.exe...
-g++ -o app/gestor_ven.exe gestor_ven.cpp ConfigGUI.cpp WindowManager.cpp ConfigManager.cpp Logger.cpp HotkeyManager.cpp %MAIN_RES% -mwindows -static -static-libgcc -static-libstdc++ -lole32 -loleaut32 -luuid -lshlwapi -ldwmapi -lgdiplus -lcomctl32 -luxtheme
+g++ -o app/gestor_ven.exe gestor_ven.cpp ConfigGUI.cpp WindowManager.cpp Animator.cpp AppMatcher.cpp LayoutTable.cpp MonitorTopology.cpp ProcessCache.cpp WindowRegistry.cpp Win32Backend.cpp ConfigManager.cpp Logger.cpp HotkeyManager.cpp ActionDispatcher.cpp MoveDispatcher.cpp GeometryTransaction.cpp GeometryJournal.cpp CellAssignment.cpp TilingTree.cpp FocusOrder.cpp SpatialIndex.cpp EdgeSnapper.cpp KeymapProfiles.cpp KeymapTrie.cpp KeyStateMachine.cpp ContinuousMotion.cpp %MAIN_RES% -mwindows -static -static-libgcc -static-libstdc++ -lole32 -loleaut32 -luuid -lshlwapi -ldwmapi -lgdiplus -lcomctl32 -luxtheme
 if %ERRORLEVEL% NEQ 0 (
     echo [ERROR] Fallo al compilar gestor_ven.exe
     pause
@@ -1,8 +1,12 @@
+#include "ActionDispatcher.h"
 #include "ConfigGUI.h"
 #include "ConfigManager.h"
+#include "ContinuousMotion.h"
 #include "HotkeyManager.h"
+#include "KeyStateMachine.h"
 #include "Logger.h"
 #include "WindowManager.h"
+#include <chrono>
 #include <cstring>
 #include <ctime>
 #include <fstream>
@@ -16,16 +20,10 @@
 // Configuración de movimiento/redimensionado
 #define MOVE_STEP 15        // Pixeles por paso
 #define RESIZE_STEP 15      // Pixeles por paso
-#define CONTINUOUS_DELAY 16 // ~60 FPS (16ms)
-#define INITIAL_DELAY 150   // Delay inicial antes de movimiento continuo
 #define MIN_WINDOW_SIZE 100 // Tamano minimo de ventana
 
-// Estado global para control continuo
-bool isMoving = false;
-bool isResizing = false;
-
 // Función para mover ventana suavemente
-void MoveWindowSmooth(HWND hwnd, int dx, int dy) {
+void MoveWindowSmooth(WindowManager *manager, HWND hwnd, int dx, int dy) {
   if (!hwnd)
     return;
 
@@ -37,11 +35,19 @@ void MoveWindowSmooth(HWND hwnd, int dx, int dy) {
   int width = r.right - r.left;
   int height = r.bottom - r.top;
 
-  // Obtener límites del monitor
-  HMONITOR hMon = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
-  MONITORINFO mi = {sizeof(mi)};
-  GetMonitorInfo(hMon, &mi);
-  RECT workArea = mi.rcWork;
+  // Imán: pegarse a los bordes de otras ventanas y del monitor
+  PixelRect from = {(int)r.left, (int)r.top, width, height};
+  PixelRect to = {newX, newY, width, height};
+  if (manager->SnapStep(hwnd, from, to)) {
+    newX = to.x;
+    newY = to.y;
+  }
+
+  // Límites del monitor, de la topología en caché (sin GetMonitorInfo)
+  MonitorDesc mon;
+  if (!manager->GetMonitorFor(hwnd, mon))
+    return;
+  RECT workArea = mon.rcWork;
 
   // Limitar a los bordes del monitor (permitir que parte de la ventana salga)
   if (newX < workArea.left - width + 50)
@@ -58,7 +64,8 @@ void MoveWindowSmooth(HWND hwnd, int dx, int dy) {
 }
 
 // Función para redimensionar ventana suavemente
-void ResizeWindowSmooth(HWND hwnd, int dw, int dh, int anchorX, int anchorY) {
+void ResizeWindowSmooth(WindowManager *manager, HWND hwnd, int dw, int dh,
+                        int anchorX, int anchorY) {
   if (!hwnd)
     return;
 
@@ -84,6 +91,17 @@ void ResizeWindowSmooth(HWND hwnd, int dw, int dh, int anchorX, int anchorY) {
     height += dh;
   }
 
+  // Imán solo para el borde que se mueve
+  PixelRect from = {(int)r.left, (int)r.top, (int)(r.right - r.left),
+                    (int)(r.bottom - r.top)};
+  PixelRect to = {x, y, width, height};
+  if (manager->SnapStep(hwnd, from, to)) {
+    x = to.x;
+    y = to.y;
+    width = to.w;
+    height = to.h;
+  }
+
   if (width < MIN_WINDOW_SIZE) {
     if (anchorX == -1)
       x -= (MIN_WINDOW_SIZE - width);
@@ -95,10 +113,10 @@ void ResizeWindowSmooth(HWND hwnd, int dw, int dh, int anchorX, int anchorY) {
     height = MIN_WINDOW_SIZE;
   }
 
-  HMONITOR hMon = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
-  MONITORINFO mi = {sizeof(mi)};
-  GetMonitorInfo(hMon, &mi);
-  RECT workArea = mi.rcWork;
+  MonitorDesc mon;
+  if (!manager->GetMonitorFor(hwnd, mon))
+    return;
+  RECT workArea = mon.rcWork;
   int maxWidth = workArea.right - workArea.left;
   int maxHeight = workArea.bottom - workArea.top;
 
@@ -110,129 +128,171 @@ void ResizeWindowSmooth(HWND hwnd, int dw, int dh, int anchorX, int anchorY) {
   SetWindowPos(hwnd, NULL, x, y, width, height, SWP_NOZORDER | SWP_NOACTIVATE);
 }
 
+// Perfiles de teclado de config.json:
+//   "profiles": "editores, juegos"
+//   "profiles.editores.match": "code.exe, =devenv.exe, class:SunAwtFrame"
+//   "profiles.editores.disable": "move, resize"
+static void LoadKeymapProfiles(ConfigManager &config, WindowManager &manager) {
+  std::vector<KeymapProfiles::Spec> specs;
+  std::string names = config.GetString("profiles");
+  size_t start = 0;
+  while (start <= names.size()) {
+    size_t end = names.find(',', start);
+    if (end == std::string::npos)
+      end = names.size();
+    std::string name = names.substr(start, end - start);
+    name.erase(0, name.find_first_not_of(" \t"));
+    name.erase(name.find_last_not_of(" \t") + 1);
+    start = end + 1;
+    if (name.empty())
+      continue;
+
+    KeymapProfiles::Spec spec;
+    std::string prefix = "profiles." + name;
+    if (KeymapProfiles::ParseSpec(name, config.GetString(prefix + ".match"),
+                                  config.GetString(prefix + ".disable"),
+                                  spec))
+      specs.push_back(spec);
+    else
+      LOG_ERROR("Perfil de teclado invalido: " + name);
+  }
+
+  manager.GetKeymapProfiles().Compile(specs, HotkeyManager::MIN_ID,
+                                      HotkeyManager::MAX_ID);
+  manager.SelectKeymapProfile(GetForegroundWindow());
+}
+
+// Estado del control continuo: solo lo toca el hilo de control (el hook de
+// teclado de bajo nivel se ejecuta dentro de su bucle de mensajes)
+static KeyStateMachine controlKeys;
+static ContinuousMotion controlMotion;
+static WindowManager *controlManager = nullptr;
+
+static double ControlNowMs() {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+LRESULT CALLBACK ControlKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam) {
+  if (nCode == HC_ACTION) {
+    KBDLLHOOKSTRUCT *kb = (KBDLLHOOKSTRUCT *)lParam;
+    int key = KeyStateMachine::KeyFromVk(kb->vkCode);
+    if (key >= 0) {
+      // Si el modo juego está activado, deshabilitar movimientos continuos
+      if (controlManager && controlManager->IsGameMode()) {
+        controlKeys.Reset();
+      } else {
+        bool down = (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN);
+        controlKeys.OnKey(key, down, ControlNowMs());
+      }
+    }
+  }
+  return CallNextHookEx(NULL, nCode, wParam, lParam);
+}
+
 // Thread para manejar movimiento continuo con Ctrl + WASD
 DWORD WINAPI ContinuousControlThread(LPVOID lpParam) {
-  WindowManager *manager = (WindowManager *)lpParam;
-
-  bool wasMoving = false;
-  bool wasResizing = false;
-  DWORD moveStartTime = 0;
-  DWORD resizeStartTime = 0;
+  controlManager = (WindowManager *)lpParam;
+
+  // Sin sondeo: el hook entrega pulsaciones y el hilo duerme en
+  // MsgWaitForMultipleObjects mientras no haya nada pulsado
+  HHOOK hook = SetWindowsHookExA(WH_KEYBOARD_LL, ControlKeyboardProc,
+                                 GetModuleHandle(NULL), 0);
+  if (!hook) {
+    LOG_ERROR("No se pudo instalar el hook de teclado del control continuo");
+    return 1;
+  }
 
+  MSG msg;
+  bool motionPending = false; // El próximo paso repetido empieza la rampa
   while (true) {
-    bool ctrlPressed = (GetAsyncKeyState(VK_CONTROL) & 0x8000) != 0;
-    bool altPressed = (GetAsyncKeyState(VK_MENU) & 0x8000) != 0;
-    bool shiftPressed = (GetAsyncKeyState(VK_SHIFT) & 0x8000) != 0;
-
-    bool keyA = (GetAsyncKeyState('A') & 0x8000) != 0;
-    bool keyW = (GetAsyncKeyState('W') & 0x8000) != 0;
-    bool keyS = (GetAsyncKeyState('S') & 0x8000) != 0;
-    bool keyD = (GetAsyncKeyState('D') & 0x8000) != 0;
-
-    // Si el modo juego está activado, deshabilitar movimientos continuos
-    if (manager->IsGameMode()) {
-      isMoving = false;
-      isResizing = false;
-      Sleep(100);
-      continue;
+    double deadline = controlKeys.NextDeadline();
+    DWORD timeout = INFINITE;
+    if (deadline >= 0) {
+      double wait = deadline - ControlNowMs();
+      timeout = wait > 0 ? (DWORD)(wait + 0.999) : 0;
     }
+    MsgWaitForMultipleObjects(0, NULL, FALSE, timeout, QS_ALLINPUT);
 
-    HWND hwnd = GetForegroundWindow();
-
-    // ===== MODO MOVIMIENTO: Ctrl + WASD =====
-    if (ctrlPressed && !altPressed) {
-      bool localMove = false;
-      int dx = 0, dy = 0;
-
-      if (!shiftPressed) {
-        if (keyA) {
-          dx -= MOVE_STEP;
-          localMove = true;
-        }
-        if (keyD) {
-          dx += MOVE_STEP;
-          localMove = true;
-        }
-        if (keyW) {
-          dy -= MOVE_STEP;
-          localMove = true;
-        }
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+      if (msg.message == WM_QUIT) {
+        UnhookWindowsHookEx(hook);
+        return 0;
       }
+      DispatchMessage(&msg);
+    }
 
-      if (shiftPressed && keyS) {
-        dy += MOVE_STEP;
-        localMove = true;
-      }
+    KeyStateMachine::Step step;
+    if (!controlKeys.Poll(ControlNowMs(), step))
+      continue;
 
-      if (localMove) {
-        if (!wasMoving) {
-          moveStartTime = GetTickCount();
-          wasMoving = true;
-        }
-        DWORD elapsed = GetTickCount() - moveStartTime;
-        if (elapsed > INITIAL_DELAY || elapsed == 0) {
-          if (hwnd && (dx != 0 || dy != 0)) {
-            MoveWindowSmooth(hwnd, dx, dy);
-          }
-        }
+    // Un key-up perdido (p.ej. Ctrl+Alt+Supr) no debe dejar la ventana
+    // moviéndose: comprobar solo las teclas que creemos pulsadas
+    bool stale = false;
+    for (int k = 0; k < KeyStateMachine::K_COUNT; ++k) {
+      if (controlKeys.IsDown(k) &&
+          !(GetAsyncKeyState(KeyStateMachine::VkFromKey(k)) & 0x8000)) {
+        controlKeys.OnKey(k, false, ControlNowMs());
+        stale = true;
       }
-      isMoving = true;
-    } else {
-      wasMoving = false;
-      isMoving = false;
     }
+    if (stale)
+      continue;
 
-    // ===== MODO REDIMENSIONADO: Alt + WASD =====
-    if (altPressed && !ctrlPressed && !shiftPressed &&
-        (keyA || keyW || keyS || keyD)) {
-      if (!wasResizing) {
-        resizeStartTime = GetTickCount();
-        wasResizing = true;
-      }
-      DWORD elapsed = GetTickCount() - resizeStartTime;
-      if (elapsed > INITIAL_DELAY || elapsed == 0) {
-        if (hwnd) {
-          if (keyA)
-            ResizeWindowSmooth(hwnd, -RESIZE_STEP, 0, 1, 0);
-          if (keyD)
-            ResizeWindowSmooth(hwnd, RESIZE_STEP, 0, 1, 0);
-          if (keyW)
-            ResizeWindowSmooth(hwnd, 0, -RESIZE_STEP, 0, 1);
-          if (keyS)
-            ResizeWindowSmooth(hwnd, 0, RESIZE_STEP, 0, 1);
-        }
-      }
-      isResizing = true;
-    } else if (altPressed && shiftPressed && !ctrlPressed &&
-               (keyA || keyW || keyS || keyD)) {
-      // ===== MODO REDIMENSIONADO INVERSO: Alt + Shift + WASD =====
-      if (!wasResizing) {
-        resizeStartTime = GetTickCount();
-        wasResizing = true;
-      }
-      DWORD elapsed = GetTickCount() - resizeStartTime;
-      if (elapsed > INITIAL_DELAY || elapsed == 0) {
-        if (hwnd) {
-          if (keyA)
-            ResizeWindowSmooth(hwnd, -RESIZE_STEP, 0, -1, 0);
-          if (keyD)
-            ResizeWindowSmooth(hwnd, RESIZE_STEP, 0, -1, 0);
-          if (keyW)
-            ResizeWindowSmooth(hwnd, 0, -RESIZE_STEP, 0, -1);
-          if (keyS)
-            ResizeWindowSmooth(hwnd, 0, RESIZE_STEP, 0, -1);
-        }
-      }
-      isResizing = true;
+    // Perfil de la app en primer plano (p.ej. editores sin Ctrl + WASD)
+    const KeymapProfile *profile =
+        controlManager->GetKeymapProfiles().Active();
+    bool allowed = step.mode == KeyStateMachine::M_MOVE
+                       ? profile->continuousMove
+                       : profile->continuousResize;
+    if (!allowed)
+      continue;
+
+    HWND hwnd = GetForegroundWindow();
+    if (!hwnd)
+      continue;
+
+    // Un toque da un paso fijo; mantener la tecla pasa a movimiento continuo
+    // medido en tiempo real, con todas las teclas del frame en un solo
+    // SetWindowPos
+    int dx, dy;
+    if (!step.repeat) {
+      int stepPx = step.mode == KeyStateMachine::M_MOVE ? MOVE_STEP
+                                                        : RESIZE_STEP;
+      dx = step.x * stepPx;
+      dy = step.y * stepPx;
+      motionPending = true;
+      // Un toque o el inicio de una pulsación larga: un paso de deshacer
+      controlManager->SaveCurrentState(hwnd);
     } else {
-      wasResizing = false;
-      isResizing = false;
+      double now = ControlNowMs();
+      if (motionPending) {
+        controlMotion.Begin(now - KeyStateMachine::REPEAT_MS);
+        motionPending = false;
+      }
+      controlMotion.Advance(now, step.x, step.y, dx, dy);
     }
+    if (dx == 0 && dy == 0)
+      continue;
 
-    // OPTIMIZACION: Sleep adaptativo
-    bool hasActivity =
-        (keyA || keyW || keyS || keyD) && (ctrlPressed || altPressed);
-    Sleep(hasActivity ? CONTINUOUS_DELAY : 100);
+    switch (step.mode) {
+    case KeyStateMachine::M_MOVE:
+      MoveWindowSmooth(controlManager, hwnd, dx, dy);
+      break;
+    case KeyStateMachine::M_RESIZE:
+      // Alt + WASD: crecer/encoger desde el borde derecho/inferior
+      ResizeWindowSmooth(controlManager, hwnd, dx, dy, 1, 1);
+      break;
+    case KeyStateMachine::M_RESIZE_INVERSE:
+      // Alt + Shift + WASD: mover el borde izquierdo/superior
+      ResizeWindowSmooth(controlManager, hwnd, dx, dy, -1, -1);
+      break;
+    default:
+      break;
+    }
+    // SetWindowPos directo: el índice espacial no lo vería
+    controlManager->NoteWindowMoved(hwnd);
   }
   return 0;
 }
@@ -270,7 +330,19 @@ void RunWorker() {
   // 4. Inicializar Gestores
   WindowManager manager(exeDir + "\\window_layouts.cfg");
   manager.LoadConfig();
+  manager.SetAnimationEasing(configMgr.GetString("animation_easing", "sine"));
+  manager.SetAnimationSpeed(configMgr.GetInt("animation_speed", 12));
+  manager.SetMoveTimeouts(configMgr.GetInt("move_timeout_ms", 250),
+                          configMgr.GetInt("unresponsive_cooldown_ms", 30000));
+  manager.SetAssignmentExactLimit(configMgr.GetInt("arrange_exact_max", 60));
+  manager.SetSnapThreshold(configMgr.GetInt("snap_threshold", 12));
+  LoadKeymapProfiles(configMgr, manager);
+  controlMotion.Configure(configMgr.GetInt("motion_speed", 900),
+                          configMgr.GetInt("motion_max_speed", 2700),
+                          configMgr.GetInt("motion_ramp_ms", 600));
   HotkeyManager hotkeyMgr;
+  // Cada cambio de perfil desregistra los atajos que desactiva
+  manager.SetProfileHotkeys(&hotkeyMgr);
   DWORD mainThreadId = GetCurrentThreadId();
 
   HANDLE hThread =
@@ -284,10 +356,26 @@ void RunWorker() {
   std::string gameModeHk =
       configMgr.GetString("hotkeys.game_mode", "Ctrl+Alt+J");
 
-  auto checkGameMode = [&](std::function<void()> action) {
-    if (!manager.IsGameMode()) {
-      action();
-    }
+  // Las acciones corren en un pool: el bucle de mensajes solo encola. Las
+  // de una misma ventana van en serie y las globales en exclusiva
+  ActionDispatcher actions;
+  static const char focusLane = 0; // Cambios de foco, en orden entre sí
+
+  // Acción sobre la ventana que estaba en primer plano al pulsar
+  auto onForeground = [&](auto action) {
+    if (manager.IsGameMode())
+      return;
+    HWND h = GetForegroundWindow();
+    if (h)
+      actions.Submit(h, [action, h]() { action(h); });
+  };
+  auto onLane = [&](ActionDispatcher::Lane lane, auto action) {
+    if (!manager.IsGameMode())
+      actions.Submit(lane, action);
+  };
+  auto onExclusive = [&](auto action) {
+    if (!manager.IsGameMode())
+      actions.SubmitExclusive(action);
   };
 
   if (configHk == gameModeHk) {
@@ -301,10 +389,11 @@ void RunWorker() {
         });
   } else {
     hotkeyMgr.RegisterHotkey(HotkeyManager::HK_OPEN_CONFIG, configHk, [&](int) {
-      checkGameMode([&]() {
-        manager.PlaySoundEffect(750, 100);
-        OpenConfigWindow(&manager, GetModuleHandle(NULL), mainThreadId);
-      });
+      if (manager.IsGameMode())
+        return;
+      onLane(ActionDispatcher::FREE,
+             [&]() { manager.PlaySoundEffect(750, 100); });
+      OpenConfigWindow(&manager, GetModuleHandle(NULL), mainThreadId);
     });
     hotkeyMgr.RegisterHotkey(HotkeyManager::HK_GAME_MODE, gameModeHk,
                              [&](int) { manager.ToggleGameMode(); });
@@ -312,107 +401,130 @@ void RunWorker() {
 
   // Navegación
   hotkeyMgr.RegisterHotkey(
-      HotkeyManager::HK_NAV_LEFT, MOD_CONTROL | MOD_ALT, VK_LEFT,
-      [&](int) { checkGameMode([&]() { manager.SwitchWindowFocus(false); }); });
+      HotkeyManager::HK_NAV_LEFT, MOD_CONTROL | MOD_ALT, VK_LEFT, [&](int) {
+        onLane(&focusLane, [&]() { manager.SwitchWindowFocus(false); });
+      });
   hotkeyMgr.RegisterHotkey(
-      HotkeyManager::HK_NAV_RIGHT, MOD_CONTROL | MOD_ALT, VK_RIGHT,
-      [&](int) { checkGameMode([&]() { manager.SwitchWindowFocus(true); }); });
-  hotkeyMgr.RegisterHotkey(HotkeyManager::HK_NAV_UP, MOD_CONTROL | MOD_ALT,
-                           VK_UP, [&](int) {
-                             checkGameMode([&]() {
-                               HWND h = GetForegroundWindow();
-                               if (h)
-                                 manager.BringToFront(h);
-                             });
-                           });
-  hotkeyMgr.RegisterHotkey(HotkeyManager::HK_NAV_DOWN, MOD_CONTROL | MOD_ALT,
-                           VK_DOWN, [&](int) {
-                             checkGameMode([&]() {
-                               HWND h = GetForegroundWindow();
-                               if (h)
-                                 manager.SendToBack(h);
-                             });
-                           });
+      HotkeyManager::HK_NAV_RIGHT, MOD_CONTROL | MOD_ALT, VK_RIGHT, [&](int) {
+        onLane(&focusLane, [&]() { manager.SwitchWindowFocus(true); });
+      });
+  hotkeyMgr.RegisterHotkey(
+      HotkeyManager::HK_NAV_UP, MOD_CONTROL | MOD_ALT, VK_UP, [&](int) {
+        onForeground([&](HWND h) { manager.BringToFront(h); });
+      });
+  hotkeyMgr.RegisterHotkey(
+      HotkeyManager::HK_NAV_DOWN, MOD_CONTROL | MOD_ALT, VK_DOWN, [&](int) {
+        onForeground([&](HWND h) { manager.SendToBack(h); });
+      });
+
+  // Navegación espacial: Shift enfoca y Win intercambia con la ventana más
+  // cercana en esa dirección
+  const struct {
+    UINT vk;
+    SpatialIndex::Direction dir;
+  } spatialKeys[] = {{VK_LEFT, SpatialIndex::DIR_LEFT},
+                     {VK_RIGHT, SpatialIndex::DIR_RIGHT},
+                     {VK_UP, SpatialIndex::DIR_UP},
+                     {VK_DOWN, SpatialIndex::DIR_DOWN}};
+  for (int i = 0; i < 4; ++i) {
+    SpatialIndex::Direction dir = spatialKeys[i].dir;
+    hotkeyMgr.RegisterHotkey(
+        HotkeyManager::HK_FOCUS_LEFT + i, MOD_CONTROL | MOD_ALT | MOD_SHIFT,
+        spatialKeys[i].vk, [&, dir](int) {
+          onLane(&focusLane, [&, dir]() { manager.FocusInDirection(dir); });
+        });
+    hotkeyMgr.RegisterHotkey(
+        HotkeyManager::HK_SWAP_LEFT + i, MOD_CONTROL | MOD_ALT | MOD_WIN,
+        spatialKeys[i].vk, [&, dir](int) {
+          onForeground(
+              [&, dir](HWND h) { manager.SwapInDirection(h, dir); });
+        });
+  }
 
   // Gestión avanzada
-  hotkeyMgr.RegisterHotkey(HotkeyManager::HK_CYCLE_25, MOD_CONTROL | MOD_ALT,
-                           '1', [&](int) {
-                             checkGameMode([&]() {
-                               HWND h = GetForegroundWindow();
-                               if (h)
-                                 manager.CyclePosition25(h);
-                             });
-                           });
-  hotkeyMgr.RegisterHotkey(HotkeyManager::HK_RESTORE_POS, MOD_CONTROL | MOD_ALT,
-                           '2', [&](int) {
-                             checkGameMode([&]() {
-                               HWND h = GetForegroundWindow();
-                               if (h)
-                                 manager.RestorePreviousPosition(h);
-                             });
+  hotkeyMgr.RegisterHotkey(
+      HotkeyManager::HK_CYCLE_25, MOD_CONTROL | MOD_ALT, '1', [&](int) {
+        onForeground([&](HWND h) { manager.CyclePosition25(h); });
+      });
+  hotkeyMgr.RegisterHotkey(
+      HotkeyManager::HK_RESTORE_POS, MOD_CONTROL | MOD_ALT, '2', [&](int) {
+        onForeground([&](HWND h) { manager.RestorePreviousPosition(h); });
+      });
+  hotkeyMgr.RegisterHotkey(HotkeyManager::HK_REDO_POS,
+                           MOD_CONTROL | MOD_ALT | MOD_SHIFT, '2', [&](int) {
+                             onForeground(
+                                 [&](HWND h) { manager.RedoPosition(h); });
                            });
   hotkeyMgr.RegisterHotkey(
       HotkeyManager::HK_ARRANGE_ALL, MOD_CONTROL | MOD_ALT, '3', [&](int) {
-        checkGameMode([&]() { manager.ArrangeAllWindowsNoOverlap(); });
+        onExclusive([&]() { manager.ArrangeAllWindowsNoOverlap(); });
       });
-  hotkeyMgr.RegisterHotkey(HotkeyManager::HK_SAFE_CLOSE,
-                           MOD_CONTROL | MOD_SHIFT, 'D', [&](int) {
-                             checkGameMode([&]() {
-                               HWND h = GetForegroundWindow();
-                               if (h)
-                                 manager.SafeCloseWindow(h);
-                             });
-                           });
-  hotkeyMgr.RegisterHotkey(HotkeyManager::HK_TRANSPARENCY,
-                           MOD_CONTROL | MOD_SHIFT, 'T', [&](int) {
-                             checkGameMode([&]() {
-                               HWND h = GetForegroundWindow();
-                               if (h)
-                                 manager.ToggleTransparency(h);
-                             });
-                           });
+  hotkeyMgr.RegisterHotkey(
+      HotkeyManager::HK_SAFE_CLOSE, MOD_CONTROL | MOD_SHIFT, 'D', [&](int) {
+        onForeground([&](HWND h) { manager.SafeCloseWindow(h); });
+      });
+  hotkeyMgr.RegisterHotkey(
+      HotkeyManager::HK_TRANSPARENCY, MOD_CONTROL | MOD_SHIFT, 'T', [&](int) {
+        onForeground([&](HWND h) { manager.ToggleTransparency(h); });
+      });
+
+  // Dinámicos (Layouts y Apps): al recargar solo se tocan los que cambian
+  auto runLayout = [&](size_t i) {
+    onForeground([&, i](HWND h) {
+      manager.PlaySoundEffect(600, 100);
+      manager.ApplyLayout(h, (int)i);
+    });
+  };
+  auto runApp = [&](size_t i) {
+    // Lanzar una app no depende de ninguna ventana: carril libre
+    onLane(ActionDispatcher::FREE,
+           [&, i]() { manager.ExecuteAppShortcutByIndex((int)i); });
+  };
 
-  // Dinámicos (Layouts y Apps)
   auto registerDynamicHotkeys = [&]() {
-    for (int id = HotkeyManager::HK_LAYOUT_BASE;
-         id < HotkeyManager::HK_APP_BASE; ++id)
-      hotkeyMgr.UnregisterHotkey(id);
-    for (int id = HotkeyManager::HK_APP_BASE;
-         id < HotkeyManager::HK_APP_BASE + 100; ++id)
-      hotkeyMgr.UnregisterHotkey(id);
+    std::vector<HotkeyManager::Binding> bindings;
+    std::vector<HotkeyManager::Sequence> sequences;
+
+    // Secuencias opcionales en config.json, p.ej.
+    // "sequences.layout.3": "Ctrl+Alt+Space, W, 3" (se relee al recargar)
+    configMgr.Load();
 
     const auto &layouts = manager.GetLayouts();
     for (size_t i = 0; i < layouts.size(); ++i) {
+      int id = HotkeyManager::HK_LAYOUT_BASE + (int)i;
       if (layouts[i].hotkey != 0) {
-        hotkeyMgr.RegisterHotkey(HotkeyManager::HK_LAYOUT_BASE + (int)i,
-                                 MOD_CONTROL | MOD_ALT, layouts[i].hotkey,
-                                 [&, i](int) {
-                                   checkGameMode([&]() {
-                                     HWND h = GetForegroundWindow();
-                                     if (h) {
-                                       manager.PlaySoundEffect(600, 100);
-                                       manager.ApplyLayout(h, (int)i);
-                                     }
-                                   });
-                                 });
+        bindings.push_back({id, MOD_CONTROL | MOD_ALT,
+                            (UINT)layouts[i].hotkey,
+                            [&, i](int) { runLayout(i); }});
       }
+      std::string keys =
+          configMgr.GetString("sequences.layout." + std::to_string(i));
+      if (!keys.empty())
+        sequences.push_back({keys, id, [&, i](int) { runLayout(i); }});
     }
 
     const auto &apps = manager.GetAppShortcuts();
     for (size_t i = 0; i < apps.size(); ++i) {
+      int id = HotkeyManager::HK_APP_BASE + (int)i;
       if (apps[i].hotkey != 0) {
-        hotkeyMgr.RegisterHotkey(HotkeyManager::HK_APP_BASE + (int)i,
-                                 apps[i].modifier, apps[i].hotkey, [&, i](int) {
-                                   checkGameMode([&]() {
-                                     manager.ExecuteAppShortcutByIndex((int)i);
-                                   });
-                                 });
+        bindings.push_back({id, (UINT)apps[i].modifier, (UINT)apps[i].hotkey,
+                            [&, i](int) { runApp(i); }});
       }
+      std::string keys =
+          configMgr.GetString("sequences.app." + std::to_string(i));
+      if (!keys.empty())
+        sequences.push_back({keys, id, [&, i](int) { runApp(i); }});
     }
+
+    hotkeyMgr.SyncRange(HotkeyManager::HK_LAYOUT_BASE,
+                        HotkeyManager::HK_APP_BASE + 100, bindings);
+    hotkeyMgr.SetSequenceTimeout(configMgr.GetInt("sequence_timeout_ms", 1500));
+    hotkeyMgr.SetSequences(sequences);
   };
 
   registerDynamicHotkeys();
   manager.RestoreSession();
+  manager.SetAutoTiling(configMgr.GetBool("auto_tiling", false));
 
   const UINT WM_USER_RELOAD_HOTKEYS = WM_USER + 101;
   MSG msg = {0};
@@ -421,12 +533,16 @@ void RunWorker() {
       hotkeyMgr.ProcessHotkey((int)msg.wParam);
     } else if (msg.message == WM_USER_RELOAD_HOTKEYS) {
       registerDynamicHotkeys();
+    } else if (msg.message == WM_TIMER && !msg.hwnd &&
+               hotkeyMgr.ProcessTimer(msg.wParam)) {
+      // Timeout de una secuencia de teclas a medias
     } else {
       TranslateMessage(&msg);
       DispatchMessage(&msg);
     }
   }
 
+  manager.SetProfileHotkeys(nullptr);
   if (hThread) {
     TerminateThread(hThread, 0);
     CloseHandle(hThread);
@@ -0,0 +1,161 @@
+#include "Animator.h"
+#include "FakeDesktop.h"
+#include "TestCheck.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+static bool Near(float a, float b, float tolerance) {
+  return std::fabs(a - b) <= tolerance;
+}
+
+// Reloj virtual: el animador sin hilo avanza con AdvanceFrame
+static void TestFreshAnimation() {
+  FakeDesktop desk;
+  HWND hwnd = desk.AddWindow("w", 1, {0, 0, 100, 100});
+  Animator animator(&desk, false);
+  animator.Configure(120, Animator::EASE_SINE);
+  animator.Animate(hwnd, 1000, 0, 100, 100);
+  CHECK(animator.IsAnimating(hwnd));
+
+  // La velocidad que da Sample es la derivada de la posición
+  float pos[4], vel[4], before[4], after[4], unused[4];
+  CHECK(animator.Sample(hwnd, 50.0, pos, vel));
+  animator.Sample(hwnd, 49.5, before, unused);
+  animator.Sample(hwnd, 50.5, after, unused);
+  CHECK(Near(vel[0], after[0] - before[0], 0.05f));
+  CHECK(pos[0] > 0.0f && pos[0] < 1000.0f);
+
+  for (int t = 10; t <= 120; t += 10)
+    animator.AdvanceFrame(t);
+  CHECK(!animator.IsAnimating(hwnd));
+  RECT r;
+  desk.GetRect(hwnd, r);
+  CHECK(r.left == 1000 && r.top == 0 && r.right == 1100);
+}
+
+// Redirigir a mitad de vuelo: ni salto de posición ni de velocidad, y la
+// curva nueva termina quieta sobre el destino nuevo
+static void TestRetargetContinuity() {
+  for (int e = Animator::EASE_SINE; e <= Animator::EASE_SPRING; ++e) {
+    FakeDesktop desk;
+    HWND hwnd = desk.AddWindow("w", 1, {0, 0, 200, 100});
+    Animator animator(&desk, false);
+    animator.Configure(120, (Animator::Easing)e);
+    animator.Animate(hwnd, 1200, 0, 400, 300);
+    for (int t = 10; t <= 60; t += 10)
+      animator.AdvanceFrame(t);
+
+    float pos[4], vel[4];
+    CHECK(animator.Sample(hwnd, 60.0, pos, vel));
+    animator.Animate(hwnd, 0, 800, 200, 100); // Empieza en t = 60
+    float pos2[4], vel2[4];
+    CHECK(animator.Sample(hwnd, 60.0, pos2, vel2));
+    for (int i = 0; i < 4; ++i) {
+      CHECK(Near(pos[i], pos2[i], 0.01f));
+      CHECK(Near(vel[i], vel2[i], 0.01f));
+    }
+    if (e != Animator::EASE_SPRING) // El muelle ya puede ir de vuelta
+      CHECK(vel2[0] > 1.0f);         // Seguía yendo a la derecha
+
+    // Derivada de la curva redirigida
+    float before[4], after[4], unused[4];
+    animator.Sample(hwnd, 99.5, before, unused);
+    animator.Sample(hwnd, 100.5, after, unused);
+    animator.Sample(hwnd, 100.0, pos2, vel2);
+    for (int i = 0; i < 4; ++i)
+      CHECK(Near(vel2[i], after[i] - before[i], 0.05f));
+
+    // Al final del tramo: en el destino y sin velocidad
+    CHECK(animator.Sample(hwnd, 180.0, pos2, vel2));
+    CHECK(Near(pos2[0], 0, 0.01f) && Near(pos2[1], 800, 0.01f));
+    CHECK(Near(pos2[2], 200, 0.01f) && Near(pos2[3], 100, 0.01f));
+    for (int i = 0; i < 4; ++i)
+      CHECK(Near(vel2[i], 0, 0.001f));
+
+    size_t alive = 1;
+    for (int t = 70; alive && t <= 400; t += 10)
+      alive = animator.AdvanceFrame(t);
+    CHECK_EQ(alive, 0);
+    RECT r;
+    desk.GetRect(hwnd, r);
+    CHECK(r.left == 0 && r.top == 800 && r.right == 200 && r.bottom == 900);
+  }
+}
+
+// Dos redirecciones seguidas encadenan posición y velocidad igual
+static void TestDoubleRetarget() {
+  FakeDesktop desk;
+  HWND hwnd = desk.AddWindow("w", 1, {0, 0, 100, 100});
+  Animator animator(&desk, false);
+  animator.Configure(120, Animator::EASE_CUBIC);
+  animator.Animate(hwnd, 900, 0, 100, 100);
+  animator.AdvanceFrame(30);
+  animator.Animate(hwnd, 900, 900, 100, 100);
+  animator.AdvanceFrame(50);
+  float pos[4], vel[4], pos2[4], vel2[4];
+  animator.Sample(hwnd, 50.0, pos, vel);
+  animator.Animate(hwnd, 0, 0, 100, 100);
+  animator.Sample(hwnd, 50.0, pos2, vel2);
+  for (int i = 0; i < 4; ++i) {
+    CHECK(Near(pos[i], pos2[i], 0.01f));
+    CHECK(Near(vel[i], vel2[i], 0.01f));
+  }
+  CHECK(animator.ActiveCount() == 1);
+  for (int t = 60; t <= 170; t += 10)
+    animator.AdvanceFrame(t);
+  RECT r;
+  desk.GetRect(hwnd, r);
+  CHECK(!animator.IsAnimating(hwnd) && r.left == 0 && r.top == 0);
+}
+
+// TargetOf da el destino vigente, también tras redirigir, y nada al acabar
+static void TestTargetOf() {
+  FakeDesktop desk;
+  HWND hwnd = desk.AddWindow("w", 1, {0, 0, 100, 100});
+  Animator animator(&desk, false);
+  animator.Configure(120, Animator::EASE_SINE);
+  RECT r;
+  CHECK(!animator.TargetOf(hwnd, r));
+  animator.Animate(hwnd, 500, 40, 300, 200);
+  animator.AdvanceFrame(50);
+  CHECK(animator.TargetOf(hwnd, r));
+  CHECK(r.left == 500 && r.top == 40 && r.right == 800 && r.bottom == 240);
+  animator.Animate(hwnd, 10, 20, 30, 40);
+  CHECK(animator.TargetOf(hwnd, r));
+  CHECK(r.left == 10 && r.top == 20 && r.right == 40 && r.bottom == 60);
+  for (int t = 60; t <= 200; t += 10)
+    animator.AdvanceFrame(t);
+  CHECK(!animator.TargetOf(hwnd, r));
+}
+
+// Cancel espera al frame que se está aplicando: lo que el llamador ponga
+// después no lo pisa un frame calculado antes. El primer frame se queda
+// 200 ms en SetPos; el movimiento directo (DragWindow) no pasa por ese
+// retraso, así que sin la espera el frame llegaría después
+static void TestCancelWaitsForFrame() {
+  FakeDesktop desk;
+  HWND hwnd = desk.AddWindow("w", 1, {0, 0, 100, 100});
+  desk.SetPosDelay(hwnd, 200);
+  Animator animator(&desk, true);
+  animator.Configure(120, Animator::EASE_SINE);
+  animator.Animate(hwnd, 1000, 0, 100, 100);
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  animator.Cancel(hwnd);
+  CHECK(!animator.IsAnimating(hwnd));
+  desk.DragWindow(hwnd, {50, 60, 150, 160});
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  RECT r;
+  desk.GetRect(hwnd, r);
+  CHECK(r.left == 50 && r.top == 60 && r.right == 150 && r.bottom == 160);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestFreshAnimation);
+  RUN_TEST(TestRetargetContinuity);
+  RUN_TEST(TestDoubleRetarget);
+  RUN_TEST(TestTargetOf);
+  RUN_TEST(TestCancelWaitsForFrame);
+  return testFailures;
+}
@@ -0,0 +1,145 @@
+#include "AppMatcher.h"
+#include "FakeDesktop.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Implementación directa de la semántica de las reglas, regla por regla
+static bool RefGlob(const char *p, const char *t) {
+  if (*p == 0)
+    return *t == 0;
+  if (*p == '*')
+    return RefGlob(p + 1, t) || (*t && RefGlob(p, t + 1));
+  return *t && (*p == '?' || *p == *t) && RefGlob(p + 1, t + 1);
+}
+
+static bool RefMatches(const std::vector<std::string> &rules,
+                       const std::string &exe, const std::string &cls,
+                       const std::string &title) {
+  for (const std::string &raw : rules) {
+    std::string rule = AppMatcher::ToLower(raw);
+    std::string text = AppMatcher::ToLower(exe);
+    if (rule.compare(0, 6, "class:") == 0) {
+      rule.erase(0, 6);
+      text = AppMatcher::ToLower(cls);
+    } else if (rule.compare(0, 6, "title:") == 0) {
+      rule.erase(0, 6);
+      text = AppMatcher::ToLower(title);
+    }
+    if (rule.empty())
+      continue;
+    bool hit = rule[0] == '='
+                   ? text == rule.substr(1)
+               : rule.find_first_of("*?") != std::string::npos
+                   ? RefGlob(rule.c_str(), text.c_str())
+                   : text.find(rule) != std::string::npos;
+    if (hit)
+      return true;
+  }
+  return false;
+}
+
+// Reglas y nombres aleatorios sobre un alfabeto pequeño (muchas
+// coincidencias parciales) comparados con la referencia
+static void TestAgainstReference() {
+  unsigned seed = 11;
+  auto rnd = [&](int m) {
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 8) % m);
+  };
+  const char alphabet[] = "abAB.e";
+  auto word = [&](int maxLen, bool wild) {
+    std::string w;
+    int len = 1 + rnd(maxLen);
+    for (int i = 0; i < len; ++i) {
+      int r = rnd(wild ? 9 : 6);
+      w += r < 6 ? alphabet[r] : r < 8 ? '*' : '?';
+    }
+    return w;
+  };
+  const char *prefixes[] = {"", "", "", "=", "class:", "title:"};
+
+  int mismatches = 0, hits = 0;
+  for (int set = 0; set < 3000; ++set) {
+    std::vector<std::string> rules;
+    int count = rnd(8);
+    for (int i = 0; i < count; ++i)
+      rules.push_back(std::string(prefixes[rnd(6)]) + word(4, rnd(2) == 0));
+    AppMatcher matcher;
+    matcher.Compile(rules);
+    for (int n = 0; n < 20; ++n) {
+      std::string exe = word(8, false), cls = word(6, false),
+                  title = word(6, false);
+      bool expected = RefMatches(rules, exe, cls, title);
+      bool got = matcher.Matches(AppMatcher::ToLower(exe), &cls, &title);
+      mismatches += expected != got;
+      hits += expected;
+    }
+  }
+  CHECK_EQ(mismatches, 0);
+  CHECK(hits > 1000); // El guion ejercita coincidencias de verdad
+}
+
+static void TestRuleForms() {
+  AppMatcher matcher;
+  matcher.Compile({"=Explorer.exe", "steam*.exe", "note", "class:Chrome_*",
+                   "title:Picture-in-picture"});
+  std::string none;
+  CHECK(matcher.MatchesExe("explorer.exe"));
+  CHECK(!matcher.MatchesExe("myexplorer.exe"));
+  CHECK(matcher.MatchesExe("steamwebhelper.exe"));
+  CHECK(!matcher.MatchesExe("steam.dll"));
+  CHECK(matcher.MatchesExe("notepad.exe"));
+  CHECK(matcher.NeedsClass() && matcher.NeedsTitle());
+  std::string cls = "Chrome_WidgetWin_1", title = "Picture-in-Picture";
+  CHECK(matcher.Matches("x.exe", &cls, &none));
+  CHECK(matcher.Matches("x.exe", &none, &title));
+  CHECK(!matcher.Matches("x.exe", nullptr, nullptr));
+}
+
+// Las entradas "E|" de siempre siguen siendo subcadenas literales con
+// mayúsculas; la sintaxis de reglas solo vale en las "X|"
+static void TestLegacyExclusions() {
+  {
+    std::ofstream cfg("AppMatcherTest.cfg");
+    cfg << "L|Mitad|0|0|0.5|1|0\n"
+        << "E|Note\n"
+        << "E|a*b\n"
+        << "E|=x\n"
+        << "X|=axb.exe\n";
+  }
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  const char *exes[] = {"Notepad.exe", "notes.exe", "a*b.exe",
+                        "azb.exe",     "AXB.exe",   "q=x.exe"};
+  std::vector<HWND> windows;
+  for (DWORD i = 0; i < 6; ++i) {
+    desk.AddProcess(100 + i, exes[i]);
+    windows.push_back(desk.AddWindow(exes[i], 100 + i, {0, 0, 99, 99}));
+  }
+  WindowManager manager("AppMatcherTest.cfg", &desk);
+  CHECK(manager.IsExcluded(windows[0]));  // "Note" en "Notepad.exe"
+  CHECK(!manager.IsExcluded(windows[1])); // Sin mayúscula no coincide
+  CHECK(manager.IsExcluded(windows[2]));  // '*' literal
+  CHECK(!manager.IsExcluded(windows[3])); // ...no es un comodín
+  CHECK(manager.IsExcluded(windows[4]));  // Regla X| exacta y sin caso
+  CHECK(manager.IsExcluded(windows[5]));  // "=x" literal
+
+  // Guardar conserva las dos clases de entradas
+  manager.SaveConfig();
+  std::ifstream in("AppMatcherTest.cfg");
+  std::string text((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+  CHECK(text.find("E|a*b\n") != std::string::npos);
+  CHECK(text.find("X|=axb.exe\n") != std::string::npos);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestAgainstReference);
+  RUN_TEST(TestRuleForms);
+  RUN_TEST(TestLegacyExclusions);
+  return testFailures;
+}
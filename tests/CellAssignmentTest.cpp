@@ -0,0 +1,149 @@
+#include "CellAssignment.h"
+#include "FakeDesktop.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <vector>
+
+typedef CellAssignment CA;
+
+static unsigned seed = 11;
+static int Rnd(int range) {
+  seed = seed * 1103515245 + 12345;
+  return (int)((seed >> 8) % range);
+}
+
+static std::vector<PixelRect> RandomRects(int count) {
+  std::vector<PixelRect> rects;
+  for (int i = 0; i < count; ++i)
+    rects.push_back({Rnd(1800), Rnd(1000), 100 + Rnd(800), 100 + Rnd(600)});
+  return rects;
+}
+
+// Cada ventana en una celda distinta y válida
+static bool IsPermutation(const std::vector<int> &assignment, size_t windows,
+                          size_t cells) {
+  if (assignment.size() != windows)
+    return false;
+  std::vector<char> seen(cells, 0);
+  for (int cell : assignment) {
+    if (cell < 0 || (size_t)cell >= cells || seen[cell])
+      return false;
+    seen[cell] = 1;
+  }
+  return true;
+}
+
+// Mínimo probando todas las formas de elegir y ordenar las celdas
+static long long BruteForce(const std::vector<PixelRect> &windows,
+                            const std::vector<PixelRect> &cells) {
+  std::vector<int> order(cells.size());
+  for (size_t j = 0; j < order.size(); ++j)
+    order[j] = (int)j;
+  long long best = LLONG_MAX;
+  do {
+    best = std::min(best, CA::TotalCost(windows, cells, order));
+  } while (std::next_permutation(order.begin(), order.end()));
+  return best;
+}
+
+static void TestCost() {
+  CHECK_EQ(CA::Cost({0, 0, 100, 100}, {0, 0, 100, 100}), 0);
+  CHECK_EQ(CA::Cost({10, -20, 100, 100}, {0, 0, 130, 90}), 70);
+  CHECK(CA::Solve({}, RandomRects(3)).empty());
+  CHECK(CA::Solve(RandomRects(4), RandomRects(3)).empty());
+}
+
+// Por debajo del límite el reparto es óptimo: igual que la fuerza bruta,
+// también con más celdas que ventanas
+static void TestExactMatchesBruteForce() {
+  bool permutations = true, optimal = true;
+  for (int round = 0; round < 300; ++round) {
+    int n = 1 + round % 7, m = n + Rnd(2);
+    std::vector<PixelRect> windows = RandomRects(n), cells = RandomRects(m);
+    std::vector<int> assignment = CA::Solve(windows, cells, INT_MAX);
+    permutations = permutations && IsPermutation(assignment, n, m);
+    optimal = optimal && CA::TotalCost(windows, cells, assignment) ==
+                             BruteForce(windows, cells);
+  }
+  CHECK(permutations);
+  CHECK(optimal);
+}
+
+// Por encima del límite (aquí 0) el voraz da un reparto válido, nunca
+// mejor que el óptimo
+static void TestGreedyPermutation() {
+  bool permutations = true, bounded = true;
+  for (int round = 0; round < 100; ++round) {
+    int n = 1 + Rnd(120), m = n + Rnd(10);
+    std::vector<PixelRect> windows = RandomRects(n), cells = RandomRects(m);
+    std::vector<int> greedy = CA::Solve(windows, cells, 0);
+    std::vector<int> exact = CA::Solve(windows, cells, INT_MAX);
+    permutations = permutations && IsPermutation(greedy, n, m);
+    bounded = bounded && CA::TotalCost(windows, cells, greedy) >=
+                             CA::TotalCost(windows, cells, exact);
+  }
+  CHECK(permutations);
+  CHECK(bounded);
+}
+
+// Ventanas casi en su celda y en otro orden: los dos caminos las dejan
+// donde estaban
+static void TestNearArrangementStays() {
+  std::vector<PixelRect> cells;
+  for (int i = 0; i < 50; ++i)
+    cells.push_back({(i % 10) * 190, (i / 10) * 200, 180, 190});
+  std::vector<int> order(cells.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = (int)((i * 7) % cells.size());
+  std::vector<PixelRect> windows;
+  for (int j : order) {
+    PixelRect r = cells[j];
+    windows.push_back({r.x + Rnd(9) - 4, r.y + Rnd(9) - 4, r.w + Rnd(5),
+                       r.h - Rnd(5)});
+  }
+  CHECK(CA::Solve(windows, cells, INT_MAX) == order);
+  CHECK(CA::Solve(windows, cells, 0) == order);
+}
+
+// Ordenar dos veces seguidas no mueve nada la segunda vez, con los dos
+// caminos del WindowManager
+static void TestArrangeTwiceIsStable() {
+  for (int limit : {CA::DEFAULT_EXACT_LIMIT, 0}) {
+    FakeDesktop desk;
+    desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+    desk.AddProcess(100, "app.exe");
+    std::vector<HWND> windows;
+    for (int i = 0; i < 12; ++i) {
+      int x = Rnd(1400), y = Rnd(700);
+      windows.push_back(desk.AddWindow("w" + std::to_string(i), 100,
+                                       {x, y, x + 400, y + 300}));
+    }
+    WindowManager manager("CellAssignmentTest.cfg", &desk);
+    manager.SetSoundsEnabled(false);
+    manager.SetAnimationsEnabled(false);
+    manager.SetAssignmentExactLimit(limit);
+    desk.SetForeground(windows[0]);
+
+    manager.ArrangeAllWindowsNoOverlap();
+    desk.ResetCounters();
+    manager.ArrangeAllWindowsNoOverlap();
+    CHECK_EQ(desk.Counters().setPos + desk.Counters().setPosBatch, 0);
+    manager.TileAllWindows();
+    desk.ResetCounters();
+    manager.TileAllWindows();
+    CHECK_EQ(desk.Counters().setPos + desk.Counters().setPosBatch, 0);
+  }
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestCost);
+  RUN_TEST(TestExactMatchesBruteForce);
+  RUN_TEST(TestGreedyPermutation);
+  RUN_TEST(TestNearArrangementStays);
+  RUN_TEST(TestArrangeTwiceIsStable);
+  return testFailures;
+}
@@ -0,0 +1,167 @@
+#include "EdgeSnapper.h"
+#include "FakeDesktop.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+
+static bool Same(const PixelRect &r, int x, int y, int w, int h) {
+  return r.x == x && r.y == y && r.w == w && r.h == h;
+}
+
+// Un paso de 15 px a la derecha que deja el borde derecho a 'gap' píxeles
+// del borde izquierdo de otra ventana en x = 600
+static bool StepRight(const EdgeSnapper &snapper, int gap, int threshold,
+                      PixelRect &to) {
+  PixelRect from = {600 - gap - 15 - 400, 100, 400, 300};
+  to = {from.x + 15, from.y, from.w, from.h};
+  return snapper.Snap(from, to, threshold);
+}
+
+// Pega a menos de 'threshold' píxeles, incluido el propio umbral, y nada
+// más allá o con el umbral apagado
+static void TestThreshold() {
+  EdgeSnapper snapper;
+  snapper.AddWindow({600, 100, 400, 300});
+  snapper.Finish();
+  CHECK_EQ(snapper.EdgeCount(), 4);
+
+  PixelRect to;
+  CHECK(StepRight(snapper, 5, 12, to) && Same(to, 200, 100, 400, 300));
+  CHECK(StepRight(snapper, 12, 12, to) && Same(to, 200, 100, 400, 300));
+  CHECK(!StepRight(snapper, 13, 12, to) && Same(to, 187, 100, 400, 300));
+  CHECK(!StepRight(snapper, 5, 4, to));
+  CHECK(!StepRight(snapper, 5, 0, to));
+  // Recién pasado el borde también pega (vuelve atrás hasta él)
+  CHECK(StepRight(snapper, -3, 12, to) && Same(to, 200, 100, 400, 300));
+}
+
+// Solo atrae lo que está por delante del paso y comparte tramo con la
+// ventana
+static void TestDirectionAndSpan() {
+  EdgeSnapper snapper;
+  snapper.AddWindow({600, 100, 400, 300});
+  snapper.AddWindow({100, 800, 300, 200}); // Debajo, sin tramo común
+  snapper.Finish();
+
+  // Alejándose del borde: no vuelve a pegarse
+  PixelRect from = {200, 100, 400, 300}, to = {185, 100, 400, 300};
+  CHECK(!snapper.Snap(from, to, 12));
+  CHECK(Same(to, 185, 100, 400, 300));
+
+  // El borde x = 400 de la de abajo no toca el tramo y = 100..400
+  from = {-20, 100, 410, 300};
+  to = {-15, 100, 410, 300};
+  CHECK(!snapper.Snap(from, to, 12));
+  // Pero sí a una ventana a la misma altura
+  from = {-20, 700, 410, 300};
+  to = {-15, 700, 410, 300};
+  CHECK(snapper.Snap(from, to, 12) && Same(to, -10, 700, 410, 300));
+}
+
+// Redimensionar solo estira el borde que se mueve
+static void TestResizeEdge() {
+  EdgeSnapper snapper;
+  snapper.AddWindow({600, 100, 400, 300});
+  snapper.Finish();
+  PixelRect from = {200, 100, 380, 300}, to = {200, 100, 393, 300};
+  CHECK(snapper.Snap(from, to, 12) && Same(to, 200, 100, 400, 300));
+  // Borde izquierdo hacia la izquierda, lejos de todo: nada
+  from = {200, 100, 380, 300};
+  to = {185, 100, 395, 300};
+  CHECK(!snapper.Snap(from, to, 12));
+}
+
+// Guías del monitor: bordes del área de trabajo y sus mitades
+static void TestMonitorGrid() {
+  EdgeSnapper snapper;
+  snapper.AddGuides({0, 0, 1920, 1040});
+  snapper.AddGuides({1920, 0, 1920, 1040});
+  snapper.Finish();
+  CHECK_EQ(snapper.EdgeCount(), 12);
+
+  PixelRect from = {548, 100, 400, 300}, to = {555, 100, 400, 300};
+  CHECK(snapper.Snap(from, to, 12) && Same(to, 560, 100, 400, 300));
+  from = {100, 620, 400, 400};
+  to = {100, 630, 400, 400};
+  CHECK(snapper.Snap(from, to, 12) && Same(to, 100, 640, 400, 400));
+  from = {100, 200, 400, 300};
+  to = {100, 212, 400, 300}; // Borde inferior hacia la mitad (520)
+  CHECK(snapper.Snap(from, to, 12) && Same(to, 100, 220, 400, 300));
+  // La mitad del segundo monitor
+  from = {2860, 100, 400, 300};
+  to = {2875, 100, 400, 300};
+  CHECK(snapper.Snap(from, to, 12) && Same(to, 2880, 100, 400, 300));
+  // Izquierda contra el borde común de los dos monitores
+  from = {1940, 100, 400, 300};
+  to = {1925, 100, 400, 300};
+  CHECK(snapper.Snap(from, to, 12) && Same(to, 1920, 100, 400, 300));
+}
+
+// El WindowManager rehace los bordes solo cuando se mueve otra ventana o
+// cambia la que se está moviendo; los pasos de la propia ventana no
+static void TestRebuiltOnlyWhenOthersMove() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  HWND a = desk.AddWindow("a", 100, {180, 100, 580, 400});
+  HWND b = desk.AddWindow("b", 100, {600, 100, 1000, 400});
+  desk.AddWindow("c", 100, {100, 600, 500, 900});
+  WindowManager manager("EdgeSnapperTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+
+  PixelRect from = {180, 100, 400, 300}, to = {195, 100, 400, 300};
+  CHECK(manager.SnapStep(a, from, to) && Same(to, 200, 100, 400, 300));
+  CHECK_EQ(manager.SnapRebuildCount(), 1);
+  for (int i = 0; i < 10; ++i) {
+    to = {195, 100, 400, 300};
+    manager.SnapStep(a, from, to);
+  }
+  CHECK_EQ(manager.SnapRebuildCount(), 1);
+
+  // La propia ventana se mueve: por el control continuo y arrastrándola
+  desk.SetPos(a, 200, 100, 400, 300, 0);
+  manager.NoteWindowMoved(a);
+  desk.DragWindow(a, {180, 100, 580, 400});
+  to = {195, 100, 400, 300};
+  CHECK(manager.SnapStep(a, from, to) && Same(to, 200, 100, 400, 300));
+  CHECK_EQ(manager.SnapRebuildCount(), 1);
+
+  // Se mueve otra: se rehace y el borde viejo deja de atraer
+  desk.DragWindow(b, {700, 100, 1100, 400});
+  to = {195, 100, 400, 300};
+  CHECK(!manager.SnapStep(a, from, to));
+  CHECK_EQ(manager.SnapRebuildCount(), 2);
+  to = {195, 100, 400, 300};
+  manager.SnapStep(a, from, to);
+  CHECK_EQ(manager.SnapRebuildCount(), 2);
+
+  // Otra ventana bajo el teclado: sus propios bordes no cuentan
+  PixelRect bFrom = {700, 100, 400, 300}, bTo = {685, 100, 400, 300};
+  manager.SnapStep(b, bFrom, bTo);
+  CHECK_EQ(manager.SnapRebuildCount(), 3);
+  manager.SnapStep(b, bFrom, bTo);
+  CHECK_EQ(manager.SnapRebuildCount(), 3);
+
+  // Umbral: la mitad del monitor (960) a 5 px
+  from = {548, 500, 400, 300};
+  to = {555, 500, 400, 300};
+  CHECK(manager.SnapStep(a, from, to) && Same(to, 560, 500, 400, 300));
+  CHECK_EQ(manager.SnapRebuildCount(), 4);
+  manager.SetSnapThreshold(4);
+  to = {555, 500, 400, 300};
+  CHECK(!manager.SnapStep(a, from, to));
+  manager.SetSnapThreshold(0);
+  to = {555, 500, 400, 300};
+  CHECK(!manager.SnapStep(a, from, to));
+  CHECK_EQ(manager.SnapRebuildCount(), 4);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestThreshold);
+  RUN_TEST(TestDirectionAndSpan);
+  RUN_TEST(TestResizeEdge);
+  RUN_TEST(TestMonitorGrid);
+  RUN_TEST(TestRebuiltOnlyWhenOthersMove);
+  return testFailures;
+}
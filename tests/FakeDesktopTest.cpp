@@ -0,0 +1,79 @@
+#include "FakeDesktop.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <vector>
+
+// El escritorio simulado se comporta como el real en lo que usa el gestor
+static void TestScenario() {
+  FakeDesktop desk;
+  HMONITOR m1 = desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  HMONITOR m2 = desk.AddMonitor({1920, 0, 3840, 1080}, {1920, 0, 3840, 1040});
+  desk.AddProcess(100, "code.exe");
+  desk.AddProcess(200, "chrome.exe");
+  HWND a = desk.AddWindow("a", 100, {10, 10, 500, 400});
+  HWND b = desk.AddWindow("b", 200, {2000, 10, 2500, 400});
+  HWND c = desk.AddWindow("c", 200, {100, 100, 300, 300});
+
+  std::vector<HWND> all;
+  desk.ListTopLevelWindows(all);
+  CHECK(all.size() == 3 && all[0] == c && all[2] == a); // De arriba a abajo
+  desk.SetForeground(a);
+  desk.ListTopLevelWindows(all);
+  CHECK(all[0] == a && desk.GetForeground() == a);
+
+  MonitorDesc mon;
+  CHECK(desk.GetMonitorForWindow(b, mon) && mon.handle == m2);
+  CHECK(desk.GetMonitorForPoint({-500, 50}, mon) && mon.handle == m1);
+  CHECK(mon.primary && mon.rcWork.bottom == 1040);
+
+  // Cerrar el proceso cierra sus ventanas
+  CHECK(desk.TerminatePid(200));
+  CHECK_EQ(desk.WindowCount(), 1);
+  CHECK(!desk.IsAlive(b) && !desk.IsAlive(c));
+}
+
+// Mosaico sobre el escritorio simulado: cada ventana en su celda, dentro
+// del área de trabajo y sin solaparse
+static void TestTileAll() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  std::vector<HWND> windows;
+  for (int i = 0; i < 7; ++i)
+    windows.push_back(
+        desk.AddWindow("w" + std::to_string(i), 100, {i * 20, i * 20,
+                                                      i * 20 + 400,
+                                                      i * 20 + 300}));
+  WindowManager manager("FakeDesktopTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  desk.SetForeground(windows[0]);
+  manager.TileAllWindows();
+
+  std::vector<RECT> rects;
+  for (HWND hwnd : windows) {
+    RECT r;
+    CHECK(desk.GetRect(hwnd, r));
+    CHECK(r.left >= 0 && r.top >= 0 && r.right <= 1920 && r.bottom <= 1040);
+    rects.push_back(r);
+  }
+  for (size_t i = 0; i < rects.size(); ++i)
+    for (size_t j = i + 1; j < rects.size(); ++j)
+      CHECK(rects[i].right <= rects[j].left ||
+            rects[j].right <= rects[i].left ||
+            rects[i].bottom <= rects[j].top ||
+            rects[j].bottom <= rects[i].top);
+
+  // La primera de las 25 posiciones es la mitad izquierda
+  manager.CyclePosition25(windows[3]);
+  RECT r;
+  desk.GetRect(windows[3], r);
+  CHECK(r.left < 20 && r.right > 900 && r.right < 960);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestScenario);
+  RUN_TEST(TestTileAll);
+  return testFailures;
+}
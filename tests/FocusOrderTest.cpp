@@ -0,0 +1,125 @@
+#include "FakeDesktop.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// Tres apps con una ventana cada una, enfocadas en orden a, b, c
+struct Scene {
+  FakeDesktop desk;
+  HWND a, b, c;
+
+  Scene() {
+    desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+    desk.AddProcess(1, "a.exe");
+    desk.AddProcess(2, "b.exe");
+    desk.AddProcess(3, "c.exe");
+    a = desk.AddWindow("a", 1, {0, 0, 400, 300});
+    b = desk.AddWindow("b", 2, {100, 0, 500, 300});
+    c = desk.AddWindow("c", 3, {200, 0, 600, 300});
+  }
+
+  void FocusInOrder() {
+    desk.SetForeground(a);
+    desk.SetForeground(b);
+    desk.SetForeground(c);
+  }
+};
+
+// Cada test empieza sin la lista de exclusión que guardó el anterior
+static const char *CONFIG = "FocusOrderTest.cfg";
+
+static void Quiet(WindowManager &manager) {
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+}
+
+// Cambiar la lista de exclusión invalida el registro; el cambio de foco
+// siguiente no debe vaciar el orden de uso reciente
+static void TestSwitchAfterInvalidate() {
+  Scene scene;
+  std::remove(CONFIG);
+  WindowManager manager(CONFIG, &scene.desk);
+  Quiet(manager);
+  scene.FocusInOrder();
+  manager.SwitchWindowFocus(true);
+  CHECK(scene.desk.GetForeground() == scene.b);
+
+  manager.AddToExclusionList("ninguna.exe");
+  manager.SwitchWindowFocus(true);
+  CHECK(scene.desk.GetForeground() == scene.c);
+  manager.SwitchWindowFocus(true);
+  CHECK(scene.desk.GetForeground() == scene.b);
+  manager.SwitchWindowFocus(false); // La que lleva más sin usarse
+  CHECK(scene.desk.GetForeground() == scene.a);
+}
+
+// Los eventos de foco que llegan tras invalidar siguen contando, y la app
+// recién excluida sale del ciclo
+static void TestEventsAfterInvalidate() {
+  Scene scene;
+  std::remove(CONFIG);
+  WindowManager manager(CONFIG, &scene.desk);
+  Quiet(manager);
+  scene.FocusInOrder();
+  manager.SwitchWindowFocus(true);
+  CHECK(scene.desk.GetForeground() == scene.b);
+
+  manager.AddToExclusionList("b.exe");
+  scene.desk.SetForeground(scene.a);
+  manager.SwitchWindowFocus(true);
+  CHECK(scene.desk.GetForeground() == scene.c);
+  manager.SwitchWindowFocus(true);
+  CHECK(scene.desk.GetForeground() == scene.a);
+  manager.SwitchWindowFocus(false);
+  CHECK(scene.desk.GetForeground() == scene.c);
+}
+
+// Quita las exclusiones "E|" del config y lo vuelve a cargar
+static void DropExclusions(WindowManager &manager) {
+  std::ifstream in(CONFIG);
+  std::string line, kept;
+  while (std::getline(in, line)) {
+    if (line.compare(0, 2, "E|") != 0)
+      kept += line + "\n";
+  }
+  in.close();
+  std::ofstream(CONFIG) << kept;
+  manager.LoadConfig();
+}
+
+// Al cambiar las exclusiones el índice espacial se vuelve a llenar: una
+// ventana que deja de estar excluida es alcanzable aunque no haya emitido
+// ningún evento
+static void TestDirectionAfterInvalidate() {
+  Scene scene;
+  // En fila y sin solaparse: a, b, c de izquierda a derecha
+  scene.desk.SetPos(scene.a, 0, 0, 400, 300, 0);
+  scene.desk.SetPos(scene.b, 600, 0, 400, 300, 0);
+  scene.desk.SetPos(scene.c, 1200, 0, 400, 300, 0);
+  std::remove(CONFIG);
+  WindowManager manager(CONFIG, &scene.desk);
+  Quiet(manager);
+  manager.AddToExclusionList("c.exe");
+  scene.desk.SetForeground(scene.a);
+  manager.FocusInDirection(SpatialIndex::DIR_RIGHT);
+  CHECK(scene.desk.GetForeground() == scene.b);
+  manager.FocusInDirection(SpatialIndex::DIR_RIGHT);
+  CHECK(scene.desk.GetForeground() == scene.b); // c excluida
+
+  DropExclusions(manager);
+  manager.FocusInDirection(SpatialIndex::DIR_RIGHT);
+  CHECK(scene.desk.GetForeground() == scene.c);
+  manager.FocusInDirection(SpatialIndex::DIR_LEFT);
+  manager.FocusInDirection(SpatialIndex::DIR_LEFT);
+  CHECK(scene.desk.GetForeground() == scene.a);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestSwitchAfterInvalidate);
+  RUN_TEST(TestEventsAfterInvalidate);
+  RUN_TEST(TestDirectionAfterInvalidate);
+  return testFailures;
+}
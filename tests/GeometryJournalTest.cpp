@@ -0,0 +1,242 @@
+#include "FakeDesktop.h"
+#include "GeometryJournal.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+static HWND W(uintptr_t id) { return (HWND)id; }
+
+static PixelRect R(int x) { return {x, 0, 100, 100}; }
+
+static bool Same(const RECT &r, int x, int y, int w, int h) {
+  return r.left == x && r.top == y && r.right - r.left == w &&
+         r.bottom - r.top == h;
+}
+
+static RECT RectOf(FakeDesktop &desk, HWND hwnd) {
+  RECT r = {0, 0, 0, 0};
+  desk.GetRect(hwnd, r);
+  return r;
+}
+
+// Una transacción de 'count' ventanas con la etiqueta 'tag'
+static std::vector<GeometryJournal::Entry> Entries(size_t count,
+                                                   uint64_t tag) {
+  std::vector<GeometryJournal::Entry> entries;
+  for (size_t i = 0; i < count; ++i)
+    entries.push_back({W(i + 1), tag, R((int)i)});
+  return entries;
+}
+
+// Como mucho CAPACITY por pila; se pierde la más vieja y cada paso
+// conserva la secuencia de su acción
+static void TestHistoryCapacity() {
+  GeometryHistory history;
+  for (int i = 0; i < 20; ++i)
+    CHECK(history.Push(R(i), i + 1));
+  CHECK_EQ(history.UndoSize(), GeometryHistory::CAPACITY);
+
+  GeometryHistory::Entry entry;
+  bool ordered = true;
+  for (int i = 19; i >= 4; --i) {
+    ordered = ordered && history.Undo(R(1000 + i), entry) &&
+              entry.rect.x == i && entry.seq == (uint64_t)i + 1;
+  }
+  CHECK(ordered);
+  CHECK(!history.Undo(R(0), entry));
+  CHECK_EQ(history.RedoSize(), GeometryHistory::CAPACITY);
+
+  // Rehacer devuelve los rectángulos que había al deshacer
+  CHECK(history.Redo(R(0), entry));
+  CHECK_EQ(entry.rect.x, 1004);
+  CHECK_EQ(entry.seq, 5);
+  CHECK_EQ(history.PeekUndo()->seq, 5);
+}
+
+static void TestHistoryPush() {
+  GeometryHistory history;
+  CHECK(history.Push(R(1), 1));
+  CHECK(!history.Push(R(1), 2)); // Igual que el último
+  CHECK_EQ(history.UndoSize(), 1);
+  CHECK_EQ(history.PeekUndo()->seq, 1);
+
+  GeometryHistory::Entry entry;
+  CHECK(history.Undo(R(2), entry));
+  CHECK_EQ(history.PeekRedo()->seq, 1);
+  // Una acción nueva vacía rehacer aunque no se anote
+  CHECK(history.Push(R(2), 3));
+  CHECK(history.Push(R(3), 4));
+  CHECK(history.Undo(R(9), entry));
+  CHECK_EQ(history.RedoSize(), 1);
+  CHECK(!history.Push(R(2), 5));
+  CHECK_EQ(history.RedoSize(), 0);
+  CHECK_EQ(history.PeekUndo()->seq, 3);
+}
+
+// Límite de transacciones: se descartan las más viejas y deshacer las
+// saca de la más nueva a la más vieja
+static void TestJournalTransactionLimit() {
+  GeometryJournal journal(4, 100);
+  for (int i = 0; i < 6; ++i) {
+    uint64_t seq = journal.NextSeq();
+    CHECK(journal.Record(seq, Entries(1, seq)));
+  }
+  CHECK_EQ(journal.UndoSize(), 4);
+  CHECK_EQ(journal.EntryCount(), 4);
+
+  std::vector<uint64_t> order;
+  while (const GeometryJournal::Transaction *t = journal.PeekUndo()) {
+    order.push_back(t->seq);
+    CHECK(journal.Undo(t->seq, Entries(1, t->seq)));
+  }
+  CHECK(order == std::vector<uint64_t>({6, 5, 4, 3}));
+  CHECK_EQ(journal.RedoSize(), 4);
+  CHECK_EQ(journal.PeekRedo()->seq, 3);
+}
+
+// Límite de entradas entre las dos pilas
+static void TestJournalEntryLimit() {
+  GeometryJournal journal(32, 10);
+  for (uint64_t seq = 1; seq <= 3; ++seq)
+    CHECK(journal.Record(seq, Entries(4, seq)));
+  CHECK_EQ(journal.UndoSize(), 2);
+  CHECK_EQ(journal.EntryCount(), 8);
+  CHECK_EQ(journal.PeekUndo()->seq, 3);
+
+  // Más grande que el límite: no se anota, pero rehacer se vacía igual
+  CHECK(journal.Undo(3, Entries(4, 3)));
+  CHECK(!journal.Record(4, Entries(11, 4)));
+  CHECK(!journal.Record(5, {}));
+  CHECK_EQ(journal.RedoSize(), 0);
+  CHECK_EQ(journal.UndoSize(), 1);
+  CHECK_EQ(journal.EntryCount(), 4);
+}
+
+// Deshacer y rehacer solo mueven la cima; 'current' pasa a la otra pila
+static void TestJournalSeqOrder() {
+  GeometryJournal journal;
+  uint64_t first = journal.NextSeq(), second = journal.NextSeq();
+  CHECK(second > first);
+  journal.Record(first, Entries(2, 7));
+  journal.Record(second, Entries(3, 8));
+  CHECK(journal.PeekUndo()->Touches(W(3)));
+  CHECK(!journal.PeekUndo()->Touches(W(4)));
+
+  CHECK(!journal.Undo(first, {})); // No es la cima
+  std::vector<GeometryJournal::Entry> current = Entries(3, 8);
+  current[0].rect.x = 500;
+  CHECK(journal.Undo(second, current));
+  CHECK(!journal.Undo(second, {})); // Otro llegó antes
+  CHECK_EQ(journal.PeekUndo()->seq, first);
+  CHECK_EQ(journal.PeekRedo()->entries[0].rect.x, 500);
+
+  CHECK(!journal.Redo(first, {}));
+  CHECK(journal.Redo(second, Entries(3, 8)));
+  CHECK_EQ(journal.PeekUndo()->seq, second);
+  CHECK_EQ(journal.EntryCount(), 5);
+
+  CHECK(journal.Undo(second, Entries(3, 8)));
+  journal.ClearRedo();
+  CHECK(journal.PeekRedo() == nullptr);
+  CHECK_EQ(journal.EntryCount(), 2);
+}
+
+// Deshacer una transacción salta la ventana cerrada cuyo HWND ya es de
+// otra ventana
+static void TestReusedHandleSkipped() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  HWND a = desk.AddWindow("a", 100, {100, 100, 400, 400});
+  HWND b = desk.AddWindow("b", 100, {1500, 100, 1800, 400});
+  WindowManager manager("GeometryJournalTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+
+  manager.TileAllWindows();
+  CHECK(!Same(RectOf(desk, a), 100, 100, 300, 300));
+
+  desk.RemoveWindow(b);
+  desk.ReuseHandle(b);
+  HWND c = desk.AddWindow("c", 100, {800, 500, 1000, 700});
+  CHECK(c == b);
+  manager.SaveCurrentState(c);
+
+  manager.RestorePreviousPosition(a);
+  CHECK(Same(RectOf(desk, a), 100, 100, 300, 300));
+  CHECK(Same(RectOf(desk, c), 800, 500, 200, 200));
+}
+
+// Espera a que el animador haya aplicado algún frame
+static bool WaitMoving(FakeDesktop &desk, HWND hwnd, const RECT &from) {
+  for (int i = 0; i < 400; ++i) {
+    RECT r = RectOf(desk, hwnd);
+    if (r.left != from.left || r.right != from.right)
+      return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return false;
+}
+
+// Con la ventana a medio animar, el historial y el diario guardan el
+// destino en vuelo, no el frame intermedio
+static void TestInFlightTargetRecorded() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  HWND a = desk.AddWindow("a", 100, {100, 100, 400, 400});
+  WindowManager manager("GeometryJournalTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationSpeed(100); // 1 s
+
+  manager.TileAllWindows(); // Hacia (6, 6, 1908, 1028)
+  CHECK(WaitMoving(desk, a, {100, 100, 400, 400}));
+  desk.AddWindow("b", 100, {1500, 100, 1800, 400});
+  manager.TileAllWindows(); // Mitad izquierda, sin haber llegado
+  manager.SaveCurrentState(a);
+  manager.SetAnimationsEnabled(false);
+
+  manager.RestorePreviousPosition(a); // Historial propio
+  RECT r = RectOf(desk, a);
+  CHECK(r.top == 6 && r.right - r.left == 948 && r.bottom - r.top == 1028);
+  manager.RestorePreviousPosition(a); // Segunda transacción
+  CHECK(Same(RectOf(desk, a), 6, 6, 1908, 1028));
+  manager.RestorePreviousPosition(a); // Primera
+  CHECK(Same(RectOf(desk, a), 100, 100, 300, 300));
+}
+
+// Una ventana maximizada se deshace maximizada: el diario lee su
+// rectángulo antes de que CommitGeometry la restaure
+static void TestMaximizedUndoesToMaximized() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  HWND a = desk.AddWindow("a", 100, {100, 100, 400, 400});
+  desk.AddWindow("b", 100, {1500, 100, 1800, 400});
+  desk.MaximizeWindow(a);
+  CHECK(Same(RectOf(desk, a), 0, 0, 1920, 1040));
+  WindowManager manager("GeometryJournalTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+
+  manager.TileAllWindows();
+  CHECK(!Same(RectOf(desk, a), 0, 0, 1920, 1040));
+  manager.RestorePreviousPosition(a);
+  CHECK(Same(RectOf(desk, a), 0, 0, 1920, 1040));
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestHistoryCapacity);
+  RUN_TEST(TestHistoryPush);
+  RUN_TEST(TestJournalTransactionLimit);
+  RUN_TEST(TestJournalEntryLimit);
+  RUN_TEST(TestJournalSeqOrder);
+  RUN_TEST(TestReusedHandleSkipped);
+  RUN_TEST(TestInFlightTargetRecorded);
+  RUN_TEST(TestMaximizedUndoesToMaximized);
+  return testFailures;
+}
@@ -0,0 +1,317 @@
+#include "FakeDesktop.h"
+#include "HotkeyManager.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// 10 layouts (Ctrl+Alt+A..J) y 20 apps (Ctrl+Shift+A..T), como los arma
+// gestor_ven al recargar; editVk cambia la tecla del layout 3 y dropApp
+// quita esa app (-1 ninguna)
+static std::vector<HotkeyManager::Binding> Bindings(UINT editVk, int dropApp,
+                                                    int *fired) {
+  std::vector<HotkeyManager::Binding> out;
+  for (int i = 0; i < 10; ++i)
+    out.push_back({HotkeyManager::HK_LAYOUT_BASE + i, MOD_CONTROL | MOD_ALT,
+                   i == 3 ? editVk : (UINT)('A' + i),
+                   [fired, i](int) { *fired = i; }});
+  for (int i = 0; i < 20; ++i) {
+    if (i != dropApp)
+      out.push_back({HotkeyManager::HK_APP_BASE + i,
+                     MOD_CONTROL | MOD_SHIFT, (UINT)('A' + i),
+                     [fired, i](int) { *fired = 100 + i; }});
+  }
+  return out;
+}
+
+// Recargar solo cuesta las llamadas al sistema de lo que cambió
+static void TestSyncRangeCallCounts() {
+  FakeDesktop desk;
+  HotkeyManager hotkeys(&desk);
+  int fired = -1;
+  const int first = HotkeyManager::HK_LAYOUT_BASE;
+  const int last = HotkeyManager::HK_APP_BASE + 100;
+
+  hotkeys.SyncRange(first, last, Bindings('D', -1, &fired));
+  CHECK_EQ(desk.Counters().hotkeyRegister, 30);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 0);
+
+  // Sin cambios: ninguna llamada
+  desk.ResetCounters();
+  hotkeys.SyncRange(first, last, Bindings('D', -1, &fired));
+  CHECK_EQ(desk.Counters().hotkeyRegister, 0);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 0);
+
+  // Editar la tecla de un layout: un unregister y un register
+  desk.ResetCounters();
+  hotkeys.SyncRange(first, last, Bindings('Z', -1, &fired));
+  CHECK_EQ(desk.Counters().hotkeyRegister, 1);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 1);
+  CHECK(hotkeys.GetHotkeyString(first + 3) == "Ctrl+Alt+Z");
+  hotkeys.ProcessHotkey(first + 3);
+  CHECK_EQ(fired, 3);
+
+  // Quitar una app: solo su unregister
+  desk.ResetCounters();
+  hotkeys.SyncRange(first, last, Bindings('Z', 5, &fired));
+  CHECK_EQ(desk.Counters().hotkeyRegister, 0);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 1);
+  CHECK(!hotkeys.IsRegistered(HotkeyManager::HK_APP_BASE + 5));
+  CHECK(hotkeys.IsRegistered(HotkeyManager::HK_APP_BASE + 6));
+}
+
+// Dos layouts que se intercambian la tecla no chocan entre sí, y un
+// callback nuevo sobre la misma combinación no toca el sistema
+static void TestSyncRangeSwapAndCallback() {
+  FakeDesktop desk;
+  HotkeyManager hotkeys(&desk);
+  int fired = -1;
+  const int first = HotkeyManager::HK_LAYOUT_BASE;
+  const int last = HotkeyManager::HK_APP_BASE + 100;
+  hotkeys.SyncRange(first, last, Bindings('D', -1, &fired));
+
+  std::vector<HotkeyManager::Binding> swapped = Bindings('D', -1, &fired);
+  std::swap(swapped[4].vk, swapped[5].vk);
+  hotkeys.SyncRange(first, last, swapped);
+  CHECK(hotkeys.GetHotkeyString(first + 4) == "Ctrl+Alt+F");
+  CHECK(hotkeys.GetHotkeyString(first + 5) == "Ctrl+Alt+E");
+
+  desk.ResetCounters();
+  swapped[0].callback = [&fired](int) { fired = 42; };
+  hotkeys.SyncRange(first, last, swapped);
+  CHECK_EQ(desk.Counters().hotkeyRegister + desk.Counters().hotkeyUnregister,
+           0);
+  hotkeys.ProcessHotkey(first);
+  CHECK_EQ(fired, 42);
+}
+
+// ID del paso temporal con ese texto ("+W"), -1 si no está armado
+static int StepId(const HotkeyManager &hotkeys, const std::string &text) {
+  for (int i = 0; i < 100; ++i) {
+    int id = HotkeyManager::HK_SEQUENCE_BASE + i;
+    if (hotkeys.GetHotkeyString(id) == text)
+      return id;
+  }
+  return -1;
+}
+
+static int StepsArmed(const HotkeyManager &hotkeys) {
+  int armed = 0;
+  for (int i = 0; i < 100; ++i)
+    armed += hotkeys.IsRegistered(HotkeyManager::HK_SEQUENCE_BASE + i);
+  return armed;
+}
+
+// Timer del fake sin ventana dueña: el primero activo, 0 si no hay
+static UINT_PTR ActiveTimer(const FakeDesktop &desk) {
+  for (UINT_PTR id = 1; id < 64; ++id)
+    if (desk.IsTimerActive(id))
+      return id;
+  return 0;
+}
+
+static std::vector<HotkeyManager::Sequence> Sequences(int *fired) {
+  auto fire = [fired](int action) { *fired = action; };
+  return {{"Ctrl+Alt+Space, W, 3", 203, fire},
+          {"Ctrl+Alt+Space, W, 4", 204, fire},
+          {"Ctrl+Alt+Space, A", 300, fire},
+          {"Ctrl+Alt+Space, W", 999, fire}}; // Prefijo: se rechaza
+}
+
+// Solo el líder queda registrado; cada paso arma las continuaciones
+// posibles (más Esc) y suelta las del paso anterior
+static void TestSequenceArming() {
+  FakeDesktop desk;
+  HotkeyManager hotkeys(&desk);
+  int fired = -1;
+  CHECK_EQ(hotkeys.SetSequences(Sequences(&fired)), 3);
+  const int leader = HotkeyManager::HK_LEADER_BASE;
+  CHECK(hotkeys.GetHotkeyString(leader) == "Ctrl+Alt+Space");
+  CHECK_EQ(StepsArmed(hotkeys), 0);
+
+  hotkeys.ProcessHotkey(leader);
+  CHECK(hotkeys.IsSequencePending());
+  CHECK_EQ(StepsArmed(hotkeys), 3); // W, A y Esc
+  CHECK(StepId(hotkeys, "+W") > 0 && StepId(hotkeys, "+A") > 0);
+  CHECK(StepId(hotkeys, "+Esc") > 0);
+
+  hotkeys.ProcessHotkey(StepId(hotkeys, "+W"));
+  CHECK_EQ(StepsArmed(hotkeys), 3); // 3, 4 y Esc
+  CHECK_EQ(StepId(hotkeys, "+W"), -1);
+  CHECK_EQ(fired, -1);
+
+  hotkeys.ProcessHotkey(StepId(hotkeys, "+3"));
+  CHECK_EQ(fired, 203);
+  CHECK(!hotkeys.IsSequencePending());
+  CHECK_EQ(StepsArmed(hotkeys), 0);
+  CHECK_EQ(ActiveTimer(desk), 0);
+}
+
+// Timeout, Esc y un hotkey ajeno a la secuencia cancelan sin disparar
+// nada de la secuencia; el ajeno se ejecuta normalmente
+static void TestSequenceCancel() {
+  FakeDesktop desk;
+  HotkeyManager hotkeys(&desk);
+  int fired = -1;
+  hotkeys.RegisterHotkey(120, MOD_CONTROL | MOD_ALT, '1',
+                         [&fired](int id) { fired = id; });
+  hotkeys.SetSequences(Sequences(&fired));
+  const int leader = HotkeyManager::HK_LEADER_BASE;
+
+  hotkeys.SetSequenceTimeout(800);
+  hotkeys.ProcessHotkey(leader);
+  UINT_PTR timer = ActiveTimer(desk);
+  CHECK(timer != 0);
+  CHECK(!hotkeys.ProcessTimer(timer + 1000));
+  CHECK(hotkeys.IsSequencePending());
+  CHECK(hotkeys.ProcessTimer(timer));
+  CHECK(!hotkeys.IsSequencePending());
+  CHECK_EQ(StepsArmed(hotkeys), 0);
+  CHECK_EQ(ActiveTimer(desk), 0);
+  CHECK_EQ(fired, -1);
+
+  hotkeys.ProcessHotkey(leader);
+  hotkeys.ProcessHotkey(StepId(hotkeys, "+W"));
+  hotkeys.ProcessHotkey(StepId(hotkeys, "+Esc"));
+  CHECK(!hotkeys.IsSequencePending());
+  CHECK_EQ(StepsArmed(hotkeys), 0);
+  CHECK_EQ(fired, -1);
+
+  hotkeys.ProcessHotkey(leader);
+  hotkeys.ProcessHotkey(120);
+  CHECK(!hotkeys.IsSequencePending());
+  CHECK_EQ(StepsArmed(hotkeys), 0);
+  CHECK_EQ(fired, 120);
+}
+
+// Un hotkey propio cuya combinación continúa la secuencia la avanza en
+// vez de cancelarla
+static void TestSequenceThroughOwnHotkey() {
+  FakeDesktop desk;
+  HotkeyManager hotkeys(&desk);
+  int fired = -1;
+  hotkeys.RegisterHotkey(120, MOD_CONTROL | MOD_ALT, '1',
+                         [&fired](int id) { fired = id; });
+  auto fire = [&fired](int action) { fired = action; };
+  CHECK_EQ(hotkeys.SetSequences({{"Ctrl+Alt+Space, Ctrl+Alt+1", 7, fire}}),
+           1);
+  hotkeys.ProcessHotkey(HotkeyManager::HK_LEADER_BASE);
+  CHECK_EQ(StepsArmed(hotkeys), 1); // Solo Esc: Ctrl+Alt+1 ya es propio
+  hotkeys.ProcessHotkey(120);
+  CHECK_EQ(fired, 7);
+  CHECK(!hotkeys.IsSequencePending());
+}
+
+// Recargar las mismas secuencias no toca los líderes registrados
+static void TestSequenceReload() {
+  FakeDesktop desk;
+  HotkeyManager hotkeys(&desk);
+  int fired = -1;
+  hotkeys.SetSequences(Sequences(&fired));
+  desk.ResetCounters();
+  hotkeys.SetSequences(Sequences(&fired));
+  CHECK_EQ(desk.Counters().hotkeyRegister, 0);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 0);
+  CHECK(hotkeys.IsRegistered(HotkeyManager::HK_LEADER_BASE));
+}
+
+// Guion de cambios de foco: el perfil de cada app desregistra del sistema
+// solo los atajos que desactiva y los vuelve a registrar al salir de ella
+static void TestProfileForegroundChange() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(10, "code.exe");
+  desk.AddProcess(11, "chrome.exe");
+  desk.AddProcess(12, "notepad.exe");
+  HWND code = desk.AddWindow("main.cpp", 10, {0, 0, 800, 600});
+  HWND chrome = desk.AddWindow("Google", 11, {100, 0, 900, 600});
+  HWND notes = desk.AddWindow("notas", 12, {200, 0, 1000, 600});
+  HWND notes2 = desk.AddWindow("otras notas", 12, {300, 0, 1100, 600});
+
+  HotkeyManager hotkeys(&desk);
+  WindowManager manager("HotkeyManagerTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  std::vector<KeymapProfiles::Spec> specs(2);
+  CHECK(KeymapProfiles::ParseSpec("editores", "code.exe", "layouts",
+                                  specs[0]));
+  CHECK(KeymapProfiles::ParseSpec("navegador", "chrome.exe", "nav",
+                                  specs[1]));
+  manager.GetKeymapProfiles().Compile(specs, HotkeyManager::MIN_ID,
+                                      HotkeyManager::MAX_ID);
+
+  int fired = -1;
+  const UINT navKeys[] = {VK_LEFT, VK_RIGHT, VK_UP, VK_DOWN};
+  for (int i = 0; i < 4; ++i)
+    hotkeys.RegisterHotkey(HotkeyManager::HK_NAV_LEFT + i,
+                           MOD_CONTROL | MOD_ALT, navKeys[i],
+                           [&fired](int id) { fired = id; });
+  const int first = HotkeyManager::HK_LAYOUT_BASE;
+  const int last = HotkeyManager::HK_APP_BASE + 100;
+  hotkeys.SyncRange(first, last, Bindings('D', -1, &fired));
+  manager.SetProfileHotkeys(&hotkeys);
+  desk.SetForeground(notes);
+
+  desk.ResetCounters();
+  desk.SetForeground(code);
+  CHECK_EQ(desk.Counters().hotkeyRegister, 0);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 10);
+  CHECK(hotkeys.IsRegistered(first) && hotkeys.IsSuspended(first));
+  CHECK(!hotkeys.IsSuspended(HotkeyManager::HK_APP_BASE));
+  CHECK(hotkeys.HasConflict(MOD_CONTROL | MOD_ALT, 'A'));
+  fired = -1;
+  hotkeys.ProcessHotkey(first); // WM_HOTKEY encolado antes del cambio
+  CHECK_EQ(fired, -1);
+
+  // Editar un layout suspendido no lo registra; sale con la tecla nueva
+  desk.ResetCounters();
+  hotkeys.SyncRange(first, last, Bindings('Z', -1, &fired));
+  CHECK_EQ(desk.Counters().hotkeyRegister, 0);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 0);
+  CHECK(hotkeys.IsSuspended(first + 3));
+
+  desk.ResetCounters();
+  desk.SetForeground(chrome);
+  CHECK_EQ(desk.Counters().hotkeyRegister, 10);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 4);
+  CHECK(!hotkeys.IsSuspended(first + 3));
+  CHECK(hotkeys.GetHotkeyString(first + 3) == "Ctrl+Alt+Z");
+  CHECK(hotkeys.IsSuspended(HotkeyManager::HK_NAV_UP));
+
+  // Otra app toma la combinación mientras está suspendida: sigue
+  // suspendida y se reintenta en el siguiente cambio
+  CHECK(desk.RegisterSystemHotkey(NULL, 900, MOD_CONTROL | MOD_ALT, VK_UP));
+  desk.ResetCounters();
+  desk.SetForeground(notes);
+  CHECK_EQ(desk.Counters().hotkeyRegister, 4);
+  CHECK_EQ(desk.Counters().hotkeyUnregister, 0);
+  CHECK(hotkeys.IsSuspended(HotkeyManager::HK_NAV_UP));
+  CHECK(!hotkeys.IsSuspended(HotkeyManager::HK_NAV_LEFT));
+  hotkeys.ProcessHotkey(HotkeyManager::HK_NAV_LEFT);
+  CHECK_EQ(fired, HotkeyManager::HK_NAV_LEFT);
+
+  // Misma app (mismo perfil): ninguna llamada
+  desk.ResetCounters();
+  desk.SetForeground(notes2);
+  CHECK_EQ(desk.Counters().hotkeyRegister + desk.Counters().hotkeyUnregister,
+           0);
+
+  desk.UnregisterSystemHotkey(NULL, 900);
+  desk.SetForeground(chrome);
+  desk.SetForeground(notes);
+  CHECK(!hotkeys.IsSuspended(HotkeyManager::HK_NAV_UP));
+  manager.SetProfileHotkeys(nullptr);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestSyncRangeCallCounts);
+  RUN_TEST(TestSyncRangeSwapAndCallback);
+  RUN_TEST(TestSequenceArming);
+  RUN_TEST(TestSequenceCancel);
+  RUN_TEST(TestSequenceThroughOwnHotkey);
+  RUN_TEST(TestSequenceReload);
+  RUN_TEST(TestProfileForegroundChange);
+  return testFailures;
+}
@@ -0,0 +1,231 @@
+#include "ContinuousMotion.h"
+#include "KeyStateMachine.h"
+#include "TestCheck.h"
+#include <cmath>
+
+typedef KeyStateMachine K;
+
+static bool StepIs(const K::Step &step, K::Mode mode, int x, int y,
+                   bool repeat) {
+  return step.mode == mode && step.x == x && step.y == y &&
+         step.repeat == repeat;
+}
+
+static void TestKeyMapping() {
+  CHECK_EQ(K::KeyFromVk(VK_LCONTROL), K::K_CTRL);
+  CHECK_EQ(K::KeyFromVk(VK_RMENU), K::K_ALT);
+  CHECK_EQ(K::KeyFromVk(VK_RSHIFT), K::K_SHIFT);
+  CHECK_EQ(K::KeyFromVk('Q'), -1);
+  for (int key = 0; key < K::K_COUNT; ++key)
+    CHECK_EQ(K::KeyFromVk(K::VkFromKey(key)), key);
+  CHECK_EQ(K::VkFromKey(K::K_COUNT), 0);
+}
+
+// Las teclas mantenidas siguen a los eventos; la autorrepetición del
+// teclado (otro "down" sin "up") no cambia nada
+static void TestHeldSet() {
+  K keys;
+  CHECK(keys.OnKey(K::K_CTRL, true, 0)); // Modo mover, aún sin dirección
+  CHECK(keys.IsDown(K::K_CTRL));
+  CHECK_EQ(keys.CurrentMode(), K::M_MOVE);
+  CHECK(keys.OnKey(K::K_D, true, 10));
+  CHECK(!keys.OnKey(K::K_D, true, 40));
+  CHECK(!keys.OnKey(K::K_D, true, 70));
+  CHECK(keys.IsDown(K::K_D) && !keys.IsDown(K::K_A));
+  CHECK(!keys.OnKey(-1, true, 80));
+  CHECK(!keys.OnKey(K::K_COUNT, true, 80));
+
+  CHECK(keys.OnKey(K::K_D, false, 100));
+  CHECK(!keys.IsDown(K::K_D));
+  CHECK(!keys.OnKey(K::K_D, false, 110)); // Ya estaba suelta
+  CHECK(keys.OnKey(K::K_CTRL, false, 120));
+  CHECK_EQ(keys.CurrentMode(), K::M_IDLE);
+
+  keys.OnKey(K::K_ALT, true, 130);
+  keys.Reset();
+  CHECK(!keys.IsDown(K::K_ALT));
+  CHECK_EQ(keys.CurrentMode(), K::M_IDLE);
+}
+
+// Modos y direcciones de cada combinación
+static void TestModes() {
+  K::Step step;
+  K keys;
+  keys.OnKey(K::K_CTRL, true, 0);
+  keys.OnKey(K::K_A, true, 0);
+  keys.OnKey(K::K_W, true, 0);
+  CHECK(keys.Poll(0, step) && StepIs(step, K::M_MOVE, -1, -1, false));
+
+  // Ctrl+S sin Shift queda para "Guardar": no hay paso
+  K save;
+  save.OnKey(K::K_CTRL, true, 0);
+  save.OnKey(K::K_S, true, 0);
+  CHECK(!save.Poll(0, step));
+  CHECK_EQ(save.NextDeadline(), -1);
+  CHECK(save.OnKey(K::K_SHIFT, true, 5));
+  CHECK(save.Poll(5, step) && StepIs(step, K::M_MOVE, 0, 1, false));
+
+  K resize;
+  resize.OnKey(K::K_ALT, true, 0);
+  resize.OnKey(K::K_S, true, 0);
+  resize.OnKey(K::K_D, true, 0);
+  CHECK(resize.Poll(0, step) && StepIs(step, K::M_RESIZE, 1, 1, false));
+  resize.OnKey(K::K_SHIFT, true, 20); // Cambio de modo: paso inmediato
+  CHECK(resize.Poll(20, step) &&
+        StepIs(step, K::M_RESIZE_INVERSE, 1, 1, false));
+
+  // Ctrl y Alt a la vez no hacen nada
+  resize.OnKey(K::K_CTRL, true, 30);
+  CHECK_EQ(resize.CurrentMode(), K::M_IDLE);
+  CHECK(!resize.Poll(30, step));
+  CHECK_EQ(resize.NextDeadline(), -1);
+}
+
+// Despertar y dormir: sin teclas NextDeadline es -1 (esperar sin
+// timeout); el primer paso vence al pulsar y después cada REPEAT_MS tras
+// INITIAL_DELAY_MS; al soltar vuelve a -1
+static void TestWakeSleep() {
+  K::Step step;
+  K keys;
+  CHECK_EQ(keys.NextDeadline(), -1);
+  CHECK(!keys.Poll(1000, step));
+  keys.OnKey(K::K_CTRL, true, 1000);
+  CHECK_EQ(keys.NextDeadline(), -1);
+
+  keys.OnKey(K::K_D, true, 1005);
+  CHECK_EQ(keys.NextDeadline(), 1005);
+  CHECK(keys.Poll(1005, step) && StepIs(step, K::M_MOVE, 1, 0, false));
+  CHECK_EQ(keys.NextDeadline(), 1005 + K::INITIAL_DELAY_MS);
+  CHECK(!keys.Poll(1100, step)); // Antes de tiempo
+  keys.OnKey(K::K_D, true, 1120); // Autorrepetición: no adelanta nada
+  CHECK_EQ(keys.NextDeadline(), 1005 + K::INITIAL_DELAY_MS);
+
+  double due = 1005 + K::INITIAL_DELAY_MS;
+  for (int i = 0; i < 5; ++i) {
+    CHECK(keys.Poll(due, step) && StepIs(step, K::M_MOVE, 1, 0, true));
+    due += K::REPEAT_MS;
+    CHECK_EQ(keys.NextDeadline(), due);
+  }
+
+  // Cambiar de dirección sin soltar mantiene el ritmo
+  keys.OnKey(K::K_W, true, due - 3);
+  CHECK_EQ(keys.NextDeadline(), due);
+  CHECK(keys.Poll(due, step) && StepIs(step, K::M_MOVE, 1, -1, true));
+
+  keys.OnKey(K::K_D, false, due + 1);
+  keys.OnKey(K::K_W, false, due + 2);
+  CHECK_EQ(keys.NextDeadline(), -1);
+  CHECK(!keys.Poll(due + 100, step));
+
+  // Volver a pulsar: primer paso inmediato otra vez
+  keys.OnKey(K::K_A, true, 5000);
+  CHECK_EQ(keys.NextDeadline(), 5000);
+  CHECK(keys.Poll(5000, step) && StepIs(step, K::M_MOVE, -1, 0, false));
+}
+
+// El bucle del hilo (MsgWaitForMultipleObjects con el timeout de
+// NextDeadline) con un reloj simulado: despierta solo por eventos de
+// tecla o al vencer un paso, y el primer movimiento sale en el instante de
+// la pulsación
+static void TestFirstMoveTiming() {
+  struct Event {
+    double at;
+    int key;
+    bool down;
+  };
+  const Event events[] = {
+      {2000.5, K::K_CTRL, true}, {2030.25, K::K_W, true},
+      {2500, K::K_W, false},     {2510, K::K_CTRL, false},
+      {9000, K::K_ALT, true},    {9001, K::K_D, true},
+      {9100, K::K_D, false},     {9110, K::K_ALT, false}};
+  const int count = sizeof(events) / sizeof(events[0]);
+  const double end = 20000;
+
+  K keys;
+  K::Step step;
+  double now = 0;
+  int next = 0, wakeups = 0, idleWakeups = 0, steps = 0, firsts = 0;
+  bool firstAtPress = true;
+  while (true) {
+    double deadline = keys.NextDeadline();
+    double eventAt = next < count ? events[next].at : end;
+    bool byEvent = deadline < 0 || eventAt <= deadline;
+    now = byEvent ? eventAt : deadline;
+    if (now >= end)
+      break;
+    wakeups++;
+    if (byEvent) {
+      if (!keys.IsDown(K::K_CTRL) && !keys.IsDown(K::K_ALT))
+        idleWakeups++;
+      keys.OnKey(events[next].key, events[next].down, now);
+      next++;
+    }
+    while (keys.Poll(now, step)) {
+      steps++;
+      if (!step.repeat) {
+        firsts++;
+        firstAtPress = firstAtPress && (now == 2030.25 || now == 9001);
+      }
+    }
+  }
+  CHECK_EQ(firsts, 2);
+  CHECK(firstAtPress);
+  // Solo las pulsaciones de Ctrl y Alt despiertan sin nada pendiente
+  CHECK_EQ(idleWakeups, 2);
+  // W: el primero, el de INITIAL_DELAY_MS y uno cada REPEAT_MS hasta
+  // soltar. D se suelta antes de repetir: solo el primero
+  int wSteps = 2 + (int)((2500 - 2030.25 - K::INITIAL_DELAY_MS) /
+                         K::REPEAT_MS);
+  CHECK_EQ(steps, wSteps + 1);
+  // Los dos primeros pasos salen en la misma vuelta que su evento
+  CHECK_EQ(wakeups, count + steps - 2);
+}
+
+// La distancia recorrida depende del tiempo y no del ritmo de frames
+static void TestMotionDistance() {
+  ContinuousMotion motion;
+  CHECK(motion.SpeedAt(0) == 900);
+  CHECK(motion.SpeedAt(300) > 900 && motion.SpeedAt(300) < 2700);
+  CHECK(motion.SpeedAt(600) == 2700);
+  CHECK(motion.SpeedAt(5000) == 2700);
+
+  auto run = [](double frameMs, double jitter) {
+    ContinuousMotion m;
+    m.Begin(0);
+    int total = 0, dx, dy;
+    double t = 0;
+    int i = 0;
+    while (t < 1000) {
+      t += frameMs + ((i++ & 1) ? jitter : -jitter);
+      if (t > 1000)
+        t = 1000;
+      m.Advance(t, 1, 0, dx, dy);
+      total += dx;
+    }
+    return total;
+  };
+  int regular = run(16, 0), jittered = run(16, 7), slow = run(50, 0);
+  // Rampa cuadrática: 900 px/s + 1800 / 3 durante 600 ms, luego 2700
+  CHECK(std::abs(regular - 1980) <= 2);
+  CHECK(std::abs(jittered - regular) <= 2);
+  CHECK(std::abs(slow - regular) <= 2);
+
+  // Un frame muy tardío no lanza la ventana: como mucho 100 ms
+  ContinuousMotion m;
+  m.Begin(0);
+  int dx, dy;
+  m.Advance(5000, 0, -1, dx, dy);
+  CHECK_EQ(dx, 0);
+  CHECK(dy < 0 && dy >= -270);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestKeyMapping);
+  RUN_TEST(TestHeldSet);
+  RUN_TEST(TestModes);
+  RUN_TEST(TestWakeSleep);
+  RUN_TEST(TestFirstMoveTiming);
+  RUN_TEST(TestMotionDistance);
+  return testFailures;
+}
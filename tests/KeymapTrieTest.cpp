@@ -0,0 +1,95 @@
+#include "KeymapTrie.h"
+#include "TestCheck.h"
+#include <vector>
+
+typedef std::vector<KeymapTrie::Combo> Keys;
+
+static KeymapTrie::Combo K(UINT modifiers, UINT vk) {
+  return KeymapTrie::MakeCombo(modifiers, vk);
+}
+
+// Acción a la que lleva la secuencia completa; -1 si no es una hoja y -2
+// si se sale del trie
+static int Match(const KeymapTrie &trie, const Keys &keys) {
+  int node = KeymapTrie::ROOT;
+  for (KeymapTrie::Combo c : keys) {
+    node = trie.Step(node, c);
+    if (node < 0)
+      return -2;
+  }
+  return trie.Action(node);
+}
+
+static void TestCombo() {
+  KeymapTrie::Combo c = K(MOD_CONTROL | MOD_ALT, VK_SPACE);
+  CHECK_EQ(KeymapTrie::ComboModifiers(c), MOD_CONTROL | MOD_ALT);
+  CHECK_EQ(KeymapTrie::ComboVk(c), VK_SPACE);
+  CHECK(K(MOD_CONTROL, 'A') != K(MOD_ALT, 'A'));
+}
+
+static void TestAddRejects() {
+  KeymapTrie trie;
+  const UINT lead = MOD_CONTROL | MOD_ALT;
+  CHECK(trie.Add({K(lead, VK_SPACE), K(0, 'W'), K(0, '3')}, 1));
+  CHECK(!trie.Add({}, 2));
+  CHECK(!trie.Add({K(lead, VK_SPACE), K(0, 'W'), K(0, '3')}, 2));
+  CHECK(!trie.Add({K(lead, VK_SPACE), K(0, 'W')}, 2));
+  CHECK(!trie.Add({K(lead, VK_SPACE), K(0, 'W'), K(0, '3'), K(0, '1')}, 2));
+  CHECK(trie.Add({K(lead, VK_SPACE), K(0, 'W'), K(0, '4')}, 2));
+  trie.Compile();
+  CHECK_EQ(Match(trie, {K(lead, VK_SPACE), K(0, 'W'), K(0, '3')}), 1);
+  CHECK_EQ(Match(trie, {K(lead, VK_SPACE), K(0, 'W'), K(0, '4')}), 2);
+}
+
+// Los hijos quedan ordenados y Step encuentra cada uno; combinaciones
+// fuera del trie dan -1
+static void TestStepAndChildren() {
+  KeymapTrie trie;
+  const UINT lead = MOD_CONTROL | MOD_ALT;
+  const char keys[] = "ZQAMC";
+  for (int i = 0; i < 5; ++i)
+    CHECK(trie.Add({K(lead, VK_SPACE), K(0, (UINT)keys[i])}, 10 + i));
+  CHECK(trie.Add({K(MOD_WIN, 'K'), K(MOD_SHIFT, 'K')}, 20));
+  trie.Compile();
+
+  int leader = trie.Step(KeymapTrie::ROOT, K(lead, VK_SPACE));
+  CHECK(leader > 0);
+  CHECK_EQ(trie.Action(leader), -1);
+  CHECK_EQ(trie.ChildCount(KeymapTrie::ROOT), 2);
+  CHECK_EQ(trie.ChildCount(leader), 5);
+  for (int i = 1; i < trie.ChildCount(leader); ++i)
+    CHECK(trie.ChildKey(leader, i - 1) < trie.ChildKey(leader, i));
+  for (int i = 0; i < 5; ++i)
+    CHECK_EQ(Match(trie, {K(lead, VK_SPACE), K(0, (UINT)keys[i])}), 10 + i);
+
+  CHECK_EQ(trie.Step(leader, K(0, 'B')), -1);
+  CHECK_EQ(trie.Step(leader, K(MOD_SHIFT, 'Z')), -1);
+  CHECK_EQ(trie.Step(KeymapTrie::ROOT, K(0, VK_SPACE)), -1);
+  CHECK_EQ(Match(trie, {K(MOD_WIN, 'K'), K(MOD_SHIFT, 'K')}), 20);
+  CHECK_EQ(Match(trie, {K(MOD_WIN, 'K'), K(0, 'K')}), -2);
+  // Raíz, líder + 5 hojas, Win+K + 1 hoja
+  CHECK_EQ(trie.NodeCount(), 9);
+}
+
+static void TestClear() {
+  KeymapTrie trie;
+  CHECK(trie.Add({K(MOD_ALT, 'A'), K(0, 'B')}, 1));
+  trie.Compile();
+  trie.Clear();
+  trie.Compile();
+  CHECK_EQ(trie.NodeCount(), 1);
+  CHECK_EQ(trie.ChildCount(KeymapTrie::ROOT), 0);
+  CHECK_EQ(trie.Step(KeymapTrie::ROOT, K(MOD_ALT, 'A')), -1);
+  CHECK(trie.Add({K(MOD_ALT, 'A'), K(0, 'B')}, 3));
+  trie.Compile();
+  CHECK_EQ(Match(trie, {K(MOD_ALT, 'A'), K(0, 'B')}), 3);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestCombo);
+  RUN_TEST(TestAddRejects);
+  RUN_TEST(TestStepAndChildren);
+  RUN_TEST(TestClear);
+  return testFailures;
+}
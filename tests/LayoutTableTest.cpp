@@ -0,0 +1,155 @@
+#include "FakeDesktop.h"
+#include "LayoutTable.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <vector>
+
+// La cuenta que repetían ApplyLayout, CyclePosition25 y
+// RestorePreviousPosition en cada pulsación antes de la tabla
+static PixelRect OldRect(const RECT &workArea, const WindowLayout &layout,
+                         int margin) {
+  int screenW = workArea.right - workArea.left;
+  int screenH = workArea.bottom - workArea.top;
+  int baseX = workArea.left + (int)(screenW * layout.x);
+  int baseY = workArea.top + (int)(screenH * layout.y);
+  int baseW = (int)(screenW * layout.width);
+  int baseH = (int)(screenH * layout.height);
+  int width = baseW - (margin * 2);
+  int height = baseH - (margin * 2);
+  if (width < 100)
+    width = 100;
+  if (height < 100)
+    height = 100;
+  return {baseX + margin, baseY + margin, width, height};
+}
+
+static bool Same(const PixelRect &a, const PixelRect &b) {
+  return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+static bool Same(const RECT &r, const PixelRect &p) {
+  return r.left == p.x && r.top == p.y && r.right - r.left == p.w &&
+         r.bottom - r.top == p.h;
+}
+
+static RECT RectOf(FakeDesktop &desk, HWND hwnd) {
+  RECT r = {0, 0, 0, 0};
+  desk.GetRect(hwnd, r);
+  return r;
+}
+
+static unsigned seed = 13;
+static int Rnd(int range) {
+  seed = seed * 1103515245 + 12345;
+  return (int)((seed >> 8) % range);
+}
+
+// Compute da lo mismo que la fórmula de antes con los layouts por defecto,
+// las 25 posiciones y layouts al azar, en áreas y márgenes al azar
+static void TestComputeMatchesOldFormula() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  WindowManager manager("LayoutTableTest.cfg", &desk);
+  std::vector<WindowLayout> layouts = manager.GetLayouts();
+  CHECK(!layouts.empty());
+  for (int i = 0; i < 200; ++i)
+    layouts.push_back(WindowLayout("r", Rnd(1000) / 1000.0f,
+                                   Rnd(1000) / 1000.0f, Rnd(1001) / 1000.0f,
+                                   Rnd(1001) / 1000.0f));
+
+  bool same = true;
+  for (int round = 0; round < 100; ++round) {
+    int left = Rnd(6000) - 3000, top = Rnd(3000) - 1500;
+    RECT area = {left, top, left + 640 + Rnd(4000), top + 480 + Rnd(2000)};
+    int margin = Rnd(40);
+    for (const WindowLayout &layout : layouts)
+      same = same && Same(LayoutTable::Compute(area, layout, margin),
+                          OldRect(area, layout, margin));
+  }
+  CHECK(same);
+}
+
+// Cada monitor tiene sus layouts y después sus posiciones
+static void TestTableLookup() {
+  std::vector<MonitorDesc> monitors(2);
+  monitors[0].handle = (HMONITOR)1;
+  monitors[0].rcWork = {0, 0, 1920, 1040};
+  monitors[1].handle = (HMONITOR)2;
+  monitors[1].rcWork = {1920, 0, 3200, 984};
+  std::vector<WindowLayout> layouts = {WindowLayout("a", 0, 0, 0.5f, 1),
+                                       WindowLayout("b", 0.5f, 0, 0.5f, 1)};
+  std::vector<WindowLayout> positions = {WindowLayout("1", 0, 0, 1, 0.5f),
+                                         WindowLayout("2", 0, 0.5f, 1, 0.5f),
+                                         WindowLayout("3", 0.25f, 0.25f,
+                                                      0.5f, 0.5f)};
+  LayoutTable table;
+  table.Rebuild(monitors, layouts, positions, 8);
+  CHECK_EQ(table.MonitorCount(), 2);
+  CHECK_EQ(table.FindMonitor((HMONITOR)2), 1);
+  CHECK_EQ(table.FindMonitor((HMONITOR)3), -1);
+
+  bool same = true;
+  for (int m = 0; m < 2; ++m) {
+    for (size_t i = 0; i < layouts.size(); ++i)
+      same = same && Same(*table.LayoutRect(m, (int)i),
+                          OldRect(monitors[m].rcWork, layouts[i], 8));
+    for (size_t i = 0; i < positions.size(); ++i)
+      same = same && Same(*table.PositionRect(m, (int)i),
+                          OldRect(monitors[m].rcWork, positions[i], 8));
+  }
+  CHECK(same);
+  CHECK(table.LayoutRect(-1, 0) == nullptr);
+  CHECK(table.LayoutRect(2, 0) == nullptr);
+  CHECK(table.LayoutRect(0, 2) == nullptr);
+  CHECK(table.PositionRect(0, 3) == nullptr);
+  CHECK(table.PositionRect(1, -1) == nullptr);
+}
+
+// El WindowManager no pregunta al sistema en cada pulsación, y la tabla
+// sigue al margen, al área de trabajo y a los monitores que aparecen
+static void TestManagerRebuilds() {
+  FakeDesktop desk;
+  HMONITOR m1 = desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  HWND hwnd = desk.AddWindow("w", 100, {100, 100, 500, 400});
+  WindowManager manager("LayoutTableTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  manager.SetMargin(6);
+  WindowLayout half = manager.GetLayouts()[0];
+
+  manager.ApplyLayout(hwnd, 0);
+  CHECK(Same(RectOf(desk, hwnd), OldRect({0, 0, 1920, 1040}, half, 6)));
+  desk.ResetCounters();
+  for (int i = 0; i < 50; ++i)
+    manager.ApplyLayout(hwnd, i % manager.GetLayoutCount());
+  CHECK_EQ(desk.Counters().monitorQueries, 0);
+
+  manager.SetMargin(20);
+  manager.ApplyLayout(hwnd, 0);
+  CHECK(Same(RectOf(desk, hwnd), OldRect({0, 0, 1920, 1040}, half, 20)));
+
+  desk.SetWorkArea(m1, {0, 40, 1920, 1080}); // Barra de tareas arriba
+  manager.ApplyLayout(hwnd, 0);
+  CHECK(Same(RectOf(desk, hwnd), OldRect({0, 40, 1920, 1080}, half, 20)));
+
+  // Un monitor nuevo a la derecha, con la ventana arrastrada hasta él
+  desk.AddMonitor({1920, 0, 3200, 1024}, {1920, 0, 3200, 984});
+  desk.DragWindow(hwnd, {2000, 100, 2400, 400});
+  manager.ApplyLayout(hwnd, 0);
+  CHECK(Same(RectOf(desk, hwnd), OldRect({1920, 0, 3200, 984}, half, 20)));
+
+  // Las 25 posiciones salen de la misma tabla: la primera, mitad izquierda
+  manager.CyclePosition25(hwnd);
+  CHECK(Same(RectOf(desk, hwnd),
+             OldRect({1920, 0, 3200, 984},
+                     WindowLayout("", 0.0f, 0.0f, 0.5f, 1.0f), 20)));
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestComputeMatchesOldFormula);
+  RUN_TEST(TestTableLookup);
+  RUN_TEST(TestManagerRebuilds);
+  return testFailures;
+}
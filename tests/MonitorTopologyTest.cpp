@@ -0,0 +1,168 @@
+#include "FakeDesktop.h"
+#include "MonitorTopology.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <vector>
+
+typedef MonitorTopology T;
+
+// Rehace la topología con cada aviso de cambio de pantallas, como el
+// WindowManager
+struct DisplaySink : DesktopEventSink {
+  FakeDesktop *desk = nullptr;
+  MonitorTopology topology;
+  int rebuilds = 0;
+  void OnDisplayChanged() override {
+    std::vector<MonitorDesc> monitors;
+    desk->ListMonitors(monitors);
+    topology.Rebuild(monitors);
+    rebuilds++;
+  }
+  void OnWindowEvent(HWND, WindowEvent) override {}
+};
+
+// Las esquinas y el centro de cada monitor caen en él
+static bool Covers(FakeDesktop &desk, const MonitorTopology &topology) {
+  std::vector<MonitorDesc> monitors;
+  desk.ListMonitors(monitors);
+  if (monitors.size() != topology.Size())
+    return false;
+  for (const MonitorDesc &mon : monitors) {
+    const RECT &r = mon.rcMonitor;
+    int index = topology.IndexOf(mon.handle);
+    POINT points[] = {{r.left, r.top},
+                      {r.right - 1, r.bottom - 1},
+                      {(r.left + r.right) / 2, (r.top + r.bottom) / 2}};
+    for (const POINT &pt : points) {
+      if (index < 0 || topology.IndexAt(pt) != index)
+        return false;
+    }
+  }
+  return true;
+}
+
+// El primer monitor y dos más a los lados; uno debajo; después se quitan
+// de uno en uno. Tras cada cambio: orden, vecinos, siguiente/anterior y
+// búsqueda por punto, incluidos los huecos
+static void TestHotplug() {
+  FakeDesktop desk;
+  DisplaySink sink;
+  sink.desk = &desk;
+  desk.SetEventSink(&sink);
+  const MonitorTopology &t = sink.topology;
+
+  HMONITOR m1 = desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  CHECK_EQ(sink.rebuilds, 1);
+  CHECK_EQ(t.Size(), 1);
+  CHECK(Covers(desk, t));
+  CHECK_EQ(t.Next(0), 0);
+  CHECK_EQ(t.Prev(0), 0);
+  CHECK_EQ(t.Neighbor(0, T::SIDE_LEFT), -1);
+  CHECK_EQ(t.IndexAt({-500, 10}), 0); // El más cercano
+
+  HMONITOR m2 =
+      desk.AddMonitor({1920, 0, 3840, 1080}, {1920, 0, 3840, 1040});
+  CHECK_EQ(sink.rebuilds, 2);
+  CHECK(Covers(desk, t));
+  CHECK(t.At(0).handle == m1 && t.At(1).handle == m2);
+  CHECK_EQ(t.Neighbor(0, T::SIDE_RIGHT), 1);
+  CHECK_EQ(t.Neighbor(1, T::SIDE_LEFT), 0);
+  CHECK_EQ(t.Neighbor(1, T::SIDE_RIGHT), -1);
+  CHECK_EQ(t.Next(1), 0);
+  CHECK_EQ(t.Prev(0), 1);
+  CHECK_EQ(t.IndexAt({1920, 0}), 1); // El borde es del de la derecha
+  CHECK_EQ(t.Primary(), 0);
+
+  // A la izquierda: los índices se corren
+  HMONITOR m3 = desk.AddMonitor({-1280, 0, 0, 1024}, {-1280, 0, 0, 984});
+  CHECK(Covers(desk, t));
+  CHECK(t.At(0).handle == m3 && t.At(1).handle == m1);
+  CHECK_EQ(t.Primary(), 1);
+  CHECK_EQ(t.Neighbor(0, T::SIDE_RIGHT), 1);
+  CHECK_EQ(t.Neighbor(1, T::SIDE_LEFT), 0);
+  CHECK_EQ(t.Next(2), 0);
+  CHECK_EQ(t.Prev(0), 2);
+  CHECK_EQ(t.IndexAt({-10, 1050}), 1); // Hueco bajo m3, más cerca de m1
+  CHECK(t.Bounds().left == -1280 && t.Bounds().right == 3840);
+
+  // Debajo de m1: el orden es por izquierda y luego por arriba
+  HMONITOR m4 =
+      desk.AddMonitor({0, 1080, 1920, 2160}, {0, 1080, 1920, 2120});
+  CHECK(Covers(desk, t));
+  CHECK(t.At(2).handle == m4 && t.At(3).handle == m2);
+  CHECK_EQ(t.Neighbor(1, T::SIDE_DOWN), 2);
+  CHECK_EQ(t.Neighbor(2, T::SIDE_UP), 1);
+  CHECK_EQ(t.Neighbor(2, T::SIDE_RIGHT), -1); // Solo tocan por la esquina
+  CHECK_EQ(t.Neighbor(3, T::SIDE_LEFT), 1);
+  CHECK_EQ(t.Next(1), 2);
+  CHECK_EQ(t.IndexAt({2000, 1800}), 2); // Hueco bajo m2, junto a m4
+
+  // Quitar el principal: pasa a serlo el primero que queda en el sistema
+  desk.RemoveMonitor(m1);
+  CHECK(Covers(desk, t));
+  CHECK(t.At(0).handle == m3 && t.At(1).handle == m4 &&
+        t.At(2).handle == m2);
+  CHECK_EQ(t.Primary(), t.IndexOf(m2));
+  CHECK_EQ(t.IndexOf(m1), -1);
+  CHECK_EQ(t.Neighbor(1, T::SIDE_UP), -1);
+  // Por encima del hueco: el vecino es el siguiente que comparte tramo
+  CHECK_EQ(t.Neighbor(0, T::SIDE_RIGHT), 2);
+  CHECK_EQ(t.Neighbor(2, T::SIDE_LEFT), 0);
+  CHECK_EQ(t.Neighbor(1, T::SIDE_RIGHT), -1);
+  CHECK_EQ(t.IndexAt({100, 100}), 0); // Donde estaba m1
+  CHECK_EQ(t.Next(2), 0);
+
+  desk.RemoveMonitor(m3);
+  desk.RemoveMonitor(m4);
+  CHECK(Covers(desk, t));
+  CHECK(t.At(0).handle == m2);
+  CHECK_EQ(t.Next(0), 0);
+  CHECK_EQ(t.Prev(0), 0);
+  CHECK_EQ(t.IndexAt({0, 0}), 0);
+
+  desk.RemoveMonitor(m2);
+  CHECK_EQ(sink.rebuilds, 8);
+  CHECK(t.Empty());
+  CHECK_EQ(t.IndexAt({0, 0}), -1);
+  CHECK_EQ(t.Next(0), -1);
+  CHECK_EQ(t.Prev(0), -1);
+  CHECK_EQ(t.Neighbor(0, T::SIDE_LEFT), -1);
+  CHECK_EQ(t.Primary(), -1);
+  desk.SetEventSink(nullptr);
+}
+
+// El WindowManager rehace su topología con el aviso, una sola vez, y
+// entre cambios no vuelve a preguntar al sistema
+static void TestManagerFollowsHotplug() {
+  FakeDesktop desk;
+  HMONITOR m1 = desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  WindowManager manager("MonitorTopologyTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+  HWND hwnd = desk.AddWindow("w", 100, {-1000, 100, -200, 700});
+  MonitorDesc mon;
+  CHECK(manager.GetMonitorFor(hwnd, mon) && mon.handle == m1);
+
+  HMONITOR m2 = desk.AddMonitor({-1280, 0, 0, 1024}, {-1280, 0, 0, 984});
+  desk.ResetCounters();
+  for (int i = 0; i < 100; ++i)
+    CHECK(manager.GetMonitorFor(hwnd, mon) && mon.handle == m2);
+  CHECK_EQ(desk.Counters().monitorQueries, 1);
+  manager.MoveWindowToMonitor(hwnd, true);
+  RECT r;
+  desk.GetRect(hwnd, r);
+  CHECK(r.left >= 0 && r.right <= 1920);
+
+  desk.RemoveMonitor(m1);
+  CHECK(manager.GetMonitorFor(hwnd, mon) && mon.handle == m2);
+  desk.RemoveMonitor(m2);
+  CHECK(!manager.GetMonitorFor(hwnd, mon));
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestHotplug);
+  RUN_TEST(TestManagerFollowsHotplug);
+  return testFailures;
+}
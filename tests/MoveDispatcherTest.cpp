@@ -0,0 +1,192 @@
+#include "FakeDesktop.h"
+#include "MoveDispatcher.h"
+#include "TestCheck.h"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static const int TIMEOUT_MS = 40;
+static const int COOLDOWN_MS = 30000;
+
+static double ElapsedMs(Clock::time_point since) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - since)
+      .count();
+}
+
+// Cuatro procesos con dos ventanas cada uno
+struct Scene {
+  FakeDesktop desk;
+  std::vector<HWND> windows;
+
+  Scene() {
+    desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+    for (DWORD pid = 100; pid < 104; ++pid) {
+      desk.AddProcess(pid, "app" + std::to_string(pid) + ".exe");
+      for (int i = 0; i < 2; ++i)
+        windows.push_back(desk.AddWindow("w", pid, {0, 0, 400, 300}));
+    }
+  }
+
+  std::vector<WindowPos> Moves(int x) const {
+    std::vector<WindowPos> moves;
+    for (size_t i = 0; i < windows.size(); ++i)
+      moves.push_back({windows[i], x, (int)i * 10, 300, 200, SWP_NOZORDER});
+    return moves;
+  }
+
+  LONG Left(HWND hwnd) {
+    RECT r;
+    desk.GetRect(hwnd, r);
+    return r.left;
+  }
+};
+
+// El hilo atascado vuelve en cuanto se suelta la ventana; hasta entonces
+// su proceso sigue fuera
+static bool WaitApplied(MoveDispatcher &dispatcher, const WindowPos &move) {
+  for (int i = 0; i < 400; ++i) {
+    if (dispatcher.Apply({move}).applied == 1)
+      return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return false;
+}
+
+static void TestAllResponsive() {
+  Scene scene;
+  MoveDispatcher dispatcher(&scene.desk, 4);
+  dispatcher.Configure(TIMEOUT_MS, COOLDOWN_MS);
+  MoveDispatcher::Result result = dispatcher.Apply(scene.Moves(500));
+  CHECK_EQ(result.applied, 8);
+  CHECK_EQ(result.timedOut, 0);
+  CHECK_EQ(result.skipped, 0);
+  for (HWND hwnd : scene.windows)
+    CHECK_EQ(scene.Left(hwnd), 500);
+}
+
+// Una ventana colgada: Apply vuelve al vencer el plazo, la marca, salta la
+// otra ventana de su proceso detrás de ella y mueve las demás
+static void TestHungWindowTimesOut() {
+  Scene scene;
+  MoveDispatcher dispatcher(&scene.desk, 4);
+  dispatcher.Configure(TIMEOUT_MS, COOLDOWN_MS);
+  HWND hung = scene.windows[2]; // Primera del proceso 101
+  HWND sibling = scene.windows[3];
+  scene.desk.SetPosDelay(hung, 10000);
+
+  Clock::time_point start = Clock::now();
+  MoveDispatcher::Result result = dispatcher.Apply(scene.Moves(500));
+  CHECK(ElapsedMs(start) < 2000);
+  CHECK_EQ(result.timedOut, 1);
+  CHECK_EQ(result.skipped, 1);
+  CHECK_EQ(result.applied, 6);
+  CHECK(dispatcher.IsUnresponsive(hung));
+  CHECK(!dispatcher.IsUnresponsive(sibling));
+  CHECK_EQ(dispatcher.UnresponsiveCount(), 1);
+  CHECK_EQ(scene.Left(sibling), 0);
+  CHECK_EQ(scene.Left(scene.windows[0]), 500);
+
+  // Mientras el hilo siga dentro de SetPos, su proceso se salta sin
+  // esperar otra vez el plazo
+  result = dispatcher.Apply({{sibling, 700, 0, 300, 200, SWP_NOZORDER}});
+  CHECK_EQ(result.applied, 0);
+  CHECK_EQ(result.skipped, 1);
+
+  // El pool sustituyó al hilo atascado: los demás procesos siguen en
+  // paralelo
+  result = dispatcher.Apply({scene.Moves(600)[0], scene.Moves(600)[4]});
+  CHECK_EQ(result.applied, 2);
+
+  scene.desk.SetPosDelay(hung, 0);
+  CHECK(WaitApplied(dispatcher, {sibling, 700, 0, 300, 200, SWP_NOZORDER}));
+  CHECK_EQ(scene.Left(sibling), 700);
+}
+
+// El enfriamiento va con el reloj virtual: la ventana se sigue saltando
+// aunque ya responda, hasta que pasa el enfriamiento
+static void TestCooldownUsesVirtualClock() {
+  Scene scene;
+  MoveDispatcher dispatcher(&scene.desk, 4);
+  dispatcher.Configure(TIMEOUT_MS, COOLDOWN_MS);
+  HWND hung = scene.windows[5];
+  scene.desk.SetPosDelay(hung, 10000);
+  CHECK_EQ(dispatcher.Apply(scene.Moves(500)).timedOut, 1);
+  scene.desk.SetPosDelay(hung, 0);
+  CHECK(WaitApplied(dispatcher, scene.Moves(500)[4]));
+
+  scene.desk.SleepMs(COOLDOWN_MS - 1);
+  MoveDispatcher::Result result = dispatcher.Apply({scene.Moves(800)[5]});
+  CHECK_EQ(result.applied, 0);
+  CHECK_EQ(result.skipped, 1);
+  CHECK(dispatcher.IsUnresponsive(hung));
+
+  scene.desk.SleepMs(2);
+  CHECK(!dispatcher.IsUnresponsive(hung));
+  CHECK_EQ(dispatcher.UnresponsiveCount(), 0);
+  result = dispatcher.Apply({scene.Moves(800)[5]});
+  CHECK_EQ(result.applied, 1);
+  CHECK_EQ(result.skipped, 0);
+  CHECK_EQ(scene.Left(hung), 800);
+}
+
+// Un SetPosBatch por proceso: las ventanas de un proceso juntas, los
+// procesos en paralelo
+static void TestBatchSplitsByProcess() {
+  Scene scene;
+  MoveDispatcher dispatcher(&scene.desk, 4);
+  dispatcher.Configure(TIMEOUT_MS, COOLDOWN_MS);
+  scene.desk.ResetCounters();
+  MoveDispatcher::Result result = dispatcher.ApplyBatch(scene.Moves(500));
+  CHECK_EQ(result.applied, 8);
+  CHECK_EQ(result.timedOut, 0);
+  CHECK_EQ(scene.desk.Counters().setPosBatch, 4);
+  CHECK_EQ(scene.desk.Counters().setPos, 0);
+  for (HWND hwnd : scene.windows)
+    CHECK_EQ(scene.Left(hwnd), 500);
+}
+
+// Un lote que vence aparta solo las ventanas de su proceso (timedOut) y
+// el resto sigue moviéndose en el mismo frame y en los siguientes
+static void TestBatchTimeoutIsolatesProcess() {
+  Scene scene;
+  MoveDispatcher dispatcher(&scene.desk, 4);
+  dispatcher.Configure(TIMEOUT_MS, COOLDOWN_MS);
+  HWND hung = scene.windows[3]; // Segunda del proceso 101
+  scene.desk.SetPosDelay(hung, 10000);
+
+  MoveDispatcher::Result result = dispatcher.ApplyBatch(scene.Moves(500));
+  CHECK_EQ(result.applied, 6);
+  CHECK_EQ(result.timedOut, 2);
+  CHECK_EQ(result.skipped, 0);
+  CHECK(dispatcher.IsUnresponsive(scene.windows[2]));
+  CHECK(dispatcher.IsUnresponsive(hung));
+  CHECK_EQ(dispatcher.UnresponsiveCount(), 2);
+
+  // Siguiente frame: sin esperar al colgado, los otros procesos se mueven
+  result = dispatcher.ApplyBatch(scene.Moves(600));
+  CHECK_EQ(result.applied, 6);
+  CHECK_EQ(result.timedOut, 0);
+  CHECK_EQ(result.skipped, 2);
+  CHECK_EQ(scene.Left(scene.windows[0]), 600);
+  CHECK_EQ(scene.Left(scene.windows[7]), 600);
+
+  scene.desk.SetPosDelay(hung, 0);
+  scene.desk.SleepMs(COOLDOWN_MS + 1);
+  CHECK(WaitApplied(dispatcher, scene.Moves(700)[2]));
+  result = dispatcher.ApplyBatch(scene.Moves(800));
+  CHECK_EQ(result.applied, 8);
+  CHECK_EQ(scene.Left(hung), 800);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestAllResponsive);
+  RUN_TEST(TestHungWindowTimesOut);
+  RUN_TEST(TestCooldownUsesVirtualClock);
+  RUN_TEST(TestBatchSplitsByProcess);
+  RUN_TEST(TestBatchTimeoutIsolatesProcess);
+  return testFailures;
+}
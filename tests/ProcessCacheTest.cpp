@@ -0,0 +1,120 @@
+#include "FakeDesktop.h"
+#include "ProcessCache.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <string>
+
+static long long Snapshots(FakeDesktop &desk) {
+  return desk.Counters().listProcesses;
+}
+
+// Filtrar muchas ventanas cuesta un snapshot: el primero trae todos los
+// procesos y los nombres ya en minúsculas
+static void TestBatchRefresh() {
+  FakeDesktop desk;
+  for (DWORD pid = 1; pid <= 300; ++pid)
+    desk.AddProcess(pid, "App" + std::to_string(pid) + ".EXE");
+  ProcessCache cache(&desk);
+  bool found = true;
+  for (DWORD pid = 1; pid <= 300; pid += 3) {
+    const ProcessCache::Info *info = cache.Lookup(pid);
+    found = found && info &&
+            info->lowerName == "app" + std::to_string(pid) + ".exe";
+  }
+  CHECK(found);
+  CHECK_EQ(Snapshots(desk), 1);
+  CHECK_EQ(cache.SnapshotCount(), 1);
+  CHECK_EQ(cache.Size(), 300);
+  CHECK(cache.Lookup(7)->exeName == "App7.EXE");
+
+  // Un PID desconocido pide un snapshot, una sola vez hasta que caduque
+  CHECK(cache.Lookup(999) == nullptr);
+  CHECK(cache.Lookup(999) == nullptr);
+  CHECK_EQ(Snapshots(desk), 2);
+  // Un proceso nuevo se encuentra con un snapshot
+  desk.AddProcess(301, "nuevo.exe");
+  CHECK(cache.Lookup(301) && cache.Lookup(301)->exeName == "nuevo.exe");
+  CHECK_EQ(Snapshots(desk), 3);
+}
+
+// Al caducar se refresca todo de una vez: fuera los procesos que
+// terminaron y al día los PID reutilizados
+static void TestExpiry() {
+  FakeDesktop desk;
+  desk.AddProcess(1, "a.exe");
+  desk.AddProcess(2, "b.exe");
+  ProcessCache cache(&desk, 16, 5000);
+  CHECK(cache.Lookup(1));
+  desk.RemoveProcess(2);
+  desk.RemoveProcess(1);
+  desk.AddProcess(1, "otra.exe");
+  desk.SleepMs(4000);
+  CHECK(cache.Lookup(1)->exeName == "a.exe"); // Aún vale
+  CHECK_EQ(cache.SnapshotCount(), 1);
+
+  desk.SleepMs(1001);
+  CHECK(cache.Lookup(1)->exeName == "otra.exe");
+  CHECK_EQ(cache.SnapshotCount(), 2);
+  CHECK_EQ(cache.Size(), 1);
+  CHECK(cache.Lookup(2) == nullptr);
+
+  cache.Clear();
+  CHECK_EQ(cache.Size(), 0);
+  CHECK(cache.Lookup(1));
+  CHECK_EQ(cache.SnapshotCount(), 4);
+}
+
+// Con capacidad 3 se queda con las usadas más recientemente y con la que
+// se acaba de pedir; la expulsada cuesta un snapshot al volver a pedirla
+static void TestLruBound() {
+  FakeDesktop desk;
+  for (DWORD pid = 1; pid <= 5; ++pid)
+    desk.AddProcess(pid, "p" + std::to_string(pid) + ".exe");
+  ProcessCache cache(&desk, 3);
+  CHECK(cache.Lookup(5));
+  CHECK_EQ(cache.Size(), 3);
+  // Quedan 5 (pedida) y las dos primeras del snapshot
+  CHECK(cache.Lookup(1) && cache.Lookup(2));
+  CHECK_EQ(cache.SnapshotCount(), 1);
+
+  // Uso: 2, 1, 5. Pedir 5 y 1 deja a 2 como la más vieja
+  cache.Lookup(5);
+  cache.Lookup(1);
+  CHECK(cache.Lookup(3)); // Snapshot: expulsa 2 y la recién llegada 4
+  CHECK_EQ(cache.SnapshotCount(), 2);
+  CHECK_EQ(cache.Size(), 3);
+  CHECK(cache.Lookup(5) && cache.Lookup(1) && cache.Lookup(3));
+  CHECK_EQ(cache.SnapshotCount(), 2);
+  CHECK(cache.Lookup(2));
+  CHECK_EQ(cache.SnapshotCount(), 3);
+  CHECK_EQ(cache.Size(), 3);
+}
+
+// El WindowManager filtra 100 ventanas de 300 procesos con un snapshot
+static void TestManagerOneSnapshotPerScan() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  for (DWORD pid = 1; pid <= 300; ++pid)
+    desk.AddProcess(pid, "app" + std::to_string(pid) + ".exe");
+  for (int i = 0; i < 100; ++i)
+    desk.AddWindow("w" + std::to_string(i), 1 + i * 3, {0, 0, 300, 300});
+  std::remove("ProcessCacheTest.cfg");
+  WindowManager manager("ProcessCacheTest.cfg", &desk);
+  manager.SetSoundsEnabled(false);
+  manager.SetAnimationsEnabled(false);
+
+  desk.SleepMs(10000); // Caché caducada
+  desk.ResetCounters();
+  manager.AddToExclusionList("app4.exe");
+  CHECK_EQ(manager.GetAllWindows()->size(), 99);
+  CHECK_EQ(Snapshots(desk), 1);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestBatchRefresh);
+  RUN_TEST(TestExpiry);
+  RUN_TEST(TestLruBound);
+  RUN_TEST(TestManagerOneSnapshotPerScan);
+  return testFailures;
+}
@@ -0,0 +1,104 @@
+#include "FakeDesktop.h"
+#include "SlotMap.h"
+#include "TestCheck.h"
+#include "WindowManager.h"
+#include <algorithm>
+#include <deque>
+#include <string>
+
+typedef SlotMap<std::string> Table;
+
+static const int SOAK = 1000000;
+static const size_t LIVE = 40;
+
+static void TestInsertGetRemove() {
+  Table table;
+  Table::Id a = table.Insert("a");
+  Table::Id b = table.Insert("b");
+  CHECK(a != Table::NONE && b != Table::NONE && a != b);
+  CHECK(table.Get(a) && *table.Get(a) == "a");
+  CHECK(table.Get(Table::NONE) == nullptr);
+  CHECK_EQ(table.Size(), 2);
+
+  CHECK(table.Remove(a));
+  CHECK(!table.Remove(a));
+  CHECK(table.Get(a) == nullptr);
+
+  // El hueco se reutiliza con otra generación: el Id viejo no lo ve
+  Table::Id c = table.Insert("c");
+  CHECK_EQ((uint32_t)c, (uint32_t)a);
+  CHECK(c != a);
+  CHECK(table.Get(a) == nullptr);
+  CHECK(*table.Get(c) == "c");
+  CHECK_EQ(table.Size(), 2);
+  CHECK_EQ(table.Capacity(), 2);
+
+  // Un índice fuera de la tabla tampoco existe
+  CHECK(table.Get(((Table::Id)1 << 32) | 99) == nullptr);
+}
+
+// Un millón de altas y bajas con como mucho LIVE vivos: la capacidad no
+// pasa de LIVE y ningún Id borrado vuelve a encontrar un registro
+static void TestSoak() {
+  Table table;
+  std::deque<Table::Id> live;
+  Table::Id oldest = Table::NONE;
+  bool staleMissing = true, valuesMatch = true;
+  for (int i = 0; i < SOAK; ++i) {
+    live.push_back(table.Insert(std::to_string(i)));
+    if (live.size() > LIVE) {
+      Table::Id id = live.front();
+      live.pop_front();
+      valuesMatch = valuesMatch && table.Get(id) &&
+                    *table.Get(id) == std::to_string(i - (int)LIVE);
+      table.Remove(id);
+      if (oldest == Table::NONE)
+        oldest = id;
+    }
+    if (oldest != Table::NONE)
+      staleMissing = staleMissing && table.Get(oldest) == nullptr;
+  }
+  CHECK(staleMissing);
+  CHECK(valuesMatch);
+  CHECK_EQ(table.Size(), LIVE);
+  CHECK(table.Capacity() <= LIVE + 1);
+}
+
+// Lo mismo con los registros por ventana del WindowManager: se abren y
+// cierran un millón de ventanas (HWND nuevas cada vez) guardando un punto
+// de deshacer en cada una, y los registros quedan acotados por las vivas
+static void TestWindowRecordSoak() {
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  desk.AddProcess(100, "app.exe");
+  WindowManager manager("SlotMapTest.cfg", &desk);
+  manager.SetAnimationsEnabled(false);
+
+  std::deque<HWND> open;
+  size_t maxCount = 0, maxCapacity = 0;
+  for (int i = 0; i < SOAK; ++i) {
+    HWND hwnd = desk.AddWindow("w", 100, {0, 0, 300, 300});
+    open.push_back(hwnd);
+    manager.SaveCurrentState(hwnd);
+    if (open.size() > LIVE) {
+      desk.RemoveWindow(open.front());
+      open.pop_front();
+    }
+    if (i % 1000 == 0) {
+      maxCount = std::max(maxCount, manager.TrackedWindowCount());
+      maxCapacity = std::max(maxCapacity, manager.TrackedWindowCapacity());
+    }
+  }
+  CHECK(maxCount >= LIVE && maxCount <= LIVE + 1);
+  CHECK(maxCapacity <= LIVE + 1);
+  CHECK(manager.TrackedWindowCount() <= LIVE);
+  CHECK(manager.TrackedWindowCapacity() <= LIVE + 1);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestInsertGetRemove);
+  RUN_TEST(TestSoak);
+  RUN_TEST(TestWindowRecordSoak);
+  return testFailures;
+}
@@ -0,0 +1,39 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include "Logger.h"
+#include <cstdio>
+
+// Comprobaciones mínimas para los tests, sin dependencias: cada fallo se
+// imprime con su línea y main devuelve el número de fallos (0 = pasa)
+static int testFailures = 0;
+
+#define CHECK(cond)                                                          \
+  do {                                                                       \
+    if (!(cond)) {                                                           \
+      std::printf("%s:%d: falla CHECK(%s)\n", __FILE__, __LINE__, #cond);    \
+      testFailures++;                                                        \
+    }                                                                        \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                       \
+  do {                                                                       \
+    long long va = (long long)(a), vb = (long long)(b);                      \
+    if (va != vb) {                                                          \
+      std::printf("%s:%d: falla CHECK_EQ(%s, %s): %lld != %lld\n", __FILE__, \
+                  __LINE__, #a, #b, va, vb);                                 \
+      testFailures++;                                                        \
+    }                                                                        \
+  } while (0)
+
+#define RUN_TEST(fn)                                                         \
+  do {                                                                       \
+    int before = testFailures;                                               \
+    fn();                                                                    \
+    std::printf("%s %s\n", testFailures == before ? "ok   " : "FALLA", #fn); \
+  } while (0)
+
+// Los tests no escriben winven.log
+inline void QuietLogs() { WinVenLogger::SetEnabled(false); }
+
+#endif // TEST_CHECK_H
@@ -0,0 +1,239 @@
+#include "TestCheck.h"
+#include "TilingTree.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+static const PixelRect AREA = {0, 0, 1920, 1040};
+
+static HWND W(uintptr_t id) { return (HWND)id; }
+
+static PixelRect Rect(const TilingTree &tree, HWND hwnd) {
+  PixelRect r = {0, 0, 0, 0};
+  tree.RectOf(hwnd, r);
+  return r;
+}
+
+static bool Same(const PixelRect &r, int x, int y, int w, int h) {
+  return r.x == x && r.y == y && r.w == w && r.h == h;
+}
+
+// Ventanas que devuelve TakeChanges, ordenadas
+static std::vector<HWND> Changed(TilingTree &tree) {
+  std::vector<WindowPos> changes;
+  tree.TakeChanges(changes);
+  std::vector<HWND> out;
+  for (const WindowPos &pos : changes) {
+    PixelRect r = Rect(tree, pos.hwnd);
+    if (!Same(r, pos.x, pos.y, pos.w, pos.h))
+      out.push_back(NULL); // Destino distinto del rectángulo del árbol
+    else
+      out.push_back(pos.hwnd);
+  }
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+static std::vector<HWND> List(std::vector<HWND> windows) {
+  std::sort(windows.begin(), windows.end());
+  return windows;
+}
+
+// Sin hueco las hojas cubren el área exacta y no se solapan
+static bool Tiles(const TilingTree &tree) {
+  std::vector<HWND> windows;
+  tree.Windows(windows);
+  long long covered = 0;
+  std::vector<PixelRect> rects;
+  for (HWND hwnd : windows) {
+    PixelRect r = Rect(tree, hwnd);
+    covered += (long long)r.w * r.h;
+    for (const PixelRect &o : rects)
+      if (r.x < o.x + o.w && o.x < r.x + r.w && r.y < o.y + o.h &&
+          o.y < r.y + r.h)
+        return false;
+    rects.push_back(r);
+  }
+  const PixelRect &a = tree.Area();
+  return windows.empty() || covered == (long long)a.w * a.h;
+}
+
+static void TestInsert() {
+  TilingTree tree;
+  tree.SetArea(AREA, 0);
+  CHECK(tree.Insert(W(1)));
+  CHECK(Same(Rect(tree, W(1)), 0, 0, 1920, 1040));
+  CHECK(Changed(tree) == List({W(1)}));
+
+  // Corte por el lado más largo
+  CHECK(tree.Insert(W(2)));
+  CHECK(Same(Rect(tree, W(1)), 0, 0, 960, 1040));
+  CHECK(Same(Rect(tree, W(2)), 960, 0, 960, 1040));
+  CHECK(Changed(tree) == List({W(1), W(2)}));
+
+  // Sin destino, la nueva parte la otra mitad; la primera no se mueve
+  CHECK(tree.Insert(W(3)));
+  CHECK(Same(Rect(tree, W(2)), 960, 0, 960, 520));
+  CHECK(Same(Rect(tree, W(3)), 960, 520, 960, 520));
+  CHECK(Changed(tree) == List({W(2), W(3)}));
+
+  // Con destino parte esa hoja
+  CHECK(tree.Insert(W(4), W(1)));
+  CHECK(Same(Rect(tree, W(1)), 0, 0, 960, 520));
+  CHECK(Same(Rect(tree, W(4)), 0, 520, 960, 520));
+  CHECK(Changed(tree) == List({W(1), W(4)}));
+
+  CHECK(!tree.Insert(W(4)));
+  CHECK(!tree.Insert(NULL));
+  CHECK_EQ(tree.Size(), 4);
+  CHECK_EQ(tree.Depth(), 3);
+  CHECK(Tiles(tree));
+  CHECK(Changed(tree).empty());
+}
+
+static void TestRemove() {
+  TilingTree tree;
+  tree.SetArea(AREA, 0);
+  for (uintptr_t i = 1; i <= 3; ++i)
+    tree.Insert(W(i));
+  Changed(tree);
+
+  // El hermano ocupa el hueco; las demás no se mueven
+  CHECK(tree.Remove(W(3)));
+  CHECK(Same(Rect(tree, W(2)), 960, 0, 960, 1040));
+  CHECK(Changed(tree) == List({W(2)}));
+  CHECK(!tree.Contains(W(3)));
+  CHECK(!tree.Remove(W(3)));
+
+  // Una ventana quitada con cambios pendientes no aparece en TakeChanges
+  tree.Insert(W(5));
+  CHECK(tree.Remove(W(5)));
+  CHECK(Changed(tree) == List({W(2)}));
+
+  CHECK(tree.Remove(W(1)));
+  CHECK(Same(Rect(tree, W(2)), 0, 0, 1920, 1040));
+  CHECK(tree.Remove(W(2)));
+  CHECK_EQ(tree.Size(), 0);
+  CHECK_EQ(tree.Depth(), 0);
+  CHECK(Changed(tree).empty());
+  CHECK(tree.Insert(W(6)));
+  CHECK(Same(Rect(tree, W(6)), 0, 0, 1920, 1040));
+}
+
+static void TestSwap() {
+  TilingTree tree;
+  tree.SetArea(AREA, 0);
+  for (uintptr_t i = 1; i <= 3; ++i)
+    tree.Insert(W(i));
+  Changed(tree);
+  PixelRect r1 = Rect(tree, W(1)), r3 = Rect(tree, W(3));
+  CHECK(tree.Swap(W(1), W(3)));
+  CHECK(Same(Rect(tree, W(1)), r3.x, r3.y, r3.w, r3.h));
+  CHECK(Same(Rect(tree, W(3)), r1.x, r1.y, r1.w, r1.h));
+  CHECK(Changed(tree) == List({W(1), W(3)}));
+  CHECK(!tree.Swap(W(1), W(1)));
+  CHECK(!tree.Swap(W(1), W(9)));
+
+  // Tras el intercambio cada ventana sigue a su nueva hoja
+  CHECK(tree.Remove(W(2)));
+  CHECK(Same(Rect(tree, W(1)), 960, 0, 960, 1040));
+  CHECK(Changed(tree) == List({W(1)}));
+}
+
+static void TestSplitRatio() {
+  TilingTree tree;
+  tree.SetArea(AREA, 0);
+  tree.Insert(W(1));
+  CHECK(!tree.SetSplitRatio(W(1), 0.7f)); // Sin hermano
+  tree.Insert(W(2));
+  Changed(tree);
+
+  CHECK(tree.SetSplitRatio(W(1), 0.7f));
+  CHECK(Same(Rect(tree, W(1)), 0, 0, 1344, 1040));
+  CHECK(Same(Rect(tree, W(2)), 1344, 0, 576, 1040));
+  CHECK(Changed(tree) == List({W(1), W(2)}));
+
+  // La proporción es la del lado de la ventana indicada
+  CHECK(tree.SetSplitRatio(W(2), 0.25f));
+  CHECK(Same(Rect(tree, W(2)), 1440, 0, 480, 1040));
+
+  // Se limita a 0.1 - 0.9
+  CHECK(tree.SetSplitRatio(W(1), 2.0f));
+  CHECK_EQ(Rect(tree, W(1)).w, 1728);
+  CHECK(tree.SetSplitRatio(W(1), -1.0f));
+  CHECK_EQ(Rect(tree, W(1)).w, 192);
+
+  // Misma proporción: nada que mover
+  Changed(tree);
+  CHECK(tree.SetSplitRatio(W(1), 0.1f));
+  CHECK(Changed(tree).empty());
+  CHECK(!tree.SetSplitRatio(W(9), 0.5f));
+}
+
+static void TestAreaAndGap() {
+  TilingTree tree;
+  tree.SetArea(AREA, 0);
+  tree.Insert(W(1));
+  tree.Insert(W(2));
+  Changed(tree);
+
+  // Otro hueco, mismos rectángulos: todas se vuelven a aplicar
+  tree.SetArea(AREA, 8);
+  CHECK(Same(Rect(tree, W(1)), 8, 8, 944, 1024));
+  CHECK(Changed(tree) == List({W(1), W(2)}));
+
+  tree.SetArea({1920, 0, 1280, 1040}, 8);
+  CHECK(Same(Rect(tree, W(2)), 2568, 8, 624, 1024));
+  CHECK(Changed(tree) == List({W(1), W(2)}));
+  tree.SetArea({1920, 0, 1280, 1040}, 8);
+  CHECK(Changed(tree).empty());
+}
+
+// Inserciones y bajas al azar: el árbol sigue cubriendo el área, queda
+// equilibrado y TakeChanges solo da ventanas vivas
+static void TestRandomEdits() {
+  TilingTree tree;
+  tree.SetArea(AREA, 0);
+  std::mt19937 rng(7);
+  std::vector<HWND> live;
+  uintptr_t next = 1;
+  bool tiles = true, changesLive = true;
+  int maxDepth = 0;
+  for (int op = 0; op < 10000; ++op) {
+    if (live.size() < 2 || (rng() % 2 && live.size() < 64)) {
+      HWND target = live.empty() || rng() % 4 ? NULL
+                                              : live[rng() % live.size()];
+      HWND hwnd = W(next++);
+      tree.Insert(hwnd, target);
+      live.push_back(hwnd);
+    } else if (rng() % 8 == 0) {
+      tree.Swap(live[rng() % live.size()], live[rng() % live.size()]);
+    } else {
+      size_t i = rng() % live.size();
+      tree.Remove(live[i]);
+      live[i] = live.back();
+      live.pop_back();
+    }
+    for (HWND hwnd : Changed(tree))
+      changesLive = changesLive && hwnd && tree.Contains(hwnd);
+    if (op % 100 == 0)
+      tiles = tiles && Tiles(tree);
+    maxDepth = std::max(maxDepth, tree.Depth());
+  }
+  CHECK(tiles);
+  CHECK(changesLive);
+  CHECK_EQ(tree.Size(), live.size());
+  CHECK(maxDepth <= 16);
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestInsert);
+  RUN_TEST(TestRemove);
+  RUN_TEST(TestSwap);
+  RUN_TEST(TestSplitRatio);
+  RUN_TEST(TestAreaAndGap);
+  RUN_TEST(TestRandomEdits);
+  return testFailures;
+}
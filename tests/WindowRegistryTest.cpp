@@ -0,0 +1,203 @@
+#include "FakeDesktop.h"
+#include "TestCheck.h"
+#include "WindowRegistry.h"
+#include <algorithm>
+#include <set>
+#include <vector>
+
+// Reenvía los eventos del escritorio simulado al registro
+struct RegistrySink : DesktopEventSink {
+  WindowRegistry *registry = nullptr;
+  void OnDisplayChanged() override {}
+  void OnWindowEvent(HWND hwnd, WindowEvent event) override {
+    registry->OnWindowEvent(hwnd, event);
+  }
+};
+
+// Lo que daría una enumeración completa con el mismo filtro
+static std::set<HWND> Expected(FakeDesktop &desk, DWORD excludedPid) {
+  std::vector<HWND> all;
+  desk.ListTopLevelWindows(all);
+  std::set<HWND> out;
+  for (HWND hwnd : all) {
+    const FakeDesktop::FakeWindow *w = desk.Find(hwnd);
+    if (w->visible && !w->cloaked && !w->title.empty() &&
+        w->pid != excludedPid)
+      out.insert(hwnd);
+  }
+  return out;
+}
+
+// Un guion aleatorio de eventos deja el registro igual que enumerar
+static void TestScriptedEvents() {
+  const DWORD excludedPid = 300;
+  FakeDesktop desk;
+  desk.AddMonitor({0, 0, 1920, 1080}, {0, 0, 1920, 1040});
+  WindowRegistry registry(&desk, [&](HWND hwnd) {
+    return desk.GetWindowPid(hwnd) == excludedPid;
+  });
+  RegistrySink sink;
+  sink.registry = &registry;
+  registry.SetLive(desk.SetEventSink(&sink));
+
+  std::vector<HWND> windows;
+  for (int i = 0; i < 20; ++i)
+    windows.push_back(desk.AddWindow("w", 100 + 100 * (i % 3), {0, 0, 9, 9}));
+  registry.Windows(); // Enumeración inicial; a partir de aquí, eventos
+  long long rescans = 0;
+
+  unsigned seed = 5;
+  auto rnd = [&](int m) {
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 8) % m);
+  };
+  int mismatches = 0;
+  for (int step = 0; step < 5000; ++step) {
+    HWND hwnd = windows.empty() ? NULL : windows[rnd((int)windows.size())];
+    HWND focused = NULL;
+    switch (rnd(8)) {
+    case 0:
+      windows.push_back(
+          desk.AddWindow("n", 100 + 100 * rnd(3), {0, 0, 9, 9}));
+      break;
+    case 1:
+      if (hwnd && windows.size() > 5) {
+        desk.RemoveWindow(hwnd);
+        windows.erase(std::find(windows.begin(), windows.end(), hwnd));
+      }
+      break;
+    case 2:
+      desk.SetVisible(hwnd, rnd(2) == 0);
+      break;
+    case 3:
+      desk.SetCloaked(hwnd, rnd(2) == 0);
+      break;
+    case 4:
+      desk.SetTitle(hwnd, rnd(3) == 0 ? "" : "t");
+      break;
+    default:
+      desk.SetForeground(hwnd);
+      focused = hwnd;
+      break;
+    }
+
+    long long before = desk.Counters().listWindows;
+    WindowRegistry::Snapshot listed = registry.Windows();
+    rescans += desk.Counters().listWindows - before;
+    std::set<HWND> got(listed->begin(), listed->end());
+    if (got.size() != listed->size() || got != Expected(desk, excludedPid))
+      mismatches++;
+    for (HWND w : windows)
+      if (registry.Contains(w) != (got.count(w) != 0))
+        mismatches++;
+    // La ventana que recibe el foco pasa al frente
+    if (focused && got.count(focused) && listed->front() != focused)
+      mismatches++;
+  }
+  CHECK_EQ(mismatches, 0);
+  CHECK_EQ(rescans, 0); // Sin volver a enumerar
+}
+
+// Mientras la generación no cambia, las lecturas comparten la misma foto
+static void TestSnapshotReuse() {
+  FakeDesktop desk;
+  WindowRegistry registry(&desk, [](HWND) { return false; });
+  RegistrySink sink;
+  sink.registry = &registry;
+  registry.SetLive(desk.SetEventSink(&sink));
+  HWND a = desk.AddWindow("a", 1, {0, 0, 9, 9});
+  HWND b = desk.AddWindow("b", 1, {0, 0, 9, 9});
+
+  WindowRegistry::Snapshot first = registry.Windows();
+  uint64_t generation = registry.Generation();
+  CHECK(registry.Windows() == first); // El mismo puntero, sin copia
+  CHECK(registry.Windows() == first);
+
+  desk.SetForeground(a);
+  WindowRegistry::Snapshot second = registry.Windows();
+  CHECK(registry.Generation() != generation);
+  CHECK(second != first);
+  CHECK((*second)[0] == a);
+  // La foto anterior no cambia aunque cambie el registro
+  CHECK(first->size() == 2 && (*first)[0] == b);
+
+  // Un evento que no cambia la lista no crea otra foto
+  desk.SetForeground(a);
+  CHECK(registry.Windows() == second);
+
+  // Invalidate vuelve a enumerar en la próxima lectura
+  registry.Invalidate();
+  CHECK(registry.Windows()->size() == 2);
+}
+
+// Tras Invalidate, Contains enumera en vez de dar false a todas y los
+// eventos siguientes vuelven a aplicarse
+static void TestContainsAfterInvalidate() {
+  FakeDesktop desk;
+  bool excludeB = false;
+  HWND b = NULL;
+  WindowRegistry registry(&desk, [&](HWND hwnd) {
+    return excludeB && hwnd == b;
+  });
+  RegistrySink sink;
+  sink.registry = &registry;
+  registry.SetLive(desk.SetEventSink(&sink));
+  HWND a = desk.AddWindow("a", 1, {0, 0, 9, 9});
+  b = desk.AddWindow("b", 1, {0, 0, 9, 9});
+  registry.Windows();
+
+  excludeB = true;
+  registry.Invalidate();
+  desk.ResetCounters();
+  CHECK(registry.Contains(a));
+  CHECK(!registry.Contains(b));
+  CHECK_EQ(desk.Counters().listWindows, 1);
+  CHECK(registry.Contains(a));
+  CHECK_EQ(desk.Counters().listWindows, 1);
+
+  HWND c = desk.AddWindow("c", 1, {0, 0, 9, 9});
+  CHECK(registry.Contains(c));
+  CHECK((*registry.Windows())[0] == c);
+  CHECK_EQ(desk.Counters().listWindows, 1);
+}
+
+// Con reglas de título, renombrar una ventana vuelve a evaluar su
+// exclusión en las dos direcciones
+static void TestTitleExclusion() {
+  FakeDesktop desk;
+  WindowRegistry registry(&desk, [&](HWND hwnd) {
+    return desk.GetTitle(hwnd) == "Picture-in-picture";
+  });
+  RegistrySink sink;
+  sink.registry = &registry;
+  registry.SetLive(desk.SetEventSink(&sink));
+  registry.SetTitleDependent(true);
+  HWND tab = desk.AddWindow("Video - Navegador", 1, {0, 0, 9, 9});
+  HWND other = desk.AddWindow("otra", 1, {0, 0, 9, 9});
+  registry.Windows();
+  CHECK(registry.Contains(tab));
+
+  desk.ResetCounters();
+  desk.SetTitle(tab, "Picture-in-picture");
+  CHECK(!registry.Contains(tab));
+  CHECK(registry.Contains(other));
+  CHECK_EQ(registry.Windows()->size(), 1);
+  desk.SetTitle(tab, "Video - Navegador");
+  CHECK(registry.Contains(tab));
+  CHECK_EQ(registry.Windows()->size(), 2);
+  CHECK_EQ(desk.Counters().listWindows, 0); // Solo eventos
+
+  // Sin reglas de título la exclusión sigue guardada por ventana
+  registry.SetTitleDependent(false);
+  desk.SetTitle(tab, "Picture-in-picture");
+  CHECK(registry.Contains(tab));
+}
+
+int main() {
+  QuietLogs();
+  RUN_TEST(TestScriptedEvents);
+  RUN_TEST(TestSnapshotReuse);
+  RUN_TEST(TestContainsAfterInvalidate);
+  RUN_TEST(TestTitleExclusion);
+  return testFailures;
+}